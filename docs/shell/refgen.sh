@@ -44,7 +44,7 @@ cp -f "./md/showcommands.md" "./md/showtemp.md"
 # Command Reference chapter
 
 # shellcheck disable=SC1001,SC2016
-( ( echo HELP | "../src/dps8/dps8" -t -q | tail -n +2 | grep -v '^$' | tr -s ' ' | tr ' ' '\n' | grep -v '^$' | grep -vwE '(HELP|IGNORE|BREAK|NOBREAK|EXPECT|NOEXPECT|SEND|EXAMINE|DEPOSIT|IEXAMINE|IDEPOSIT|XF|RESTART|AI|AI2|UNCABLE|CABLE_SHOW|CABLE_RIPOUT|NOLOCALOPC|FNPSERVER3270PORT|UNLOAD|NOLUF)' | sort | xargs -I{} echo echo\ \;echo\ \XXXXXXXXXXXX\ {}\;echo help\ -f\ {}\|../src/dps8/dps8\ -t\ -q\;echo\;echo |sh) | grep -Ev '(^DPS8/M help\.)' ) | expand | sed -e 's/XXXXXXXXXXXX/#/' -e 's/^1\.1\.//' -e 's/^[0-9]\+ /## /' -e 's/^[0-9]\+\.[0-9]\+ /## /' -e 's/^[0-9]\+\.[0-9]\+\.[0-9]\+ /### /' -e 's/^[0-9]\+\.[0-9]\+\.[0-9]\+\.[0-9]\+ /#### /' -e 's/^#/##/' -e 's/^    //' -e '' -e 's/^        /             /' -e '/^[[:alnum:]]/s/</\\</g' -e '/^[[:alnum:]]/s/>/\\>/g' -e '/^[[:alnum:]]/s/_/\\_/g' | ansifilter -T | tee "./temp2.tmp" && printf '%s\n\n' '<!-- pagebreak -->' '# Simulator Command Reference' 'This chapter provides reference documentation for the **DPS8M** simulator command set.' '* This information is also available from within the simulator; it is accessible by using the interactive `HELP` command.' '' '<!-- br -->' '' > "./temp1.tmp" && sed -e 's/^## /\n\n<!-- br -->\n\n## /g' -e 's/^\* \* /   * /g' < "./temp2.tmp" >> "./temp1.tmp" && rm -f "./temp2.tmp" && mv -f "./temp1.tmp" "./md/commandref.md"
+( ( echo HELP | "../src/dps8/dps8" -t -q | tail -n +2 | grep -v '^$' | tr -s ' ' | tr ' ' '\n' | grep -v '^$' | grep -vwE '(HELP|IGNORE|BREAK|NOBREAK|EXPECT|NOEXPECT|SEND|EXAMINE|DEPOSIT|IEXAMINE|IDEPOSIT|XF|RESTART|AI|AI2|UNCABLE|CABLE_SHOW|CABLE_RIPOUT|NOLOCALOPC|FNPSERVER3270PORT|UNLOAD|NOLUF|METRICS_SHOW)' | sort | xargs -I{} echo echo\ \;echo\ \XXXXXXXXXXXX\ {}\;echo help\ -f\ {}\|../src/dps8/dps8\ -t\ -q\;echo\;echo |sh) | grep -Ev '(^DPS8/M help\.)' ) | expand | sed -e 's/XXXXXXXXXXXX/#/' -e 's/^1\.1\.//' -e 's/^[0-9]\+ /## /' -e 's/^[0-9]\+\.[0-9]\+ /## /' -e 's/^[0-9]\+\.[0-9]\+\.[0-9]\+ /### /' -e 's/^[0-9]\+\.[0-9]\+\.[0-9]\+\.[0-9]\+ /#### /' -e 's/^#/##/' -e 's/^    //' -e '' -e 's/^        /             /' -e '/^[[:alnum:]]/s/</\\</g' -e '/^[[:alnum:]]/s/>/\\>/g' -e '/^[[:alnum:]]/s/_/\\_/g' | ansifilter -T | tee "./temp2.tmp" && printf '%s\n\n' '<!-- pagebreak -->' '# Simulator Command Reference' 'This chapter provides reference documentation for the **DPS8M** simulator command set.' '* This information is also available from within the simulator; it is accessible by using the interactive `HELP` command.' '' '<!-- br -->' '' > "./temp1.tmp" && sed -e 's/^## /\n\n<!-- br -->\n\n## /g' -e 's/^\* \* /   * /g' < "./temp2.tmp" >> "./temp1.tmp" && rm -f "./temp2.tmp" && mv -f "./temp1.tmp" "./md/commandref.md"
 
 ############################################################################
 # Replacements
@@ -65,6 +65,8 @@ sed -e '/^See the Omnibus documentation for a complete SET command reference.$/
 sed -e '/^Set the FNP dialin server binding address$/ {' -e 'r md/fnpserveraddress.md' -e 'd' -e '}' -i "./md/commandref.md"
 # FNPSERVERPORT
 sed -e '/^Set the FNP dialin TELNET port number$/ {' -e 'r md/fnpserverport.md' -e 'd' -e '}' -i "./md/commandref.md"
+# METRICS
+sed -e '/^Serve performance counters on a local socket$/ {' -e 'r md/metrics.md' -e 'd' -e '}' -i "./md/commandref.md"
 # LUF
 sed -e '/^Enable normal LUF handling$/ {' -e 'r md/luf.md' -e 'd' -e '}' -i "./md/commandref.md"
 # LOAD
@@ -181,6 +183,31 @@ cat ./md/_cmdout.md
 sed -e '/^SHOWCPUSTALLHERE$/ {' -e 'r md/_cmdout.md' -e 'd' -e '}' -i "./md/showtemp.md"
 rm -f "./md/_cmdout.md" 2> /dev/null 2>&1
 
+####################################################################################################
+# SHOW CPU UCACHE
+printf '%s\n' '```dps8' >> "./md/_cmdout.md"
+printf '%s\n' "sim> SET CPU NUNITS=1" >> "./md/_cmdout.md"
+printf '%s\n' 'sim> SHOW CPU UCACHE' >> "./md/_cmdout.md"
+## Note: Unicode space used with sed!
+printf '%s\n' "SET CPU NUNITS=1" "SHOW CPU UCACHE" | ../src/dps8/dps8 -q -t | ansifilter -T | expand | \
+    sed 's/^ / /' >> "./md/_cmdout.md"
+printf '%s\n' '```' >> "./md/_cmdout.md"
+cat ./md/_cmdout.md
+sed -e '/^SHOWCPUUCACHEHERE$/ {' -e 'r md/_cmdout.md' -e 'd' -e '}' -i "./md/showtemp.md"
+rm -f "./md/_cmdout.md" 2> /dev/null 2>&1
+
+####################################################################################################
+# SHOW CPU NUMA
+printf '%s\n' '```dps8' >> "./md/_cmdout.md"
+printf '%s\n' 'sim> SHOW CPU NUMA' >> "./md/_cmdout.md"
+## Note: Unicode space used with sed!
+printf '%s\n' "SHOW CPU NUMA" | ../src/dps8/dps8 -q -t | ansifilter -T | expand | \
+    sed 's/^ / /' >> "./md/_cmdout.md"
+printf '%s\n' '```' >> "./md/_cmdout.md"
+cat ./md/_cmdout.md
+sed -e '/^SHOWCPUNUMAHERE$/ {' -e 'r md/_cmdout.md' -e 'd' -e '}' -i "./md/showtemp.md"
+rm -f "./md/_cmdout.md" 2> /dev/null 2>&1
+
 ####################################################################################################
 # SHOW CPU DEBUG
 printf '%s\n' '```dps8' >> "./md/_cmdout.md"
@@ -217,6 +244,42 @@ cat ./md/_cmdout.md
 sed -e '/^SHOWDISKNUNITSHERE$/ {' -e 'r md/_cmdout.md' -e 'd' -e '}' -i "./md/showtemp.md"
 rm -f "./md/_cmdout.md" 2> /dev/null 2>&1
 
+####################################################################################################
+# SHOW DISK ASYNC
+printf '%s\n' '```dps8' >> "./md/_cmdout.md"
+printf '%s\n' 'sim> SHOW DISK ASYNC' >> "./md/_cmdout.md"
+## Note: Unicode space used with sed!
+printf '%s\n' "SHOW DISK ASYNC" | ../src/dps8/dps8 -q -t | ansifilter -T | expand | \
+    sed 's/^ / /' >> "./md/_cmdout.md"
+printf '%s\n' '```' >> "./md/_cmdout.md"
+cat ./md/_cmdout.md
+sed -e '/^SHOWDISKASYNCHERE$/ {' -e 'r md/_cmdout.md' -e 'd' -e '}' -i "./md/showtemp.md"
+rm -f "./md/_cmdout.md" 2> /dev/null 2>&1
+
+####################################################################################################
+# SHOW DISK MSYNC
+printf '%s\n' '```dps8' >> "./md/_cmdout.md"
+printf '%s\n' 'sim> SHOW DISK MSYNC' >> "./md/_cmdout.md"
+## Note: Unicode space used with sed!
+printf '%s\n' "SHOW DISK MSYNC" | ../src/dps8/dps8 -q -t | ansifilter -T | expand | \
+    sed 's/^ / /' >> "./md/_cmdout.md"
+printf '%s\n' '```' >> "./md/_cmdout.md"
+cat ./md/_cmdout.md
+sed -e '/^SHOWDISKMSYNCHERE$/ {' -e 'r md/_cmdout.md' -e 'd' -e '}' -i "./md/showtemp.md"
+rm -f "./md/_cmdout.md" 2> /dev/null 2>&1
+
+####################################################################################################
+# SHOW DISK OVERLAY
+printf '%s\n' '```dps8' >> "./md/_cmdout.md"
+printf '%s\n' 'sim> SHOW DISK0 OVERLAY' >> "./md/_cmdout.md"
+## Note: Unicode space used with sed!
+printf '%s\n' "SHOW DISK0 OVERLAY" | ../src/dps8/dps8 -q -t | ansifilter -T | expand | \
+    sed 's/^ / /' >> "./md/_cmdout.md"
+printf '%s\n' '```' >> "./md/_cmdout.md"
+cat ./md/_cmdout.md
+sed -e '/^SHOWDISKOVERLAYHERE$/ {' -e 'r md/_cmdout.md' -e 'd' -e '}' -i "./md/showtemp.md"
+rm -f "./md/_cmdout.md" 2> /dev/null 2>&1
+
 ####################################################################################################
 # SHOW DISK TYPE
 printf '%s\n' '```dps8' >> "./md/_cmdout.md"
@@ -277,6 +340,18 @@ cat ./md/_cmdout.md
 sed -e '/^SHOWFNPNAMEHERE$/ {' -e 'r md/_cmdout.md' -e 'd' -e '}' -i "./md/showtemp.md"
 rm -f "./md/_cmdout.md" 2> /dev/null 2>&1
 
+####################################################################################################
+# SHOW FNP NETTHREAD
+printf '%s\n' '```dps8' >> "./md/_cmdout.md"
+printf '%s\n' 'sim> SHOW FNP NETTHREAD' >> "./md/_cmdout.md"
+## Note: Unicode space used with sed!
+printf '%s\n' "SHOW FNP NETTHREAD" | ../src/dps8/dps8 -q -t | ansifilter -T | expand | \
+    sed 's/^ / /' >> "./md/_cmdout.md"
+printf '%s\n' '```' >> "./md/_cmdout.md"
+cat ./md/_cmdout.md
+sed -e '/^SHOWFNPNETTHREADHERE$/ {' -e 'r md/_cmdout.md' -e 'd' -e '}' -i "./md/showtemp.md"
+rm -f "./md/_cmdout.md" 2> /dev/null 2>&1
+
 ####################################################################################################
 # SHOW FNP NUNITS
 printf '%s\n' '```dps8' >> "./md/_cmdout.md"
@@ -289,6 +364,18 @@ cat ./md/_cmdout.md
 sed -e '/^SHOWFNPNUNITSHERE$/ {' -e 'r md/_cmdout.md' -e 'd' -e '}' -i "./md/showtemp.md"
 rm -f "./md/_cmdout.md" 2> /dev/null 2>&1
 
+####################################################################################################
+# SHOW FNP OUTPUT_HWM
+printf '%s\n' '```dps8' >> "./md/_cmdout.md"
+printf '%s\n' 'sim> SHOW FNP OUTPUT_HWM' >> "./md/_cmdout.md"
+## Note: Unicode space used with sed!
+printf '%s\n' "SHOW FNP OUTPUT_HWM" | ../src/dps8/dps8 -q -t | ansifilter -T | expand | \
+    sed 's/^ / /' >> "./md/_cmdout.md"
+printf '%s\n' '```' >> "./md/_cmdout.md"
+cat ./md/_cmdout.md
+sed -e '/^SHOWFNPOUTPUTHWMHERE$/ {' -e 'r md/_cmdout.md' -e 'd' -e '}' -i "./md/showtemp.md"
+rm -f "./md/_cmdout.md" 2> /dev/null 2>&1
+
 ####################################################################################################
 # SHOW FNP SERVICE
 printf '%s\n' '```dps8' >> "./md/_cmdout.md"
@@ -105,9 +105,7 @@ word24 doAppendCycleIndirectWordFetch (cpu_state_t * cpup, word36 * data, uint n
   goto HI;
 
 skip_ucache:;
-# if defined(UCACHE_STATS)
   cpu.uCache.skips[this] ++;
-# endif
 
 miss_ucache:;
 
@@ -167,9 +167,7 @@ static int evcnt = 0;
 
 skip_ucache:;
   //sim_printf ("miss %d %05o:%06o\r\n", evcnt, cpu.TPR.TSR, cpu.TPR.CA);
-#if defined(UCACHE_STATS)
   cpu.uCache.skips[this] ++;
-#endif
 
 miss_ucache:;
 
@@ -97,9 +97,7 @@ static int evcnt = 0;
   // See E1; The TRR needs to be checked and set to R2; this will vary across different
   // CALL6 calls.
   if (i->info->flags & CALL6_INS) {
-# if defined(UCACHE_STATS)
     cpu.uCache.call6Skips ++;
-# endif /* if defined(UCACHE_STATS) */
     goto skip;
   }
 #endif
@@ -116,9 +114,7 @@ static int evcnt = 0;
   if (i->info->flags & TRANSFER_INS) {
     // check ring alarm to catch outbound transfers
     if (cpu.rRALR && (cpu.PPR.PRR >= cpu.rRALR)) {
-#if defined(UCACHE_STATS)
       cpu.uCache.ralrSkips ++;
-#endif /* if defined(UCACHE_STATS) */
       goto skip;
     }
   }
@@ -170,9 +166,7 @@ skip:;
 # if defined(HDBG)
   hdbgNote ("doAppendCycleOperandRead.h", "skip %d %05o:%06o\r\n", evcnt, cpu.TPR.TSR, cpu.TPR.CA);
 # endif /* if defined(HDBG) */
-# if defined(UCACHE_STATS)
   cpu.uCache.skips[this] ++;
-# endif /* if defined(UCACHE_STATS) */
 #endif /* if defined(TEST_UCACHE) */
 
 miss:;
@@ -42,6 +42,43 @@ word24 doAppendCycleOperandStore (cpu_state_t * cpup, word36 * data, uint nWords
                 ! i->opcodeX);
   }
 
+  // Is this cycle a candidate for ucache?
+  // The prepage EIS instructions must run do_ptw2, and a same segment
+  // store that would reset the TRR (isolts 870) is not cached.
+  bool ucCandidate = ! UC_PREPAGE_INS (i) &&
+                     ! (cpu.TPR.TSR == cpu.PPR.PSR && cpu.TPR.TRR != cpu.PPR.PRR);
+  word24 finalAddress = (word24) -1;  // not everything requires a final address
+  word24 pageAddress = 0;
+  word3 RSDWH_R1 = 0;
+  word14 bound = 0;
+  word1 p = 0;
+  bool paged = false;
+  bool ucHit = false;
+
+  if (ucCandidate) {
+    if (ucCacheCheck (cpup, UC_OPERAND_STORE, cpu.TPR.TSR, cpu.TPR.CA, & bound, & p, & pageAddress, & RSDWH_R1, & paged)) {
+      // ucache hit; housekeeping...
+      ucHit = true;
+      cpu.apu.lastCycle = OPERAND_STORE;
+      PNL (L68_ (cpu.apu.state = 0;))
+      cpu.RSDWH_R1 = RSDWH_R1;
+      cpu.acvFaults = 0;
+      if (paged) {
+        set_apu_status (cpup, apuStatus_FAP);
+        finalAddress = pageAddress + (cpu.TPR.CA & OS18MASK);
+      } else {
+        set_apu_status (cpup, apuStatus_FANP);
+        finalAddress = pageAddress + cpu.TPR.CA;
+      }
+      finalAddress &= 0xffffff;
+      goto HI;
+    }
+  } else {
+    if (UC_PREPAGE_INS (i))
+      cpu.uCache.prepageSkips ++;
+    cpu.uCache.skips[UC_OPERAND_STORE] ++;
+  }
+
   processor_cycle_type lastCycle = cpu.apu.lastCycle;
   cpu.apu.lastCycle = OPERAND_STORE;
 
@@ -57,8 +94,6 @@ word24 doAppendCycleOperandStore (cpu_state_t * cpup, word36 * data, uint nWords
 #define FMSG(x)
   FMSG (char * acvFaultsMsg = "<unknown>";)
 
-  word24 finalAddress = (word24) -1;  // not everything requires a final address
-
 ////////////////////////////////////////
 //
 // Sheet 2: "A"
@@ -245,7 +280,9 @@ H:;
 
   DBGAPP ("doAppendCycleOperandStore(H): SDW->ADDR=%08o CA=%06o\r\n", cpu.SDW->ADDR, cpu.TPR.CA);
 
-  finalAddress = (cpu.SDW->ADDR & 077777760) + cpu.TPR.CA;
+  pageAddress = (cpu.SDW->ADDR & 077777760);
+  paged = false;
+  finalAddress = pageAddress + cpu.TPR.CA;
   finalAddress &= 0xffffff;
   PNL (cpu.APUMemAddr = finalAddress;)
 
@@ -269,7 +306,9 @@ I:;
 
   // AL39: The hardware ignores low order bits of the main memory page
   // address according to page size
-  finalAddress = (((word24)cpu.PTW->ADDR & 0777760) << 6) + y2;
+  pageAddress = (((word24)cpu.PTW->ADDR & 0777760) << 6);
+  paged = true;
+  finalAddress = pageAddress + y2;
   finalAddress &= 0xffffff;
   PNL (cpu.APUMemAddr = finalAddress;)
 
@@ -285,6 +324,10 @@ I:;
 HI:
   DBGAPP ("doAppendCycleOperandStore(HI)\r\n");
 
+  // PTW.M is now set; later stores to the page need not revisit it.
+  if (ucCandidate && ! ucHit)
+    ucCacheSave (cpup, UC_OPERAND_STORE, cpu.TPR.TSR, cpu.TPR.CA, cpu.SDW->BOUND, cpu.SDW->P, pageAddress, cpu.SDW->R1, paged);
+
   // isolts 870
   cpu.cu.XSF = 1;
   sim_debug (DBG_TRACEEXT, & cpu_dev, "loading of cpu.TPR.TSR sets XSF to 1\r\n");
@@ -149,6 +149,15 @@ extern pthread_t main_thread_id;
 #  define volAtomic
 # endif /* if defined(THREADZ) || defined(LOCKLESS) */
 
+// Host thread placement (SET CPU CONFIG=AFFINITY, SET CPU NUMA);
+// pthread_setaffinity_np and mbind are Linux interfaces
+# if (defined(THREADZ) || defined(LOCKLESS)) && defined(__linux__) && \
+     !defined(__ANDROID__) && !defined(NO_AFFINITY)
+#  if !defined(AFFINITY)
+#   define AFFINITY
+#  endif /* if !defined(AFFINITY) */
+# endif
+
 # if !defined(NEED_128)
 #  if defined(PRIu64)
 #   undef PRIu64
@@ -334,6 +334,17 @@ static word6 calc_hit_am (word6 LRU, uint hit_level)
      }
   }
 
+// The AM match logic is emulated by scanning the registers a key may be in
+// (all 16 on the L68, the 4 of the set on the DPS8M). SDWAMhint/PTWAMhint
+// are a small direct-mapped index in front of the scan: each bucket holds
+// the register that last matched a key hashing to it. A hint is checked
+// against the register (and, for the DPS8M, its set) before it is used, so
+// a stale hint only costs the scan that would have been made anyway. The
+// USE fields are updated exactly as before.
+
+#define SDWAM_HINT(segno)     ((segno) & N_AM_HINT_MASK)
+#define PTWAM_HINT(segno, CA) ((((CA) >> 10) ^ ((uint) (segno) << 4)) & N_AM_HINT_MASK)
+
 static sdw_s * fetch_sdw_from_sdwam (cpu_state_t * cpup, word15 segno) {
   DBGAPP ("%s(0):segno=%05o\r\n", __func__, segno);
 
@@ -344,64 +355,79 @@ static sdw_s * fetch_sdw_from_sdwam (cpu_state_t * cpup, word15 segno) {
 
   if (cpu.tweaks.l68_mode) { // L68
     int nwam = N_L68_WAM_ENTRIES;
-    for (int _n = 0; _n < nwam; _n++) {
-      // make certain we initialize SDWAM prior to use!!!
-      if (cpu.SDWAM[_n].FE && segno == cpu.SDWAM[_n].POINTER) {
-        DBGAPP ("%s(1):found match for segno %05o " "at _n=%d\r\n", __func__, segno, _n);
-
-        cpu.cu.SDWAMM = 1;
-        cpu.SDWAMR = (word4) _n;
-        cpu.SDW = & cpu.SDWAM[_n];
-
-        // If the SDWAM match logic circuitry indicates a hit, all usage
-        // counts (SDWAM.USE) greater than the usage count of the register
-        // hit are decremented by one, the usage count of the register hit
-        // is set to 15, and the contents of the register hit are read out
-        // into the address preparation circuitry.
-
-        for (int _h = 0; _h < nwam; _h++) {
-          if (cpu.SDWAM[_h].USE > cpu.SDW->USE)
-            cpu.SDWAM[_h].USE -= 1;
+    uint hint = SDWAM_HINT (segno);
+    int _n = cpu.SDWAMhint[hint];
+    if (_n >= nwam || ! cpu.SDWAM[_n].FE || segno != cpu.SDWAM[_n].POINTER) {
+      for (_n = 0; _n < nwam; _n++) {
+        // make certain we initialize SDWAM prior to use!!!
+        if (cpu.SDWAM[_n].FE && segno == cpu.SDWAM[_n].POINTER) {
+          cpu.SDWAMhint[hint] = (uint8) _n;
+          break;
         }
-        cpu.SDW->USE = N_L68_WAM_ENTRIES - 1;
+      }
+    }
+    if (_n < nwam) {
+      DBGAPP ("%s(1):found match for segno %05o " "at _n=%d\r\n", __func__, segno, _n);
+
+      cpu.cu.SDWAMM = 1;
+      cpu.SDWAMR = (word4) _n;
+      cpu.SDW = & cpu.SDWAM[_n];
 
-        char buf[256];
-        (void)buf;
+      // If the SDWAM match logic circuitry indicates a hit, all usage
+      // counts (SDWAM.USE) greater than the usage count of the register
+      // hit are decremented by one, the usage count of the register hit
+      // is set to 15, and the contents of the register hit are read out
+      // into the address preparation circuitry.
+
+      for (int _h = 0; _h < nwam; _h++) {
+        if (cpu.SDWAM[_h].USE > cpu.SDW->USE)
+          cpu.SDWAM[_h].USE -= 1;
+      }
+      cpu.SDW->USE = N_L68_WAM_ENTRIES - 1;
+
+      char buf[256];
+      (void)buf;
 #if defined(TESTING)
-        DBGAPP ("%s(2):SDWAM[%d]=%s\r\n", __func__, _n, str_sdw (buf, cpu.SDW));
+      DBGAPP ("%s(2):SDWAM[%d]=%s\r\n", __func__, _n, str_sdw (buf, cpu.SDW));
 #endif /* if defined(TESTING) */
-        return cpu.SDW;
-      }
+      return cpu.SDW;
     }
   }
 
   if (! cpu.tweaks.l68_mode) { // DPS8M
     uint setno = segno & 017;
-    uint toffset;
-    sdw_s *p;
-    for (toffset = 0; toffset < 64; toffset += 16) {
-      p = & cpu.SDWAM[toffset + setno];
-      if (p->FE && segno == p->POINTER) {
-        DBGAPP ("%s(1):found match for segno %05o " "at _n=%d\r\n", __func__, segno, toffset + setno);
-
-        cpu.cu.SDWAMM = 1;
-        cpu.SDWAMR = (word6) (toffset + setno);
-        cpu.SDW = p; // export pointer for appending
-
-        word6 u = calc_hit_am (p->USE, toffset >> 4);
-        for (toffset = 0; toffset < 64; toffset += 16) { // update LRU
-          p = & cpu.SDWAM[toffset + setno];
-          if (p->FE)
-            p->USE = u;
+    uint hint = SDWAM_HINT (segno);
+    uint toffset = cpu.SDWAMhint[hint] & 060;
+    sdw_s *p = & cpu.SDWAM[toffset + setno];
+    if ((cpu.SDWAMhint[hint] & 017) != setno || ! p->FE || segno != p->POINTER) {
+      for (toffset = 0; toffset < 64; toffset += 16) {
+        p = & cpu.SDWAM[toffset + setno];
+        if (p->FE && segno == p->POINTER) {
+          cpu.SDWAMhint[hint] = (uint8) (toffset + setno);
+          break;
         }
+      }
+    }
+    if (toffset < 64) {
+      DBGAPP ("%s(1):found match for segno %05o " "at _n=%d\r\n", __func__, segno, toffset + setno);
 
-        char buf[256];
-        (void)buf;
+      cpu.cu.SDWAMM = 1;
+      cpu.SDWAMR = (word6) (toffset + setno);
+      cpu.SDW = p; // export pointer for appending
+
+      word6 u = calc_hit_am (p->USE, toffset >> 4);
+      for (toffset = 0; toffset < 64; toffset += 16) { // update LRU
+        p = & cpu.SDWAM[toffset + setno];
+        if (p->FE)
+          p->USE = u;
+      }
+
+      char buf[256];
+      (void)buf;
 #if defined(TESTING)
-        DBGAPP ("%s(2):SDWAM[%d]=%s\r\n", __func__, toffset + setno, str_sdw (buf, cpu.SDW));
+      DBGAPP ("%s(2):SDWAM[%d]=%s\r\n", __func__, toffset + setno, str_sdw (buf, cpu.SDW));
 #endif /* if defined(TESTING) */
-        return cpu.SDW;
-      }
+      return cpu.SDW;
     }
   }
 #if defined(TESTING)
@@ -615,6 +641,7 @@ static void load_sdwam (cpu_state_t * cpup, word15 segno, bool nomatch)
           p->POINTER = segno;
           p->USE = 0;
           p->FE = true;     // in use by SDWAM
+          cpu.SDWAMhint[SDWAM_HINT (segno)] = (uint8) _n;
 
           for (int _h = 0; _h < N_L68_WAM_ENTRIES; _h++) {
             sdw_s * q = & cpu.SDWAM[_h];
@@ -659,6 +686,7 @@ static void load_sdwam (cpu_state_t * cpup, word15 segno, bool nomatch)
       * p = cpu.SDW0; // load the SDW
       p->POINTER = segno;
       p->FE = true;  // in use
+      cpu.SDWAMhint[SDWAM_HINT (segno)] = (uint8) (toffset + setno);
       cpu.SDW = p; // export pointer for appending
 
       for (uint toffset1 = 0; toffset1 < 64; toffset1 += 16) { // update LRU
@@ -683,73 +711,95 @@ static ptw_s * fetch_ptw_from_ptwam (cpu_state_t * cpup, word15 segno, word18 CA
         return NULL;
       }
 
+    word12 pageno = (CA >> 6) & 07760;
+    uint hint     = PTWAM_HINT (segno, CA);
+
     if (cpu.tweaks.l68_mode) { // L68
       int nwam = N_L68_WAM_ENTRIES;
-      for (int _n = 0; _n < nwam; _n++)
+      int _n   = cpu.PTWAMhint[hint];
+      if (_n >= nwam || ! cpu.PTWAM[_n].FE || pageno != cpu.PTWAM[_n].PAGENO ||
+          cpu.PTWAM[_n].POINTER != segno)
         {
-          if (cpu.PTWAM[_n].FE && ((CA >> 6) & 07760) == cpu.PTWAM[_n].PAGENO &&
-              cpu.PTWAM[_n].POINTER == segno)   //_initialized
+          for (_n = 0; _n < nwam; _n++)
             {
-              DBGAPP ("%s: found match for segno=%o pageno=%o "
-                      "at _n=%d\r\n",
-                      __func__, segno, cpu.PTWAM[_n].PAGENO, _n);
-              cpu.cu.PTWAMM = 1;
-              cpu.PTWAMR = (word4) _n;
-              cpu.PTW = & cpu.PTWAM[_n];
-
-              // If the PTWAM match logic circuitry indicates a hit, all usage
-              // counts (PTWAM.USE) greater than the usage count of the register
-              // hit are decremented by one, the usage count of the register hit
-              // is set to 15, and the contents of the register hit are read out
-              // into the address preparation circuitry.
-
-              for (int _h = 0; _h < nwam; _h++)
+              if (cpu.PTWAM[_n].FE && pageno == cpu.PTWAM[_n].PAGENO &&
+                  cpu.PTWAM[_n].POINTER == segno)   //_initialized
                 {
-                  if (cpu.PTWAM[_h].USE > cpu.PTW->USE)
-                    cpu.PTWAM[_h].USE -= 1; //PTW->USE -= 1;
+                  cpu.PTWAMhint[hint] = (uint8) _n;
+                  break;
                 }
-              cpu.PTW->USE = N_L68_WAM_ENTRIES - 1;
+            }
+        }
+      if (_n < nwam)
+        {
+          DBGAPP ("%s: found match for segno=%o pageno=%o "
+                  "at _n=%d\r\n",
+                  __func__, segno, cpu.PTWAM[_n].PAGENO, _n);
+          cpu.cu.PTWAMM = 1;
+          cpu.PTWAMR = (word4) _n;
+          cpu.PTW = & cpu.PTWAM[_n];
+
+          // If the PTWAM match logic circuitry indicates a hit, all usage
+          // counts (PTWAM.USE) greater than the usage count of the register
+          // hit are decremented by one, the usage count of the register hit
+          // is set to 15, and the contents of the register hit are read out
+          // into the address preparation circuitry.
+
+          for (int _h = 0; _h < nwam; _h++)
+            {
+              if (cpu.PTWAM[_h].USE > cpu.PTW->USE)
+                cpu.PTWAM[_h].USE -= 1; //PTW->USE -= 1;
+            }
+          cpu.PTW->USE = N_L68_WAM_ENTRIES - 1;
 #if defined(do_selftestPTWAM)
-              selftest_ptwaw ();
+          selftest_ptwaw ();
 #endif /* if defined(do_selftestPTWAM) */
-              DBGAPP ("%s: ADDR 0%o U %o M %o F %o FC %o\r\n",
-                      __func__, cpu.PTW->ADDR, cpu.PTW->U, cpu.PTW->M,
-                      cpu.PTW->DF, cpu.PTW->FC);
-              return cpu.PTW;
-            }
+          DBGAPP ("%s: ADDR 0%o U %o M %o F %o FC %o\r\n",
+                  __func__, cpu.PTW->ADDR, cpu.PTW->U, cpu.PTW->M,
+                  cpu.PTW->DF, cpu.PTW->FC);
+          return cpu.PTW;
         }
     }
 
     DPS8M_ (
-      uint setno = (CA >> 10) & 017;
-      uint toffset;
-      ptw_s *p;
-      for (toffset = 0; toffset < 64; toffset += 16)
+      uint setno   = (CA >> 10) & 017;
+      uint toffset = cpu.PTWAMhint[hint] & 060;
+      ptw_s *p     = & cpu.PTWAM[toffset + setno];
+      if ((cpu.PTWAMhint[hint] & 017) != setno || ! p->FE ||
+          pageno != p->PAGENO || p->POINTER != segno)
         {
-          p = & cpu.PTWAM[toffset + setno];
-
-          if (p->FE && ((CA >> 6) & 07760) == p->PAGENO && p->POINTER == segno)
+          for (toffset = 0; toffset < 64; toffset += 16)
             {
-              DBGAPP ("%s: found match for segno=%o pageno=%o "
-                      "at _n=%d\r\n",
-                      __func__, segno, p->PAGENO, toffset + setno);
-              cpu.cu.PTWAMM = 1;
-              cpu.PTWAMR = (word6) (toffset + setno);
-              cpu.PTW = p; // export pointer for appending
-
-              word6 u = calc_hit_am (p->USE, toffset >> 4);
-              for (toffset = 0; toffset < 64; toffset += 16) // update LRU
+              p = & cpu.PTWAM[toffset + setno];
+              if (p->FE && pageno == p->PAGENO && p->POINTER == segno)
                 {
-                  p = & cpu.PTWAM[toffset + setno];
-                  if (p->FE)
-                    p->USE = u;
+                  cpu.PTWAMhint[hint] = (uint8) (toffset + setno);
+                  break;
                 }
+            }
+        }
 
-              DBGAPP ("%s: ADDR 0%o U %o M %o F %o FC %o\r\n",
-                      __func__, cpu.PTW->ADDR, cpu.PTW->U, cpu.PTW->M,
-                      cpu.PTW->DF, cpu.PTW->FC);
-              return cpu.PTW;
+      if (toffset < 64)
+        {
+          DBGAPP ("%s: found match for segno=%o pageno=%o "
+                  "at _n=%d\r\n",
+                  __func__, segno, p->PAGENO, toffset + setno);
+          cpu.cu.PTWAMM = 1;
+          cpu.PTWAMR = (word6) (toffset + setno);
+          cpu.PTW = p; // export pointer for appending
+
+          word6 u = calc_hit_am (p->USE, toffset >> 4);
+          for (toffset = 0; toffset < 64; toffset += 16) // update LRU
+            {
+              p = & cpu.PTWAM[toffset + setno];
+              if (p->FE)
+                p->USE = u;
             }
+
+          DBGAPP ("%s: ADDR 0%o U %o M %o F %o FC %o\r\n",
+                  __func__, cpu.PTW->ADDR, cpu.PTW->U, cpu.PTW->M,
+                  cpu.PTW->DF, cpu.PTW->FC);
+          return cpu.PTW;
         }
      )
     cpu.cu.PTWAMM = 0;
@@ -851,6 +901,7 @@ static void loadPTWAM (cpu_state_t * cpup, word15 segno, word18 offset, UNUSED b
               p->POINTER = segno;
               p->USE = 0;
               p->FE = true;
+              cpu.PTWAMhint[PTWAM_HINT (segno, offset)] = (uint8) _n;
 
               for (int _h = 0; _h < N_L68_WAM_ENTRIES; _h++)
                 {
@@ -900,6 +951,7 @@ static void loadPTWAM (cpu_state_t * cpup, word15 segno, word18 offset, UNUSED b
       p->PAGENO = (offset >> 6) & 07760;
       p->POINTER = segno;
       p->FE = true;  // in use
+      cpu.PTWAMhint[PTWAM_HINT (segno, offset)] = (uint8) (toffset + setno);
       cpu.PTW = p; // export pointer for appending
 
       for (uint toffset1 = 0; toffset1 < 64; toffset1 += 16) // update LRU
@@ -1097,6 +1149,12 @@ word24 do_append_cycle (cpu_state_t * cpup, processor_cycle_type thisCycle, word
 }
 #endif /* if !defined(OLDAPP) */
 
+// The "uninterruptible" EIS instructions run the append cycle in prepage
+// mode (do_ptw2); the ucache must not short-circuit them.
+#define UC_PREPAGE_INS(i) \
+  ((i)->opcodeX && (((i)->opcode & 0770) == 0200 || ((i)->opcode & 0770) == 0220 || \
+                    ((i)->opcode & 0770) == 020  || ((i)->opcode & 0770) == 0300))
+
 #if !defined(OLDAPP)
 # include "doAppendCycleOperandStore.h"
 # include "doAppendCycleOperandRead.h"
@@ -1685,6 +1685,10 @@ void sysCableInit (void)
       }
 #endif
     cables = & system_state->cables;
+#if defined(M_SHARED)
+    scu = system_state->scus;
+    (void)memset (scu, 0, sizeof (system_state->scus));
+#endif /* if defined(M_SHARED) */
 
     // Initialize data structures
     cable_init ();
@@ -76,6 +76,11 @@ __thread uint current_running_cpu_idx;
 
 #include "ver.h"
 
+#if defined(AFFINITY)
+# include <errno.h>
+# include <sys/syscall.h>
+#endif /* if defined(AFFINITY) */
+
 #if defined(_AIX) && !defined(__PASE__)
 # include <pthread.h>
 # include <sys/resource.h>
@@ -141,6 +146,102 @@ static t_stat simh_cpu_reset_and_clear_unit (UNIT * uptr,
                                              UNUSED void * desc);
 char * cycle_str (cycles_e cycle);
 
+#if defined(AFFINITY)
+// Host NUMA node holding simulated main memory, or -1 for the default
+// (first touch) placement
+
+static int numa_node = -1;
+
+# if !defined(MPOL_DEFAULT)
+#  define MPOL_DEFAULT   0
+#  define MPOL_PREFERRED 1
+# endif /* if !defined(MPOL_DEFAULT) */
+# if !defined(MPOL_MF_MOVE)
+#  define MPOL_MF_MOVE   (1 << 1)
+# endif /* if !defined(MPOL_MF_MOVE) */
+
+# define NUMA_NODES_MAX 1024
+
+// Set the memory policy of M to prefer 'node' (or the default policy if
+// node < 0), migrating the pages already touched. Returns 0 or an errno
+// value.
+
+static int bind_memory_node (int node)
+  {
+#  if defined(SYS_mbind)
+    if (! M)
+      return EINVAL;
+    uintptr_t pagesz = (uintptr_t) sysconf (_SC_PAGESIZE);
+    uintptr_t start  = ((uintptr_t) M + pagesz - 1) & ~ (pagesz - 1);
+    uintptr_t end    = ((uintptr_t) (M + MEMSIZE)) & ~ (pagesz - 1);
+    if (end <= start)
+      return EINVAL;
+
+    unsigned long nodemask [NUMA_NODES_MAX / (8 * sizeof (unsigned long))];
+    (void)memset (nodemask, 0, sizeof (nodemask));
+    long rc;
+    if (node < 0)
+      {
+        rc = syscall (SYS_mbind, (void *) start, (unsigned long) (end - start),
+                      MPOL_DEFAULT, NULL, 0UL, 0U);
+      }
+    else
+      {
+        nodemask [(uint) node / (8 * sizeof (unsigned long))] |=
+          1UL << ((uint) node % (8 * sizeof (unsigned long)));
+        rc = syscall (SYS_mbind, (void *) start, (unsigned long) (end - start),
+                      MPOL_PREFERRED, nodemask, (unsigned long) NUMA_NODES_MAX + 1,
+                      MPOL_MF_MOVE);
+      }
+    return rc ? errno : 0;
+#  else
+    (void) node;
+    return ENOSYS;
+#  endif /* if defined(SYS_mbind) */
+  }
+
+static t_stat cpu_show_numa (UNUSED FILE * st, UNUSED UNIT * uptr,
+                             UNUSED int val, UNUSED const void * desc)
+  {
+    if (numa_node < 0)
+      sim_msg ("Memory NUMA node not set\r\n");
+    else
+      sim_msg ("Memory NUMA node %d\r\n", numa_node);
+    return SCPE_OK;
+  }
+
+// set cpu numa=<node>|off
+
+static t_stat cpu_set_numa (UNUSED UNIT * uptr, UNUSED int32 value,
+                            const char * cptr, UNUSED void * desc)
+  {
+    if (! cptr)
+      return SCPE_ARG;
+    int node;
+    if (strcasecmp (cptr, "off") == 0)
+      {
+        node = -1;
+      }
+    else
+      {
+        char * end;
+        long n = strtol (cptr, & end, 0);
+        if (* end != 0 || n < 0 || n >= NUMA_NODES_MAX)
+          return SCPE_ARG;
+        node = (int) n;
+      }
+    int rc = bind_memory_node (node);
+    if (rc)
+      {
+        sim_warn ("NUMA: unable to place memory on node %d: %s\r\n",
+                  node, xstrerror_l (rc));
+        return SCPE_ARG;
+      }
+    numa_node = node;
+    return SCPE_OK;
+  }
+#endif /* if defined(AFFINITY) */
+
 static t_stat cpu_show_config (UNUSED FILE * st, UNIT * uptr,
                                UNUSED int val, UNUSED const void * desc)
   {
@@ -246,6 +347,19 @@ static t_stat cpu_show_config (UNUSED FILE * st, UNIT * uptr,
       sim_msg ("CPU affinity:                 %d\r\n", cpus[cpu_unit_idx].affinity);
     else
       sim_msg ("CPU affinity:                 not set\r\n");
+    if (cpuThreadz[cpu_unit_idx].run)
+      {
+        char placement[256];
+        sim_msg ("CPU thread host CPUs:         %s\r\n",
+                 getThreadAffinity (cpuThreadz[cpu_unit_idx].cpuThread,
+                                    placement, sizeof (placement)));
+      }
+    else
+      sim_msg ("CPU thread host CPUs:         not started\r\n");
+    if (numa_node >= 0)
+      sim_msg ("Memory NUMA node:             %d\r\n", numa_node);
+    else
+      sim_msg ("Memory NUMA node:             not set\r\n");
 #endif
     sim_msg ("ISOLTS mode:                  %01o(8)\r\n", cpus[cpu_unit_idx].tweaks.isolts_mode);
     sim_msg ("NODIS mode:                   %01o(8)\r\n", cpus[cpu_unit_idx].tweaks.nodis);
@@ -604,15 +718,26 @@ static t_stat cpu_set_config (UNIT * uptr, UNUSED int32 value,
           cpus[cpu_unit_idx].tweaks.enable_emcall = v;
 #if defined(AFFINITY)
         else if (strcmp (p, "affinity") == 0)
-          if (v < 0)
-            {
-              cpus[cpu_unit_idx].set_affinity = false;
-            }
-          else
-            {
-              cpus[cpu_unit_idx].set_affinity = true;
-              cpus[cpu_unit_idx].affinity = (uint) v;
-            }
+          {
+            if (v < 0)
+              {
+                cpus[cpu_unit_idx].set_affinity = false;
+              }
+            else
+              {
+                cpus[cpu_unit_idx].set_affinity = true;
+                cpus[cpu_unit_idx].affinity = (uint) v;
+              }
+            // Re-place a running CPU thread now; otherwise createCPUThread
+            // applies it.
+            if (cpuThreadz[cpu_unit_idx].run)
+              {
+                int s = setThreadAffinity (cpuThreadz[cpu_unit_idx].cpuThread, (int) v);
+                if (s)
+                  sim_warn ("Unable to bind CPU %c to host CPU %ld: %s\r\n",
+                            (int) ('A' + cpu_unit_idx), (long) v, xstrerror_l (s));
+              }
+          }
 #endif
         else if (strcmp (p, "isolts_mode") == 0)
           {
@@ -772,6 +897,45 @@ static t_stat cpu_set_kips (UNUSED UNIT * uptr, UNUSED int32 value,
     return SCPE_OK;
   }
 
+static t_stat cpu_show_ucache (UNUSED FILE * st, UNUSED UNIT * uptr,
+                               UNUSED int val, UNUSED const void * desc)
+  {
+    sim_msg ("Micro-cache %u entries, %u sets of %u ways\r\n",
+             ucache_sets * ucache_ways, ucache_sets, ucache_ways);
+    for (uint i = 0; i < cpu_dev.numunits; i ++)
+      ucacheStats ((int) i);
+    return SCPE_OK;
+  }
+
+// set cpu ucache=size[:ways]
+//   size  total entries per cycle class (ways * a power of two sets)
+//   ways  entries per set
+
+static t_stat cpu_set_ucache (UNUSED UNIT * uptr, UNUSED int32 value,
+                              const char * cptr, UNUSED void * desc)
+  {
+    if (! cptr)
+      return SCPE_ARG;
+
+    char * end;
+    long size = strtol (cptr, & end, 0);
+    long ways = (long) ucache_ways;
+    if (* end == ':')
+      ways = strtol (end + 1, & end, 0);
+    if (* end != 0)
+      return SCPE_ARG;
+    if (size < 1 || ways < 1)
+      return SCPE_ARG;
+
+    t_stat rc = ucSetGeometry ((uint) size, (uint) ways);
+    if (rc == SCPE_NOFNC)
+      sim_warn ("UCACHE: the CPUs must be stopped to change the cache size\r\n");
+    else if (rc != SCPE_OK)
+      sim_warn ("UCACHE: size must be at most %u and a power of two multiple of ways (1 to %u)\r\n",
+                UC_CACHE_MAX, UC_MAX_WAYS);
+    return rc;
+  }
+
 static t_stat cpu_show_stall (UNUSED FILE * st, UNUSED UNIT * uptr,
                              UNUSED int val, UNUSED const void * desc)
   {
@@ -997,6 +1161,10 @@ void cpu_reset_unit_idx (UNUSED uint cpun, bool clear_mem)
     cpu.wasXfer        = false;
     cpu.wasInhibited   = false;
 
+#if defined(DECODE_CACHE)
+    dicInvalidate (cpup);
+#endif /* if defined(DECODE_CACHE) */
+
     cpu.interrupt_flag = false;
     cpu.g7_flag        = false;
 
@@ -1151,6 +1319,30 @@ static MTAB cpu_mod[] =
       NULL                            /* Help               */
     },
 
+    {
+      MTAB_dev_value,                 /* Mask               */
+      0,                              /* Match              */
+      "UCACHE",                       /* Print string       */
+      "UCACHE",                       /* Match string       */
+      cpu_set_ucache,                 /* Validation routine */
+      cpu_show_ucache,                /* Display routine    */
+      NULL,                           /* Value descriptor   */
+      NULL                            /* Help               */
+    },
+
+#if defined(AFFINITY)
+    {
+      MTAB_dev_value,                 /* Mask               */
+      0,                              /* Match              */
+      "NUMA",                         /* Print string       */
+      "NUMA",                         /* Match string       */
+      cpu_set_numa,                   /* Validation routine */
+      cpu_show_numa,                  /* Display routine    */
+      NULL,                           /* Value descriptor   */
+      NULL                            /* Help               */
+    },
+#endif /* if defined(AFFINITY) */
+
     {
       MTAB_unit_value,                /* Mask               */
       0,                              /* Match              */
@@ -4129,7 +4321,9 @@ int core_write2 (cpu_state_t * cpup, word24 addr, word36 even, word36 odd, const
 void decode_instruction (cpu_state_t * cpup, word36 inst, DCDstruct * p)
   {
     CPT (cpt1L, 17); // instruction decoder
-    (void)memset (p, 0, sizeof (DCDstruct));
+    // Every other field is assigned below
+    p->stiTally = false;
+    p->restart  = false;
 
     p->opcode   = GET_OP (inst);   // get opcode
     p->opcodeX  = GET_OPX(inst);   // opcode extension
@@ -4156,6 +4350,45 @@ void decode_instruction (cpu_state_t * cpup, word36 inst, DCDstruct * p)
       }
   }
 
+#if defined(DECODE_CACHE)
+void dicInvalidate (cpu_state_t * cpup)
+  {
+    (void)memset (cpu.dic, 0, sizeof (cpu.dic));
+  }
+
+/*
+ * Decode through the decoded instruction cache. 'address' is only a hint
+ * for locating the entry; the entry is used only if it was decoded from
+ * the same instruction word, so a stale or wrong address costs a miss,
+ * never a wrong decode.
+ */
+
+void decode_instruction_cached (cpu_state_t * cpup, word36 inst, word24 address, DCDstruct * p)
+  {
+    dicEntry_t * ep = & cpu.dic [address & DIC_MASK];
+    if (LIKELY (ep->valid && ep->inst == inst && ep->address == address))
+      {
+# if defined(DIC_STATS)
+        cpu.dicHits ++;
+# endif /* if defined(DIC_STATS) */
+        * p = ep->dcd;
+        // Preserve the decoder's side effect on multi-descriptor EIS
+        if (p->info->ndes > 1)
+          (void)memset (& cpu.currentEISinstruction, 0,
+                        sizeof (cpu.currentEISinstruction));
+        return;
+      }
+# if defined(DIC_STATS)
+    cpu.dicMisses ++;
+# endif /* if defined(DIC_STATS) */
+    decode_instruction (cpup, inst, p);
+    ep->inst    = inst;
+    ep->address = address;
+    ep->dcd     = * p;
+    ep->valid   = true;
+  }
+#endif /* if defined(DECODE_CACHE) */
+
 // MM stuff ...
 
 //
@@ -5394,6 +5627,8 @@ void perfTest (char * testName) {
   M = system_state->M;
 # if defined(M_SHARED)
   cpus = system_state->cpus;
+  scu  = system_state->scus;
+  (void) memset (scu, 0, sizeof (system_state->scus));
 # endif /* if defined(M_SHARED) */
   (void) memset (cpus, 0, sizeof (cpu_state_t) * N_CPU_UNITS_MAX);
   for (int i = 0; i < N_CPU_UNITS_MAX; i ++) {
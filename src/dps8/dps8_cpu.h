@@ -685,6 +685,30 @@ typedef struct DCDstruct_s
     bool restart;           // instruction is to be restarted
   } DCDstruct;
 
+#if defined(DECODE_CACHE)
+// Decoded instruction cache
+//
+// Direct-mapped by the final (24-bit) address of the instruction word.
+// Each entry remembers the instruction word it was decoded from; a store
+// into the cached location (by this CPU, another CPU or the IOM) changes
+// the word and the next lookup simply misses, so no explicit invalidation
+// is needed on the write paths.
+//
+// Not enabled by default: decode_instruction is cheap enough that the
+// lookup and copy do not pay for themselves on the perftest workload.
+
+# define DIC_SZ   256
+# define DIC_MASK (DIC_SZ - 1)
+
+typedef struct dicEntry_s
+  {
+    word36    inst;         // instruction word the entry was decoded from
+    word24    address;      // final address of the instruction word
+    bool      valid;
+    DCDstruct dcd;          // decoded instruction
+  } dicEntry_t;
+#endif /* if defined(DECODE_CACHE) */
+
 // Emulator-only interrupt and fault info
 
 typedef struct
@@ -1527,6 +1551,10 @@ enum
 #define N_NAX_WAM_ENTRIES   64
 #define N_MODEL_WAM_ENTRIES (cpu.tweaks.l68_mode ? N_L68_WAM_ENTRIES : N_DPS8M_WAM_ENTRIES)
 
+// Buckets in the SDWAM/PTWAM lookup hints
+#define N_AM_HINTS         256
+#define N_AM_HINT_MASK    0377
+
 #include "ucache.h"
 
 typedef struct coreLockState_s {
@@ -1656,6 +1684,9 @@ typedef struct cpu_state_s
     uint g7Faults;
 
     word24 iefpFinalAddress;
+#if defined(DECODE_CACHE)
+    word24 dicAddress;      // final address of the last instruction fetch
+#endif /* if defined(DECODE_CACHE) */
 
     // ISOLTS fine grain TR estimation
     uint rTRlsb;
@@ -1733,6 +1764,11 @@ typedef struct cpu_state_s
 
     sdw_s SDWAM [N_NAX_WAM_ENTRIES]; // Segment Descriptor Word Associative Memory
 
+    // The SDWAM/PTWAM register that last matched a key in each bucket.
+    // Not architectural; see fetch_sdw_from_sdwam.
+    uint8 SDWAMhint [N_AM_HINTS];
+    uint8 PTWAMhint [N_AM_HINTS];
+
     // Address Modification tally
     word12 AM_tally;
 
@@ -1900,6 +1936,16 @@ typedef struct cpu_state_s
 #if defined(THREADZ) || defined(LOCKLESS)
     pthread_t thread_id;
 #endif
+
+#if defined(DECODE_CACHE)
+    // Decoded instruction cache; kept at the end of the structure so
+    // that it does not push the hot fields apart.
+    dicEntry_t dic [DIC_SZ];
+# if defined(DIC_STATS)
+    uint64_t dicHits;
+    uint64_t dicMisses;
+# endif /* if defined(DIC_STATS) */
+#endif /* if defined(DECODE_CACHE) */
 #define cpt1U   0  // Instruction processing tracking
 #define cpt1L   1  // Instruction processing tracking
 #define cpt2U   2  // Instruction execution tracking
@@ -2390,6 +2436,10 @@ bool get_bar_mode (cpu_state_t * cpup);
 addr_modes_e get_addr_mode (cpu_state_t * cpup);
 void set_addr_mode (cpu_state_t * cpup, addr_modes_e mode);
 void decode_instruction (cpu_state_t * cpup, word36 inst, DCDstruct * p);
+#if defined(DECODE_CACHE)
+void decode_instruction_cached (cpu_state_t * cpup, word36 inst, word24 address, DCDstruct * p);
+void dicInvalidate (cpu_state_t * cpup);
+#endif /* if defined(DECODE_CACHE) */
 #if !defined(SPEED)
 t_stat set_mem_watch (int32 arg, const char * buf);
 #endif /* if !defined(SPEED) */
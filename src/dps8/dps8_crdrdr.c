@@ -689,8 +689,7 @@ empty:;
     case sevenDeck: {
       // This will overread rawCardImage by 12 bits, but that's okay
       // because Multics will ignore the last 12 bits.
-      for (uint i = 0; i < 27; i ++)
-        buffer [i] = extr36 ((uint8 *) rawCardImage, i);
+      unpack72_block ((uint8 *) rawCardImage, 0, buffer, 27);
       //sim_printf ("7deck %012"PRIo64" %012"PRIo64" %012"PRIo64" %012"PRIo64"\r\n",
       //             buffer [0], buffer [1], buffer [2], buffer [3]);
     }
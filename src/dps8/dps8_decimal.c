@@ -18,6 +18,7 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 
 #include "dps8.h"
 #include "dps8_sys.h"
@@ -822,6 +823,492 @@ mvn_write:;
   return (char *) out;
 }
 
+/*
+ * Fixed-point fast path
+ *
+ * When the receiving field is fixed point, decFixedAdd, decFixedSubtract,
+ * decFixedMultiply and decFixedDivide compute the result on plain Unit
+ * arrays and format it directly. They produce the same digits, indicators
+ * and final value that the decNumber operation followed by formatDecimal
+ * would.
+ *
+ * formatDecimal takes TRUNC from the exponent of the unformatted result,
+ * not just its value, so the helpers below also reproduce the exponent
+ * decNumber would choose. Anything they do not model returns NULL, and the
+ * caller takes the decNumber path:
+ *
+ *  - results that would be rounded in the working context;
+ *  - the 63 digit internal register overflow of the add and subtract
+ *    instructions;
+ *  - overflow of the receiving field;
+ *  - rescales that do not fit.
+ */
+
+# define DF_DIGITS 160
+# define DF_UNITS  SD2U (DF_DIGITS)
+# define DF_BASE   ((uint64_t) DECDPUNMAX + 1)
+
+typedef struct dfCoef
+  {
+    Unit u [DF_UNITS + 1]; // least significant Unit first
+    int units;             // Units in use; zero is a single 0 Unit
+  } dfCoef;
+
+typedef struct dfNumber
+  {
+    dfCoef c;
+    int exponent;
+    bool neg;
+  } dfNumber;
+
+static void dfTrim (dfCoef * c) {
+  while (c->units > 1 && c->u [c->units - 1] == 0)
+    c->units --;
+}
+
+static bool dfIsZero (const dfCoef * c) {
+  return c->units == 1 && c->u [0] == 0;
+}
+
+// digit count, counting zero as one digit like decNumber
+static int dfDigits (const dfCoef * c) {
+  int digits = (c->units - 1) * DECDPUN + 1;
+  for (int i = 1; i < DECDPUN && c->u [c->units - 1] >= DECPOWERS [i]; i ++)
+    digits ++;
+  return digits;
+}
+
+static void dfFromNumber (dfCoef * c, const decNumber * dn) {
+  c->units = (int) D2U (dn->digits);
+  memcpy (c->u, dn->lsu, (size_t) c->units * sizeof (Unit));
+}
+
+// digit p of c, counting from the least significant digit
+static uInt dfDigitAt (const dfCoef * c, int p) {
+  if (p / DECDPUN >= c->units)
+    return 0;
+  return (c->u [p / DECDPUN] / DECPOWERS [p % DECDPUN]) % 10;
+}
+
+// c *= 10^k; false if the result would not fit
+static bool dfShiftLeft (dfCoef * c, int k) {
+  if (k == 0 || dfIsZero (c))
+    return true;
+  if (dfDigits (c) + k > DF_DIGITS)
+    return false;
+  uInt mult = DECPOWERS [k % DECDPUN];
+  if (mult > 1) {
+    uint64_t carry = 0;
+    for (int i = 0; i < c->units; i ++) {
+      uint64_t t = (uint64_t) c->u [i] * mult + carry;
+      c->u [i] = (Unit) (t % DF_BASE);
+      carry = t / DF_BASE;
+    }
+    if (carry)
+      c->u [c->units ++] = (Unit) carry;
+  }
+  int shift = k / DECDPUN;
+  if (shift) {
+    memmove (c->u + shift, c->u, (size_t) c->units * sizeof (Unit));
+    memset (c->u, 0, (size_t) shift * sizeof (Unit));
+    c->units += shift;
+  }
+  return true;
+}
+
+// c /= 10^k, truncating; returns the most significant digit dropped
+static uInt dfShiftRight (dfCoef * c, int k) {
+  if (k == 0)
+    return 0;
+  uInt first = dfDigitAt (c, k - 1);
+  int shift = k / DECDPUN;
+  if (shift >= c->units) {
+    c->units = 1;
+    c->u [0] = 0;
+    return first;
+  }
+  if (shift) {
+    memmove (c->u, c->u + shift, (size_t) (c->units - shift) * sizeof (Unit));
+    c->units -= shift;
+  }
+  uInt div = DECPOWERS [k % DECDPUN];
+  if (div > 1) {
+    uint64_t rem = 0;
+    for (int i = c->units - 1; i >= 0; i --) {
+      uint64_t t = rem * DF_BASE + c->u [i];
+      c->u [i] = (Unit) (t / div);
+      rem = t % div;
+    }
+    dfTrim (c);
+  }
+  return first;
+}
+
+static void dfIncrement (dfCoef * c) {
+  for (int i = 0; i < c->units; i ++) {
+    if (c->u [i] < DECDPUNMAX) {
+      c->u [i] ++;
+      return;
+    }
+    c->u [i] = 0;
+  }
+  c->u [c->units ++] = 1;
+}
+
+static int dfCompare (const dfCoef * a, const dfCoef * b) {
+  if (a->units != b->units)
+    return a->units > b->units ? 1 : -1;
+  for (int i = a->units - 1; i >= 0; i --)
+    if (a->u [i] != b->u [i])
+      return a->u [i] > b->u [i] ? 1 : -1;
+  return 0;
+}
+
+// r = a + b
+static void dfAdd (dfCoef * r, const dfCoef * a, const dfCoef * b) {
+  int n = max (a->units, b->units);
+  uInt carry = 0;
+  for (int i = 0; i < n; i ++) {
+    uInt t = (i < a->units ? a->u [i] : 0) + (i < b->units ? b->u [i] : 0) + carry;
+    carry = t > DECDPUNMAX;
+    r->u [i] = (Unit) (carry ? t - DF_BASE : t);
+  }
+  r->units = n;
+  if (carry)
+    r->u [r->units ++] = 1;
+}
+
+// r = a - b, where a >= b
+static void dfSubtract (dfCoef * r, const dfCoef * a, const dfCoef * b) {
+  Int borrow = 0;
+  for (int i = 0; i < a->units; i ++) {
+    Int t = (Int) a->u [i] - (Int) (i < b->units ? b->u [i] : 0) - borrow;
+    borrow = t < 0;
+    r->u [i] = (Unit) (borrow ? t + (Int) DF_BASE : t);
+  }
+  r->units = a->units;
+  dfTrim (r);
+}
+
+// r = a * b
+static void dfMultiply (dfCoef * r, const dfCoef * a, const dfCoef * b) {
+  uint64_t acc [DF_UNITS + 1] = { 0 };
+  for (int i = 0; i < a->units; i ++) {
+    uint64_t carry = 0;
+    for (int j = 0; j < b->units; j ++) {
+      uint64_t t = acc [i + j] + (uint64_t) a->u [i] * b->u [j] + carry;
+      acc [i + j] = t % DF_BASE;
+      carry = t / DF_BASE;
+    }
+    acc [i + b->units] = carry;
+  }
+  r->units = a->units + b->units;
+  for (int i = 0; i < r->units; i ++)
+    r->u [i] = (Unit) acc [i];
+  dfTrim (r);
+}
+
+// q = a / b, truncating; b is not zero. Returns true if the division was
+// exact. (Knuth, TAOCP 4.3.1, algorithm D)
+static bool dfDivide (dfCoef * q, const dfCoef * a, const dfCoef * b) {
+  int n = b->units;
+  int m = a->units - n;
+  if (m < 0) {
+    q->units = 1;
+    q->u [0] = 0;
+    return dfIsZero (a);
+  }
+  if (n == 1) {
+    uint64_t rem = 0;
+    for (int i = a->units - 1; i >= 0; i --) {
+      uint64_t t = rem * DF_BASE + a->u [i];
+      q->u [i] = (Unit) (t / b->u [0]);
+      rem = t % b->u [0];
+    }
+    q->units = a->units;
+    dfTrim (q);
+    return rem == 0;
+  }
+
+  // normalize so that the divisor's top Unit is at least half the base
+  uint64_t d = DF_BASE / ((uint64_t) b->u [n - 1] + 1);
+  Unit u [DF_UNITS + 2], v [DF_UNITS + 1];
+  uint64_t carry = 0;
+  for (int i = 0; i < a->units; i ++) {
+    uint64_t t = a->u [i] * d + carry;
+    u [i] = (Unit) (t % DF_BASE);
+    carry = t / DF_BASE;
+  }
+  u [a->units] = (Unit) carry;
+  carry = 0;
+  for (int i = 0; i < n; i ++) {
+    uint64_t t = b->u [i] * d + carry;
+    v [i] = (Unit) (t % DF_BASE);
+    carry = t / DF_BASE;
+  }
+
+  for (int j = m; j >= 0; j --) {
+    uint64_t num = (uint64_t) u [j + n] * DF_BASE + u [j + n - 1];
+    uint64_t qhat = num / v [n - 1];
+    uint64_t rhat = num % v [n - 1];
+    while (qhat >= DF_BASE || qhat * v [n - 2] > rhat * DF_BASE + u [j + n - 2]) {
+      qhat --;
+      rhat += v [n - 1];
+      if (rhat >= DF_BASE)
+        break;
+    }
+
+    // u[j..j+n] -= qhat * v
+    int64_t borrow = 0;
+    carry = 0;
+    for (int i = 0; i < n; i ++) {
+      uint64_t p = qhat * v [i] + carry;
+      carry = p / DF_BASE;
+      int64_t t = (int64_t) u [i + j] - (int64_t) (p % DF_BASE) - borrow;
+      borrow = t < 0;
+      u [i + j] = (Unit) (borrow ? t + (int64_t) DF_BASE : t);
+    }
+    int64_t top = (int64_t) u [j + n] - (int64_t) carry - borrow;
+    if (top < 0) {
+      // qhat was one too large; add the divisor back
+      qhat --;
+      uInt c = 0;
+      for (int i = 0; i < n; i ++) {
+        uInt s = u [i + j] + v [i] + c;
+        c = s > DECDPUNMAX;
+        u [i + j] = (Unit) (c ? s - DF_BASE : s);
+      }
+      top += c;
+    }
+    u [j + n] = (Unit) top;
+    q->u [j] = (Unit) qhat;
+  }
+  q->units = m + 1;
+  dfTrim (q);
+
+  for (int i = 0; i < n; i ++)
+    if (u [i])
+      return false;
+  return true;
+}
+
+// decAddOp: lhs + (rhs with its sign inverted by negate). An exact sum has
+// the lower of the two exponents, except that a zero operand only pads the
+// other as far as the context allows.
+static bool dfAddOp (dfNumber * r, const decNumber * lhs, const decNumber * rhs,
+                     uByte negate, int reqdigits) {
+  bool lneg = (lhs->bits & DECNEG) != 0;
+  bool rneg = ((rhs->bits ^ negate) & DECNEG) != 0;
+  int exp = min (lhs->exponent, rhs->exponent);
+
+  if (ISZERO (lhs) || ISZERO (rhs)) {
+    const decNumber * x = ISZERO (lhs) ? rhs : lhs;
+    dfFromNumber (& r->c, x);
+    r->neg = ISZERO (lhs) ? rneg : lneg;
+    if (ISZERO (x))
+      r->exponent = exp;
+    else {
+      r->exponent = max (exp, x->exponent - (reqdigits - x->digits));
+      (void) dfShiftLeft (& r->c, x->exponent - r->exponent);
+    }
+    // more would overflow the instructions' 63 digit internal register
+    return dfDigits (& r->c) <= 63;
+  }
+
+  // the aligned operands must leave room for the carry
+  if (max (lhs->digits + lhs->exponent, rhs->digits + rhs->exponent) - exp >= reqdigits)
+    return false;
+
+  dfCoef a, b;
+  dfFromNumber (& a, lhs);
+  (void) dfShiftLeft (& a, lhs->exponent - exp);
+  dfFromNumber (& b, rhs);
+  (void) dfShiftLeft (& b, rhs->exponent - exp);
+  if (lneg == rneg) {
+    dfAdd (& r->c, & a, & b);
+    r->neg = lneg;
+  } else if (dfCompare (& a, & b) >= 0) {
+    dfSubtract (& r->c, & a, & b);
+    r->neg = lneg;
+  } else {
+    dfSubtract (& r->c, & b, & a);
+    r->neg = rneg;
+  }
+  r->exponent = exp;
+  return dfDigits (& r->c) <= 63;
+}
+
+// decMultiplyOp; the product of two 63 digit operands is exact in the 126
+// digit context
+static bool dfMultiplyOp (dfNumber * r, const decNumber * lhs, const decNumber * rhs,
+                          int reqdigits) {
+  dfCoef a, b;
+  dfFromNumber (& a, lhs);
+  dfFromNumber (& b, rhs);
+  dfMultiply (& r->c, & a, & b);
+  if (dfDigits (& r->c) > reqdigits)
+    return false;
+  r->exponent = lhs->exponent + rhs->exponent;
+  r->neg = ((lhs->bits ^ rhs->bits) & DECNEG) != 0;
+  return true;
+}
+
+// decDivideOp. An inexact quotient is rounded half up to reqdigits. An exact
+// one takes the ideal exponent (that of lhs less that of rhs), or the
+// exponent that makes it exact if that is lower.
+static bool dfDivideOp (dfNumber * r, const decNumber * lhs, const decNumber * rhs,
+                        int reqdigits) {
+  int ideal = lhs->exponent - rhs->exponent;
+
+  if (ISZERO (rhs))
+    return false;
+  r->neg = ((lhs->bits ^ rhs->bits) & DECNEG) != 0;
+  if (ISZERO (lhs)) {
+    r->c.units = 1;
+    r->c.u [0] = 0;
+    r->exponent = ideal;
+    return true;
+  }
+
+  // develop at least one digit more than the working precision
+  int shift = reqdigits + 1 - lhs->digits + rhs->digits;
+  dfCoef a, b;
+  dfFromNumber (& a, lhs);
+  if (shift < 0 || ! dfShiftLeft (& a, shift))
+    return false;
+  dfFromNumber (& b, rhs);
+  bool exact = dfDivide (& r->c, & a, & b);
+  r->exponent = ideal - shift;
+
+  int drop = dfDigits (& r->c) - reqdigits;
+  for (int i = 0; exact && i < drop; i ++)
+    exact = dfDigitAt (& r->c, i) == 0;
+
+  if (exact) {
+    while (r->exponent < ideal && dfDigitAt (& r->c, 0) == 0) {
+      (void) dfShiftRight (& r->c, 1);
+      r->exponent ++;
+    }
+    return dfDigits (& r->c) <= reqdigits;
+  }
+
+  if (dfShiftRight (& r->c, drop) >= 5)
+    dfIncrement (& r->c);
+  r->exponent += drop;
+  if (dfDigits (& r->c) > reqdigits) {
+    (void) dfShiftRight (& r->c, 1);
+    r->exponent ++;
+  }
+  return true;
+}
+
+// formatDecimal for fixed-point results that do not overflow
+static char * dfFormat (uint8_t * out, decNumber * r, dfNumber * v, int nout, int sf,
+                        bool R, bool * OVR, bool * TRUNC) {
+  bool trunc = false;
+
+  if (sf != v->exponent) {
+    if (v->exponent > sf) {
+      // formatDecimal widens the context up to DECNUMDIGITS for this
+      if (dfDigits (& v->c) + v->exponent - sf > DECNUMDIGITS)
+        return NULL;
+      (void) dfShiftLeft (& v->c, v->exponent - sf);
+    } else {
+      if (! R)
+        trunc = true;
+      if (dfShiftRight (& v->c, sf - v->exponent) >= 5 && R)
+        dfIncrement (& v->c);
+    }
+    v->exponent = sf;
+  }
+
+  int digits = dfDigits (& v->c);
+  bool zero = dfIsZero (& v->c);
+  int intdigits = zero ? 0 : sf >= 0 ? digits : max (digits + sf, 0);
+  if (nout + min (sf, 0) < intdigits || nout < digits)
+    return NULL;
+
+  int p = nout;
+  for (int i = 0; i < v->c.units && p > 0; i ++) {
+    uInt unit = v->c.u [i];
+    for (int j = 0; j < DECDPUN && p > 0; j ++) {
+      out [-- p] = (uint8_t) ('0' + unit % 10);
+      unit /= 10;
+    }
+  }
+  while (p > 0)
+    out [-- p] = '0';
+  out [nout] = 0;
+
+  decNumberZero (r);
+  r->digits = digits;
+  r->exponent = sf;
+  r->bits = v->neg && ! zero ? DECNEG : 0;
+  memcpy (r->lsu, v->c.u, (size_t) v->c.units * sizeof (Unit));
+
+  * OVR = false;
+  * TRUNC = trunc;
+  return (char *) out;
+}
+
+enum { DF_ADD, DF_SUBTRACT, DF_MULTIPLY, DF_DIVIDE };
+
+static char * dfArith (uint8_t * out, decNumber * res, int op, const decNumber * lhs,
+                       const decNumber * rhs, decContext * set, int nout, int sf,
+                       bool R, bool * OVR, bool * TRUNC) {
+  dfNumber v;
+  bool ok;
+
+  v.c.units = 1;
+  v.c.u [0] = 0;
+  v.exponent = 0;
+  v.neg = false;
+
+  if (set->round != DEC_ROUND_HALF_UP)
+    return NULL;
+  if (lhs->digits > 63 || rhs->digits > 63 || ((lhs->bits | rhs->bits) & DECSPECIAL))
+    return NULL;
+
+  switch (op) {
+    case DF_ADD:
+    case DF_SUBTRACT:
+      ok = dfAddOp (& v, lhs, rhs, op == DF_SUBTRACT ? DECNEG : 0, set->digits);
+      break;
+    case DF_MULTIPLY:
+      ok = dfMultiplyOp (& v, lhs, rhs, set->digits);
+      break;
+    case DF_DIVIDE:
+      ok = dfDivideOp (& v, lhs, rhs, set->digits);
+      break;
+    default:
+      ok = false;
+      break;
+  }
+  if (! ok)
+    return NULL;
+  return dfFormat (out, res, & v, nout, sf, R, OVR, TRUNC);
+}
+
+char * decFixedAdd (uint8_t * out, decNumber * res, const decNumber * lhs, const decNumber * rhs,
+                    decContext * set, int nout, int sf, bool R, bool * OVR, bool * TRUNC) {
+  return dfArith (out, res, DF_ADD, lhs, rhs, set, nout, sf, R, OVR, TRUNC);
+}
+
+char * decFixedSubtract (uint8_t * out, decNumber * res, const decNumber * lhs, const decNumber * rhs,
+                         decContext * set, int nout, int sf, bool R, bool * OVR, bool * TRUNC) {
+  return dfArith (out, res, DF_SUBTRACT, lhs, rhs, set, nout, sf, R, OVR, TRUNC);
+}
+
+char * decFixedMultiply (uint8_t * out, decNumber * res, const decNumber * lhs, const decNumber * rhs,
+                         decContext * set, int nout, int sf, bool R, bool * OVR, bool * TRUNC) {
+  return dfArith (out, res, DF_MULTIPLY, lhs, rhs, set, nout, sf, R, OVR, TRUNC);
+}
+
+char * decFixedDivide (uint8_t * out, decNumber * res, const decNumber * lhs, const decNumber * rhs,
+                       decContext * set, int nout, int sf, bool R, bool * OVR, bool * TRUNC) {
+  return dfArith (out, res, DF_DIVIDE, lhs, rhs, set, nout, sf, R, OVR, TRUNC);
+}
+
 #if !defined(QUIET_UNUSED)
 // If the lhs is less than the rhs in the total order then the number
 // will be set to the value -1. If they are equal, then number is set
@@ -45,6 +45,18 @@ decContext * decContextDefaultDPS8Mul(decContext *context);
 decNumber  * decBCD9ToNumber(const word9 *bcd, Int length, const Int scale, decNumber *dn);
 char *formatDecimal(uint8_t * out, decContext *set, decNumber *r, int nout, int s,
                     int sf, bool R, bool *OVR, bool *TRUNC);
+char *decFixedAdd(uint8_t * out, decNumber *res, const decNumber *lhs,
+                  const decNumber *rhs, decContext *set, int nout, int sf,
+                  bool R, bool *OVR, bool *TRUNC);
+char *decFixedSubtract(uint8_t * out, decNumber *res, const decNumber *lhs,
+                       const decNumber *rhs, decContext *set, int nout, int sf,
+                       bool R, bool *OVR, bool *TRUNC);
+char *decFixedMultiply(uint8_t * out, decNumber *res, const decNumber *lhs,
+                       const decNumber *rhs, decContext *set, int nout, int sf,
+                       bool R, bool *OVR, bool *TRUNC);
+char *decFixedDivide(uint8_t * out, decNumber *res, const decNumber *lhs,
+                     const decNumber *rhs, decContext *set, int nout, int sf,
+                     bool R, bool *OVR, bool *TRUNC);
 //uint8_t * decBCDFromNumber(uint8_t *bcd, int length, int *scale, const decNumber *dn);
 //unsigned char *getBCD(decNumber *a);
 //char *getBCDn(decNumber *a, int digits);
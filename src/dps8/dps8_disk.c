@@ -33,6 +33,16 @@
 // source/library_dir_dir/system_library_1/source/bound_rcp_.s.archive/rcp_disk_.pl1
 
 #include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#if !defined(__MINGW64__) && !defined(__MINGW32__) && !defined(CROSS_MINGW64) && !defined(CROSS_MINGW32)
+# include <sys/mman.h>
+# include <sys/file.h>
+# include <fcntl.h>
+# define DISK_MMAP
+# define DISK_COW_LOCK
+#endif
 
 #include "dps8.h"
 #include "dps8_iom.h"
@@ -173,6 +183,14 @@ static uint tAndDCapac[N_DISK_TYPES] = { 451860, 639920, 619400, 312360, 242250,
 
 struct dsk_state dsk_states [N_DSK_UNITS_MAX];
 
+#if defined(LOCKLESS)
+# define LOCK_DISK(n)   lock_ptr (& dsk_states[n].dsk_lock)
+# define UNLOCK_DISK(n) unlock_ptr (& dsk_states[n].dsk_lock)
+#else
+# define LOCK_DISK(n)
+# define UNLOCK_DISK(n)
+#endif /* if defined(LOCKLESS) */
+
 //-- // extern t_stat disk_svc(UNIT *up);
 
 // ./library_dir_dir/include/fs_dev_types.incl.alm
@@ -339,6 +357,164 @@ static DEBTAB disk_dt[] =
     { NULL,     0,          NULL }
   };
 
+#if defined(LOCKLESS)
+//
+// Asynchronous disk I/O
+//
+// With SET DISK ASYNC=n, connects on disk channels are queued to a pool of
+// n host threads which run the channel program, rather than being run by
+// the CPU that issued the connect. The CPU is not held up by the host I/O,
+// and each disk channel can have a transfer in flight at the same time, as
+// on a real MSP800 subsystem. doPayloadChannel sends the terminate
+// interrupt when the program completes, just as in the synchronous case.
+//
+// A channel's programs are run in the order they were connected, never two
+// at once: a worker takes the channel lock for the program, as the IOM does
+// for a synchronous one, and a channel with a program queued or running
+// keeps queueing, even after ASYNC=0 or with the queue full, rather than
+// having a later program run past it. Threads, once started, are kept;
+// those above a reduced ASYNC count sit idle, except to drain the queue
+// after ASYNC=0.
+
+# define N_DSK_ASYNC_MAX 16
+# define DSK_ASYNC_QUEUE_SZ (N_IOM_UNITS_MAX * MAX_CHANNELS)
+
+static struct
+  {
+    uint nWorkers;   // 0: synchronous
+    uint nStarted;
+    pthread_t workers [N_DSK_ASYNC_MAX];
+    uint workerIdx [N_DSK_ASYNC_MAX];
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    pthread_cond_t space;            // signalled when the queue shrinks
+    uint queue [DSK_ASYNC_QUEUE_SZ]; // iomUnitIdx * MAX_CHANNELS + chan
+    uint count;
+    bool busy [N_IOM_UNITS_MAX] [MAX_CHANNELS];
+    uint pending [N_IOM_UNITS_MAX] [MAX_CHANNELS]; // queued or running
+  } dsk_async;
+
+// Take the oldest queued program whose channel is idle. Called with the
+// lock held.
+
+static bool dsk_async_dequeue (uint * iomUnitIdx, uint * chan)
+  {
+    for (uint i = 0; i < dsk_async.count; i ++)
+      {
+        uint iom = dsk_async.queue[i] / MAX_CHANNELS;
+        uint chn = dsk_async.queue[i] % MAX_CHANNELS;
+        if (dsk_async.busy[iom][chn])
+          continue;
+        (void)memmove (& dsk_async.queue[i], & dsk_async.queue[i + 1],
+                       (dsk_async.count - i - 1) * sizeof (dsk_async.queue[0]));
+        dsk_async.count --;
+        dsk_async.busy[iom][chn] = true;
+        pthread_cond_signal (& dsk_async.space);
+        * iomUnitIdx = iom;
+        * chan       = chn;
+        return true;
+      }
+    return false;
+  }
+
+static void * dsk_async_main (void * arg)
+  {
+    uint myIdx = * (uint *) arg;
+
+    // Set CPU context to allow sim_debug to work
+    set_cpu_idx (0);
+    setSignals ();
+
+    pthread_mutex_lock (& dsk_async.lock);
+    while (1)
+      {
+        uint iomUnitIdx, chan;
+        bool enabled = myIdx < dsk_async.nWorkers || dsk_async.nWorkers == 0;
+        if (! enabled || ! dsk_async_dequeue (& iomUnitIdx, & chan))
+          {
+            pthread_cond_wait (& dsk_async.cond, & dsk_async.lock);
+            continue;
+          }
+        pthread_mutex_unlock (& dsk_async.lock);
+        lock_chan (iomUnitIdx, chan);
+        (void)doPayloadChannel (iomUnitIdx, chan);
+        unlock_chan (iomUnitIdx, chan);
+        pthread_mutex_lock (& dsk_async.lock);
+        dsk_async.busy[iomUnitIdx][chan] = false;
+        dsk_async.pending[iomUnitIdx][chan] --;
+        // Another program may have been waiting for this channel
+        if (dsk_async.count)
+          pthread_cond_broadcast (& dsk_async.cond);
+      }
+    return NULL;
+  }
+
+// Called by the IOM for each PCW connect; returns true if the channel
+// program has been queued for a worker.
+
+bool dsk_async_connect (uint iomUnitIdx, uint chan)
+  {
+    // No thread was ever started, so nothing can be queued or running
+    if (! dsk_async.nStarted)
+      return false;
+    enum ctlr_type_e ctlr_type = cables->iom_to_ctlr[iomUnitIdx][chan].ctlr_type;
+    if (ctlr_type != CTLR_T_IPC && ctlr_type != CTLR_T_MSP)
+      return false;
+
+    pthread_mutex_lock (& dsk_async.lock);
+    if (! dsk_async.nWorkers && ! dsk_async.pending[iomUnitIdx][chan])
+      {
+        pthread_mutex_unlock (& dsk_async.lock);
+        return false;
+      }
+    // Wait for a slot; running this program here instead could overtake,
+    // or run alongside, one already queued for the channel.
+    while (dsk_async.count >= DSK_ASYNC_QUEUE_SZ)
+      pthread_cond_wait (& dsk_async.space, & dsk_async.lock);
+    dsk_async.queue[dsk_async.count ++] = iomUnitIdx * MAX_CHANNELS + chan;
+    dsk_async.pending[iomUnitIdx][chan] ++;
+    pthread_cond_broadcast (& dsk_async.cond);
+    pthread_mutex_unlock (& dsk_async.lock);
+    return true;
+  }
+
+static t_stat disk_show_async (UNUSED FILE * st, UNUSED UNIT * uptr, UNUSED int val, UNUSED const void * desc)
+  {
+    if (dsk_async.nWorkers)
+      sim_printf("DISK I/O is asynchronous, using %u threads\r\n", dsk_async.nWorkers);
+    else
+      sim_printf("DISK I/O is synchronous\r\n");
+    return SCPE_OK;
+  }
+
+static t_stat disk_set_async (UNUSED UNIT * uptr, UNUSED int32 value, const char * cptr, UNUSED void * desc)
+  {
+    if (! cptr)
+      return SCPE_ARG;
+    int n = atoi (cptr);
+    if (n < 0 || n > N_DSK_ASYNC_MAX)
+      return SCPE_ARG;
+    pthread_mutex_lock (& dsk_async.lock);
+    while (dsk_async.nStarted < (uint) n)
+      {
+        dsk_async.workerIdx[dsk_async.nStarted] = dsk_async.nStarted;
+        int rc = pthread_create (& dsk_async.workers[dsk_async.nStarted], NULL,
+                                 dsk_async_main,
+                                 & dsk_async.workerIdx[dsk_async.nStarted]);
+        if (rc)
+          {
+            sim_warn ("%s: pthread_create returned %d\r\n", __func__, rc);
+            break;
+          }
+        dsk_async.nStarted ++;
+      }
+    dsk_async.nWorkers = dsk_async.nStarted < (uint) n ? dsk_async.nStarted : (uint) n;
+    pthread_cond_broadcast (& dsk_async.cond);
+    pthread_mutex_unlock (& dsk_async.lock);
+    return SCPE_OK;
+  }
+#endif /* if defined(LOCKLESS) */
+
 static t_stat disk_show_nunits (UNUSED FILE * st, UNUSED UNIT * uptr, UNUSED int val, UNUSED const void * desc)
   {
     sim_printf("Number of DISK units in system is %d\r\n", dsk_dev . numunits);
@@ -356,6 +532,28 @@ static t_stat disk_set_nunits (UNUSED UNIT * uptr, UNUSED int32 value, const cha
     return SCPE_OK;
   }
 
+#if defined(DISK_MMAP)
+// Seconds between msyncs of a mapped image; 0 syncs every write through.
+static uint diskSyncInterval = 60;
+
+static t_stat disk_show_msync (UNUSED FILE * st, UNUSED UNIT * uptr, UNUSED int val, UNUSED const void * desc)
+  {
+    sim_printf("Mapped DISK images are synced every %u seconds\r\n", diskSyncInterval);
+    return SCPE_OK;
+  }
+
+static t_stat disk_set_msync (UNUSED UNIT * uptr, UNUSED int32 value, const char * cptr, UNUSED void * desc)
+  {
+    if (! cptr)
+      return SCPE_ARG;
+    int n = atoi (cptr);
+    if (n < 0)
+      return SCPE_ARG;
+    diskSyncInterval = (uint) n;
+    return SCPE_OK;
+  }
+#endif /* if defined(DISK_MMAP) */
+
 static t_stat disk_show_type (UNUSED FILE * st, UNUSED UNIT * uptr, UNUSED int val, UNUSED const void * desc)
   {
     int diskUnitIdx = (int) DSK_UNIT_IDX (uptr);
@@ -542,27 +740,531 @@ static t_stat disk_set_ready (UNIT * uptr, UNUSED int32 value,
     return signal_disk_ready ((uint) disk_unit_idx);
   }
 
-t_stat unloadDisk (uint dsk_unit_idx) {
-  if (dsk_unit [dsk_unit_idx] . flags & UNIT_ATT) {
-    t_stat stat = sim_disk_detach (& dsk_unit [dsk_unit_idx]);
-    if (stat != SCPE_OK) {
-      sim_warn ("%s: sim_disk_detach returned %ld\r\n", __func__, (long) stat);
+#if defined(DISK_MMAP)
+// attach -m: map the whole image into memory so transfers convert straight
+// to and from the packed72 sectors, bypassing stdio. A writable image is
+// extended (sparsely) to the capacity of the drive type so that every
+// sector Multics can address is mapped; anything outside the mapping, as
+// when the type is changed after attach, still goes through stdio.
+
+static void diskMap (uint dsk_unit_idx)
+  {
+    UNIT * unitp                   = & dsk_unit[dsk_unit_idx];
+    struct dsk_state * disk_statep = & dsk_states[dsk_unit_idx];
+    struct diskType_t * typep      = & diskTypes[disk_statep->typeIdx];
+    int fd                         = fileno (unitp->fileref);
+    // A write-protected unit (LOAD ... ro sets MTUF_WLK on a file opened
+    // for writing) must be neither extended nor mapped writable.
+    bool writable                  = ! (unitp->flags & MTUF_WRP);
+
+    struct stat st;
+    if (fstat (fd, & st))
+      {
+        sim_warn ("%s: fstat returned errno %d; not mapped\r\n", __func__, errno);
+        return;
+      }
+    uint64 size       = (uint64) st.st_size;
+    uint64 capacBytes = (uint64) typep->capac * ((36 * typep->sectorSizeWords) / 8);
+    if (writable && size < capacBytes)
+      {
+        if (ftruncate (fd, (off_t) capacBytes))
+          {
+            sim_warn ("%s: ftruncate returned errno %d; not mapped\r\n", __func__, errno);
+            return;
+          }
+        size = capacBytes;
+      }
+    if (size == 0 || size > SIZE_MAX)
+      {
+        sim_warn ("%s: image size %llu cannot be mapped\r\n", __func__, (unsigned long long) size);
+        return;
+      }
+
+    void * map = mmap (NULL, (size_t) size,
+                       writable ? PROT_READ | PROT_WRITE : PROT_READ,
+                       MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED)
+      {
+        sim_warn ("%s: mmap returned errno %d; not mapped\r\n", __func__, errno);
+        return;
+      }
+    disk_statep->map         = (uint8 *) map;
+    disk_statep->mapSize     = (size_t) size;
+    disk_statep->mapWritable = writable;
+    disk_statep->mapSyncTime = time (NULL);
+  }
+
+static void diskUnmap (uint dsk_unit_idx)
+  {
+    struct dsk_state * disk_statep = & dsk_states[dsk_unit_idx];
+    if (! disk_statep->map)
+      return;
+    if (disk_statep->mapWritable)
+      (void)msync (disk_statep->map, disk_statep->mapSize, MS_SYNC);
+    (void)munmap (disk_statep->map, disk_statep->mapSize);
+    disk_statep->map     = NULL;
+    disk_statep->mapSize = 0;
+  }
+
+// True if the byte range lies within the unit's mapping.
+
+static bool diskMapped (struct dsk_state * disk_statep, uint64 offset, uint64 nBytes)
+  {
+    return disk_statep->map && offset + nBytes <= disk_statep->mapSize;
+  }
+
+static void diskSync (struct dsk_state * disk_statep, uint64 offset, uint64 nBytes)
+  {
+    if (diskSyncInterval == 0)
+      {
+        uint64 pageMask = (uint64) sysconf (_SC_PAGESIZE) - 1;
+        uint64 start    = offset & ~pageMask;
+        (void)msync (disk_statep->map + start, (size_t) (offset + nBytes - start), MS_SYNC);
+        return;
+      }
+    time_t now = time (NULL);
+    if (now - disk_statep->mapSyncTime < (time_t) diskSyncInterval)
+      return;
+    (void)msync (disk_statep->map, disk_statep->mapSize, MS_ASYNC);
+    disk_statep->mapSyncTime = now;
+  }
+#endif /* if defined(DISK_MMAP) */
+
+// attach -o: copy-on-write overlay. The attached image is opened read-only
+// and may be shared by any number of instances; sectors written by this
+// instance go to a sparse delta file instead. The delta file is a 512 byte
+// text header, a bitmap with one bit per DSK_COW_CHUNK bytes of image, and
+// then the chunks themselves at their image offsets (plus the data offset),
+// so untouched chunks are holes. The chunk is the smallest sector size, so
+// changing the disk type under an overlay is harmless.
+//
+// The overlay belongs to one instance: its path must be given with SET
+// DISKn OVERLAY=, and it is locked exclusively while attached, so an
+// attach that finds it locked by another instance (or unit) fails.
+
+#define DSK_COW_CHUNK  ((36 * 64) / 8)
+#define DSK_COW_HDR    512
+#define DSK_COW_MAGIC  "DPS8M COW 1"
+
+static uint64 cowBitmapBytes (uint64 chunks)
+  {
+    return (chunks + 7) / 8;
+  }
+
+static t_offset cowDataOffset (uint64 chunks)
+  {
+    return (t_offset) (((DSK_COW_HDR + cowBitmapBytes (chunks) + 4095) / 4096) * 4096);
+  }
+
+static bool cowTest (struct dsk_state * disk_statep, uint64 chunk)
+  {
+    return (disk_statep->cowBitmap[chunk / 8] >> (chunk % 8)) & 1;
+  }
+
+// Empty the open overlay file and write a header and a clear bitmap sized
+// for the largest drive type. The caller closes fp on failure.
+
+static t_stat cowInit (struct dsk_state * disk_statep, FILE * fp)
+  {
+    uint64 chunks = 0;
+    for (uint i = 0; i < N_DISK_TYPES; i ++)
+      {
+        uint64 n = (uint64) tAndDCapac[i] * ((36 * diskTypes[i].sectorSizeWords) / 8) / DSK_COW_CHUNK;
+        if (n > chunks)
+          chunks = n;
+      }
+
+    uint8 * bitmap = calloc ((size_t) cowBitmapBytes (chunks), 1);
+    if (! bitmap)
+      return SCPE_MEM;
+    char hdr[DSK_COW_HDR];
+    (void)memset (hdr, 0, sizeof (hdr));
+    (void)snprintf (hdr, sizeof (hdr), "%s %llu\n", DSK_COW_MAGIC, (unsigned long long) chunks);
+    if (fflush (fp) ||
+        ftruncate (fileno (fp), 0) ||
+        sim_fseeko (fp, 0, SEEK_SET) ||
+        fwrite (hdr, sizeof (hdr), 1, fp) != 1 ||
+        fwrite (bitmap, (size_t) cowBitmapBytes (chunks), 1, fp) != 1 ||
+        fflush (fp))
+      {
+        sim_warn ("%s: unable to write overlay '%s', errno %d\r\n",
+                  __func__, disk_statep->cowPath, errno);
+        FREE (bitmap);
+        return SCPE_IOERR;
+      }
+    disk_statep->cowFile   = fp;
+    disk_statep->cowBitmap = bitmap;
+    disk_statep->cowChunks = chunks;
+    return SCPE_OK;
+  }
+
+// Open (creating it if need be) and lock the overlay file.
+
+static t_stat cowFopen (const char * path, FILE ** fpp)
+  {
+#if defined(DISK_COW_LOCK)
+    int fd = open (path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0)
+      {
+        sim_warn ("%s: unable to open overlay '%s', errno %d\r\n", __func__, path, errno);
+        return SCPE_OPENERR;
+      }
+    // flock, unlike fcntl locks, also keeps a second unit of this
+    // instance off the file.
+    if (flock (fd, LOCK_EX | LOCK_NB))
+      {
+        sim_warn ("%s: overlay '%s' is in use\r\n", __func__, path);
+        (void)close (fd);
+        return SCPE_OPENERR;
+      }
+    * fpp = fdopen (fd, "r+b");
+    if (! * fpp)
+      {
+        (void)close (fd);
+        return SCPE_OPENERR;
+      }
+#else
+    * fpp = sim_fopen (path, "r+b");
+    if (! * fpp)
+      * fpp = sim_fopen (path, "w+b");
+    if (! * fpp)
+      {
+        sim_warn ("%s: unable to open overlay '%s', errno %d\r\n", __func__, path, errno);
+        return SCPE_OPENERR;
+      }
+#endif /* if defined(DISK_COW_LOCK) */
+    return SCPE_OK;
+  }
+
+// Open the unit's overlay, initializing it if it is new (empty).
+
+static t_stat cowOpen (uint dsk_unit_idx)
+  {
+    struct dsk_state * disk_statep = & dsk_states[dsk_unit_idx];
+
+    if (! disk_statep->cowPath[0])
+      {
+        sim_warn ("%s: attach -o needs an overlay file; SET DISK%u OVERLAY=<path>\r\n",
+                  __func__, dsk_unit_idx);
+        return SCPE_ARG;
+      }
+
+    FILE * fp;
+    t_stat stat = cowFopen (disk_statep->cowPath, & fp);
+    if (stat != SCPE_OK)
+      return stat;
+
+    if (sim_fseeko (fp, 0, SEEK_END) == 0 && sim_ftell (fp) == 0)
+      {
+        stat = cowInit (disk_statep, fp);
+        if (stat != SCPE_OK)
+          (void)fclose (fp);
+        return stat;
+      }
+    (void)sim_fseeko (fp, 0, SEEK_SET);
+
+    char hdr[DSK_COW_HDR + 1];
+    (void)memset (hdr, 0, sizeof (hdr));
+    unsigned long long chunks = 0;
+    if (fread (hdr, DSK_COW_HDR, 1, fp) != 1 ||
+        strncmp (hdr, DSK_COW_MAGIC " ", strlen (DSK_COW_MAGIC) + 1) != 0 ||
+        sscanf (hdr + strlen (DSK_COW_MAGIC), "%llu", & chunks) != 1 ||
+        chunks == 0)
+      {
+        sim_warn ("%s: '%s' is not a disk overlay\r\n", __func__, disk_statep->cowPath);
+        (void)fclose (fp);
+        return SCPE_FMT;
+      }
+    uint8 * bitmap = malloc ((size_t) cowBitmapBytes (chunks));
+    if (! bitmap)
+      {
+        (void)fclose (fp);
+        return SCPE_MEM;
+      }
+    if (fread (bitmap, (size_t) cowBitmapBytes (chunks), 1, fp) != 1)
+      {
+        sim_warn ("%s: overlay '%s' is truncated\r\n", __func__, disk_statep->cowPath);
+        FREE (bitmap);
+        (void)fclose (fp);
+        return SCPE_FMT;
+      }
+    disk_statep->cowFile   = fp;
+    disk_statep->cowBitmap = bitmap;
+    disk_statep->cowChunks = (uint64) chunks;
+    return SCPE_OK;
+  }
+
+static void cowClose (uint dsk_unit_idx)
+  {
+    struct dsk_state * disk_statep = & dsk_states[dsk_unit_idx];
+    if (! disk_statep->cowFile)
+      return;
+    (void)fclose (disk_statep->cowFile);
+    FREE (disk_statep->cowBitmap);
+    disk_statep->cowFile   = NULL;
+    disk_statep->cowChunks = 0;
+  }
+
+// Replace the image data read from the base with any chunks present in the
+// overlay; offset and nBytes are multiples of DSK_COW_CHUNK.
+
+static int cowRead (struct dsk_state * disk_statep, uint64 offset, uint8 * buf, uint64 nBytes)
+  {
+    uint64 first = offset / DSK_COW_CHUNK;
+    uint64 last  = (offset + nBytes) / DSK_COW_CHUNK;
+    if (last > disk_statep->cowChunks)
+      last = disk_statep->cowChunks;
+    t_offset dataOffset = cowDataOffset (disk_statep->cowChunks);
+
+    for (uint64 chunk = first; chunk < last; chunk ++)
+      {
+        if (! cowTest (disk_statep, chunk))
+          continue;
+        uint64 run = chunk;
+        while (run < last && cowTest (disk_statep, run))
+          run ++;
+        size_t len = (size_t) ((run - chunk) * DSK_COW_CHUNK);
+        if (sim_fseeko (disk_statep->cowFile, dataOffset + (t_offset) (chunk * DSK_COW_CHUNK), SEEK_SET) ||
+            fread (buf + (chunk - first) * DSK_COW_CHUNK, len, 1, disk_statep->cowFile) != 1)
+          {
+            sim_warn ("%s: overlay read failed, errno %d\r\n", __func__, errno);
+            return -1;
+          }
+        chunk = run;
+      }
+    return 0;
+  }
+
+// Write sectors to the overlay and mark them present. The data is flushed
+// before the bitmap so that a crash never exposes chunks that were not
+// written.
+
+static int cowWrite (struct dsk_state * disk_statep, uint64 offset, uint8 * buf, uint64 nBytes)
+  {
+    uint64 first = offset / DSK_COW_CHUNK;
+    uint64 last  = (offset + nBytes) / DSK_COW_CHUNK;
+    if (last > disk_statep->cowChunks)
+      {
+        sim_warn ("%s: write beyond the end of the overlay\r\n", __func__);
+        return -1;
+      }
+    FILE * fp = disk_statep->cowFile;
+    if (sim_fseeko (fp, cowDataOffset (disk_statep->cowChunks) + (t_offset) offset, SEEK_SET) ||
+        fwrite (buf, (size_t) nBytes, 1, fp) != 1 ||
+        fflush (fp))
+      {
+        sim_warn ("%s: overlay write failed, errno %d\r\n", __func__, errno);
+        return -1;
+      }
+
+    for (uint64 chunk = first; chunk < last; chunk ++)
+      disk_statep->cowBitmap[chunk / 8] |= (uint8) (1u << (chunk % 8));
+    uint64 firstByte = first / 8;
+    uint64 lastByte  = (last - 1) / 8;
+    if (sim_fseeko (fp, (t_offset) (DSK_COW_HDR + firstByte), SEEK_SET) ||
+        fwrite (disk_statep->cowBitmap + firstByte, (size_t) (lastByte - firstByte + 1), 1, fp) != 1 ||
+        fflush (fp))
+      {
+        sim_warn ("%s: overlay bitmap write failed, errno %d\r\n", __func__, errno);
+        return -1;
+      }
+    return 0;
+  }
+
+static uint64 cowDirty (struct dsk_state * disk_statep)
+  {
+    uint64 n = 0;
+    for (uint64 i = 0; i < cowBitmapBytes (disk_statep->cowChunks); i ++)
+      for (uint8 b = disk_statep->cowBitmap[i]; b; b &= (uint8) (b - 1))
+        n ++;
+    return n;
+  }
+
+// Copy every chunk in the overlay into the base image.
+
+static t_stat cowMerge (uint dsk_unit_idx)
+  {
+    UNIT * unitp                   = & dsk_unit[dsk_unit_idx];
+    struct dsk_state * disk_statep = & dsk_states[dsk_unit_idx];
+
+    FILE * base = sim_fopen (unitp->filename, "r+b");
+    if (! base)
+      {
+        sim_warn ("%s: unable to open '%s' for writing, errno %d\r\n",
+                  __func__, unitp->filename, errno);
+        return SCPE_OPENERR;
+      }
+    t_offset dataOffset = cowDataOffset (disk_statep->cowChunks);
+    uint8 buf[DSK_COW_CHUNK * 64];
+    t_stat stat = SCPE_OK;
+    for (uint64 chunk = 0; chunk < disk_statep->cowChunks && stat == SCPE_OK; chunk ++)
+      {
+        if (! cowTest (disk_statep, chunk))
+          continue;
+        uint64 run = chunk;
+        while (run < disk_statep->cowChunks && run - chunk < 64 && cowTest (disk_statep, run))
+          run ++;
+        size_t len = (size_t) ((run - chunk) * DSK_COW_CHUNK);
+        if (sim_fseeko (disk_statep->cowFile, dataOffset + (t_offset) (chunk * DSK_COW_CHUNK), SEEK_SET) ||
+            fread (buf, len, 1, disk_statep->cowFile) != 1 ||
+            sim_fseeko (base, (t_offset) (chunk * DSK_COW_CHUNK), SEEK_SET) ||
+            fwrite (buf, len, 1, base) != 1)
+          {
+            sim_warn ("%s: merge failed, errno %d\r\n", __func__, errno);
+            stat = SCPE_IOERR;
+          }
+        chunk = run - 1;
+      }
+    if (fclose (base) && stat == SCPE_OK)
+      stat = SCPE_IOERR;
+    return stat;
+  }
+
+// Empty the overlay, returning the unit to the contents of the base image.
+
+static t_stat cowReset (uint dsk_unit_idx)
+  {
+    struct dsk_state * disk_statep = & dsk_states[dsk_unit_idx];
+    // Keep the file, and its lock, open across the reset
+    FILE * fp = disk_statep->cowFile;
+    FREE (disk_statep->cowBitmap);
+    disk_statep->cowFile   = NULL;
+    disk_statep->cowChunks = 0;
+    t_stat stat = cowInit (disk_statep, fp);
+    if (stat != SCPE_OK)
+      (void)fclose (fp);
+    return stat;
+  }
+
+static t_stat disk_show_overlay (FILE * st, UNIT * uptr, UNUSED int val,
+                                 UNUSED const void * desc)
+  {
+    long disk_unit_idx = DSK_UNIT_IDX (uptr);
+    if (disk_unit_idx >= (long) dsk_dev.numunits)
       return SCPE_ARG;
-    }
+    struct dsk_state * disk_statep = & dsk_states[disk_unit_idx];
+    if (disk_statep->cowFile)
+      fprintf (st, "overlay=%s, %llu 64-word blocks modified",
+               disk_statep->cowPath, (unsigned long long) cowDirty (disk_statep));
+    else if (disk_statep->cowPath[0])
+      fprintf (st, "overlay=%s (inactive)", disk_statep->cowPath);
+    else
+      fprintf (st, "no overlay");
+    return SCPE_OK;
+  }
+
+static t_stat disk_set_overlay (UNIT * uptr, UNUSED int32 value,
+                                const char * cptr, UNUSED void * desc)
+  {
+    long disk_unit_idx = DSK_UNIT_IDX (uptr);
+    if (disk_unit_idx >= (long) dsk_dev.numunits)
+      return SCPE_ARG;
+    struct dsk_state * disk_statep = & dsk_states[disk_unit_idx];
+    if (disk_statep->cowFile)
+      {
+        sim_warn ("%s: overlay is in use; detach first\r\n", __func__);
+        return SCPE_ALATT;
+      }
+    if (! cptr)
+      {
+        disk_statep->cowPath[0] = 0;
+        return SCPE_OK;
+      }
+    if (strlen (cptr) >= sizeof (disk_statep->cowPath))
+      return SCPE_ARG;
+    (void)strcpy (disk_statep->cowPath, cptr);
+    return SCPE_OK;
+  }
+
+// SET DISKn MERGE / DISCARD; value 1 merges first.
+
+static t_stat disk_set_cow_done (UNIT * uptr, int32 value,
+                                 UNUSED const char * cptr, UNUSED void * desc)
+  {
+    long disk_unit_idx = DSK_UNIT_IDX (uptr);
+    if (disk_unit_idx >= (long) dsk_dev.numunits)
+      return SCPE_ARG;
+    struct dsk_state * disk_statep = & dsk_states[disk_unit_idx];
+    if (! disk_statep->cowFile)
+      {
+        sim_warn ("%s: unit has no active overlay\r\n", __func__);
+        return SCPE_UNATT;
+      }
+#if defined(LOCKLESS)
+    lock_ptr (& disk_statep->dsk_lock);
+#endif /* if defined(LOCKLESS) */
+    t_stat stat = SCPE_OK;
+    if (value)
+      stat = cowMerge ((uint) disk_unit_idx);
+    if (stat == SCPE_OK)
+      stat = cowReset ((uint) disk_unit_idx);
+#if defined(LOCKLESS)
+    unlock_ptr (& disk_statep->dsk_lock);
+#endif /* if defined(LOCKLESS) */
+    return stat;
+  }
+
+t_stat unloadDisk (uint dsk_unit_idx) {
+  // Keep channel programs off the image while it is taken away
+  LOCK_DISK (dsk_unit_idx);
+#if defined(DISK_MMAP)
+  diskUnmap (dsk_unit_idx);
+  dsk_states[dsk_unit_idx].mapRequested = false;
+#endif /* if defined(DISK_MMAP) */
+  cowClose (dsk_unit_idx);
+  t_stat stat = SCPE_OK;
+  if (dsk_unit [dsk_unit_idx] . flags & UNIT_ATT)
+    stat = sim_disk_detach (& dsk_unit [dsk_unit_idx]);
+  UNLOCK_DISK (dsk_unit_idx);
+  if (stat != SCPE_OK) {
+    sim_warn ("%s: sim_disk_detach returned %ld\r\n", __func__, (long) stat);
+    return SCPE_ARG;
   }
   return signal_disk_ready ((uint) dsk_unit_idx);
 }
 
 t_stat loadDisk (uint dsk_unit_idx, const char * disk_filename, bool ro) {
+  // Keep channel programs off the image until it is fully set up
+  LOCK_DISK (dsk_unit_idx);
   if (ro)
     dsk_unit[dsk_unit_idx].flags |= MTUF_WRP;
   else
     dsk_unit[dsk_unit_idx].flags &= ~ MTUF_WRP;
+#if defined(DISK_MMAP)
+  diskUnmap (dsk_unit_idx);
+  // -m applies only to the attach that asked for it, not to later LOADs
+  bool mapRequested = dsk_states[dsk_unit_idx].mapRequested;
+  dsk_states[dsk_unit_idx].mapRequested = false;
+#endif /* if defined(DISK_MMAP) */
+  cowClose (dsk_unit_idx);
+  // Like -m, -o applies only to the attach that asked for it; an overlay
+  // must not be laid over a different image loaded later.
+  bool cowRequested = dsk_states[dsk_unit_idx].cowRequested;
+  dsk_states[dsk_unit_idx].cowRequested = false;
+  // With an overlay the base image is never written
+  int32 saved_switches = sim_switches;
+  if (cowRequested)
+    sim_switches |= SWMASK ('R');
   t_stat stat = attach_unit (& dsk_unit [dsk_unit_idx], disk_filename);
+  sim_switches = saved_switches;
   if (stat != SCPE_OK) {
     sim_printf ("%s: sim_disk_attach returned %d\r\n", __func__, stat);
-    return stat;
+  } else if (cowRequested) {
+    stat = cowOpen (dsk_unit_idx);
+    if (stat != SCPE_OK)
+      (void)detach_unit (& dsk_unit [dsk_unit_idx]);
+  }
+#if defined(DISK_MMAP)
+  if (stat == SCPE_OK && mapRequested) {
+    if (dsk_states[dsk_unit_idx].cowFile)
+      sim_warn ("%s: -m is ignored for an image with an overlay\r\n", __func__);
+    else
+      diskMap (dsk_unit_idx);
   }
+#endif /* if defined(DISK_MMAP) */
+  UNLOCK_DISK (dsk_unit_idx);
+  if (stat != SCPE_OK)
+    return stat;
   return signal_disk_ready ((uint) dsk_unit_idx);
 }
 
@@ -584,6 +1286,30 @@ static MTAB disk_mod[] =
       "Number of DISK units in the system",             /* Value descriptor   */
       NULL                                              /* Help               */
     },
+#if defined(LOCKLESS)
+    {
+      MTAB_dev_value,                                   /* Mask               */
+      0,                                                /* Match              */
+      "ASYNC",                                          /* Print string       */
+      "ASYNC",                                          /* Match string       */
+      disk_set_async,                                   /* Validation routine */
+      disk_show_async,                                  /* Display routine    */
+      "Number of asynchronous DISK I/O threads",        /* Value descriptor   */
+      NULL                                              /* Help               */
+    },
+#endif /* if defined(LOCKLESS) */
+#if defined(DISK_MMAP)
+    {
+      MTAB_dev_value,                                   /* Mask               */
+      0,                                                /* Match              */
+      "MSYNC",                                          /* Print string       */
+      "MSYNC",                                          /* Match string       */
+      disk_set_msync,                                   /* Validation routine */
+      disk_show_msync,                                  /* Display routine    */
+      "Seconds between syncs of mapped images",         /* Value descriptor   */
+      NULL                                              /* Help               */
+    },
+#endif /* if defined(DISK_MMAP) */
     {
       MTAB_unit_value_show,                             /* Mask               */
       0,                                                /* Match              */
@@ -614,6 +1340,36 @@ static MTAB disk_mod[] =
       NULL,                                             /* Value descriptor   */
       NULL                                              /* Help string        */
     },
+    {
+      MTAB_XTD | MTAB_VUN | MTAB_VALO | MTAB_NC,        /* Mask               */
+      0,                                                /* Match              */
+      "OVERLAY",                                        /* Print string       */
+      "OVERLAY",                                        /* Match string       */
+      disk_set_overlay,                                 /* Validation routine */
+      disk_show_overlay,                                /* Display routine    */
+      "Copy-on-write overlay file for attach -o",       /* Value descriptor   */
+      NULL                                              /* Help               */
+    },
+    {
+      MTAB_XTD | MTAB_VUN | MTAB_NMO,                   /* Mask               */
+      1,                                                /* Match              */
+      "MERGE",                                          /* Print string       */
+      "MERGE",                                          /* Match string       */
+      disk_set_cow_done,                                /* Validation routine */
+      NULL,                                             /* Display routine    */
+      NULL,                                             /* Value descriptor   */
+      "Merge the overlay into the base image"           /* Help               */
+    },
+    {
+      MTAB_XTD | MTAB_VUN | MTAB_NMO,                   /* Mask               */
+      0,                                                /* Match              */
+      "DISCARD",                                        /* Print string       */
+      "DISCARD",                                        /* Match string       */
+      disk_set_cow_done,                                /* Validation routine */
+      NULL,                                             /* Display routine    */
+      NULL,                                             /* Value descriptor   */
+      "Discard the contents of the overlay"             /* Help               */
+    },
     MTAB_eol
   };
 
@@ -631,9 +1387,34 @@ static t_stat disk_attach (UNIT *uptr, CONST char *cptr)
         return SCPE_ARG;
       }
 
+    dsk_states[diskUnitIdx].cowRequested = (sim_switches & SWMASK ('O')) != 0;
+#if defined(DISK_MMAP)
+    dsk_states[diskUnitIdx].mapRequested = (sim_switches & SWMASK ('M')) != 0;
+#else
+    if (sim_switches & SWMASK ('M'))
+      sim_warn ("%s: -m is not supported on this host\r\n", __func__);
+#endif /* if defined(DISK_MMAP) */
     return loadDisk ((uint) diskUnitIdx, cptr, false);
   }
 
+static t_stat disk_detach (UNIT *uptr)
+  {
+    int diskUnitIdx = (int) DSK_UNIT_IDX (uptr);
+    if (diskUnitIdx < 0 || diskUnitIdx >= N_DSK_UNITS_MAX)
+      return detach_unit (uptr);
+    // The overlay is freed and its pointers cleared before a channel
+    // program can look at them again
+    LOCK_DISK (diskUnitIdx);
+#if defined(DISK_MMAP)
+    diskUnmap ((uint) diskUnitIdx);
+    dsk_states[diskUnitIdx].mapRequested = false;
+#endif /* if defined(DISK_MMAP) */
+    cowClose ((uint) diskUnitIdx);
+    t_stat stat = detach_unit (uptr);
+    UNLOCK_DISK (diskUnitIdx);
+    return stat;
+  }
+
 // No disks known to Multics had more than 2^24 sectors...
 DEVICE dsk_dev = {
     "DISK",                /* Name                */
@@ -651,7 +1432,7 @@ DEVICE dsk_dev = {
     disk_reset,            /* Reset               */
     NULL,                  /* Boot                */
     disk_attach,           /* Attach              */
-    NULL /*disk_detach*/,  /* Detach              */
+    disk_detach,           /* Detach              */
     NULL,                  /* Context             */
     DEV_DEBUG,             /* Flags               */
     0,                     /* Debug control flags */
@@ -689,6 +1470,10 @@ void disk_init (void)
         pthread_mutex_init (& dsk_states[i].dsk_lock, NULL);
 # endif /* if defined(__FreeBSD__) */
       }
+    (void)memset (& dsk_async, 0, sizeof (dsk_async));
+    pthread_mutex_init (& dsk_async.lock, NULL);
+    pthread_cond_init (& dsk_async.cond, NULL);
+    pthread_cond_init (& dsk_async.space, NULL);
 #endif /* if defined(LOCKLESS) */
   }
 
@@ -867,20 +1652,6 @@ if (chan == 014)
         tally = 4096;
       }
 
-    int rc = fseek (unitp->fileref,
-                (long) ((long)disk_statep->seekPosition * (long)sectorSizeBytes),
-                SEEK_SET);
-    if (rc)
-      {
-        sim_warn ("%s: fseek (read) returned %d, errno %d\r\n", __func__, rc, errno);
-        p->stati = 04202; // attn, seek incomplete
-#if defined(POLTS_TESTING)
-if (chan == 014)
-    if_sim_debug (DBG_TRACE, & dsk_dev) sim_printf ("// diskRead seek incomplete\r\n");
-#endif
-        return -1;
-      }
-
     // Convert from word36 format to packed72 format
 
     // round tally up to sector boundary
@@ -893,40 +1664,72 @@ if (chan == 014)
     //uint tallyBytes = tallySectors * sectorSizeBytes;
     uint p72ByteCnt   = (tallyWords * 36) / 8;
     uint8 diskBuffer[p72ByteCnt];
-    (void)memset (diskBuffer, 0, sizeof (diskBuffer));
+    uint8 * p72       = diskBuffer;
 
-    (void)fflush (unitp->fileref);
-    rc = (int) fread (diskBuffer, sectorSizeBytes,
-                tallySectors,
-                unitp->fileref);
-
-    if (rc == 0) // EOF or error
+#if defined(DISK_MMAP)
+    uint64 offset = (uint64) disk_statep->seekPosition * sectorSizeBytes;
+    if (diskMapped (disk_statep, offset, p72ByteCnt))
       {
-        if (ferror (unitp->fileref))
+        p72 = disk_statep->map + offset;
+      }
+    else
+#endif /* if defined(DISK_MMAP) */
+      {
+        int rc = fseek (unitp->fileref,
+                    (long) ((long)disk_statep->seekPosition * (long)sectorSizeBytes),
+                    SEEK_SET);
+        if (rc)
           {
+            sim_warn ("%s: fseek (read) returned %d, errno %d\r\n", __func__, rc, errno);
             p->stati = 04202; // attn, seek incomplete
-            //p->chanStatus = chanStatIncorrectDCW;
+#if defined(POLTS_TESTING)
+if (chan == 014)
+    if_sim_debug (DBG_TRACE, & dsk_dev) sim_printf ("// diskRead seek incomplete\r\n");
+#endif
+            return -1;
+          }
+
+        (void)memset (diskBuffer, 0, sizeof (diskBuffer));
+
+        (void)fflush (unitp->fileref);
+        rc = (int) fread (diskBuffer, sectorSizeBytes,
+                    tallySectors,
+                    unitp->fileref);
+
+        if (rc == 0) // EOF or error
+          {
+            if (ferror (unitp->fileref))
+              {
+                p->stati = 04202; // attn, seek incomplete
+                //p->chanStatus = chanStatIncorrectDCW;
 #if defined(POLTS_TESTING)
 if (chan == 014)
     if_sim_debug (DBG_TRACE, & dsk_dev) sim_printf ("// diskRead seek incomplete2\r\n");
 #endif
+                return -1;
+              }
+            // We ignore short reads-- we assume that they are reads
+            // past the write highwater mark, and return zero data,
+            // just as if the disk had been formatted with zeros.
+          }
+
+        if (disk_statep->cowFile &&
+            cowRead (disk_statep,
+                     (uint64) disk_statep->seekPosition * sectorSizeBytes,
+                     diskBuffer, p72ByteCnt))
+          {
+            p->stati = 04202; // attn, seek incomplete
             return -1;
           }
-        // We ignore short reads-- we assume that they are reads
-        // past the write highwater mark, and return zero data,
-        // just as if the disk had been formatted with zeros.
       }
     disk_statep->seekPosition += tallySectors;
 
     uint wordsProcessed = 0;
     word36 buffer[tally];
-    for (uint i = 0; i < tally; i ++)
-      {
-        word36 w;
-        extractWord36FromBuffer (diskBuffer, p72ByteCnt, & wordsProcessed,
-                                 & w);
-        buffer[i] = w;
-      }
+    uint n = extractWord36BlockFromBuffer (p72, p72ByteCnt, & wordsProcessed,
+                                           buffer, tally);
+    if (n < tally)
+      (void)memset (buffer + n, 0, (tally - n) * sizeof (word36));
     iom_indirect_data_service (iomUnitIdx, chan, buffer,
                             & wordsProcessed, true);
     p->stati = 04000;
@@ -964,16 +1767,6 @@ static int diskWrite (uint devUnitIdx, uint iomUnitIdx, uint chan)
         tally = 4096;
       }
 
-    int rc = fseek (unitp->fileref,
-                (long) ((long)disk_statep->seekPosition * (long)sectorSizeBytes),
-                SEEK_SET);
-    if (rc)
-      {
-        sim_printf ("fseek (read) returned %d, errno %d\r\n", rc, errno);
-        p->stati = 04202; // attn, seek incomplete
-        return -1;
-      }
-
     // Convert from word36 format to packed72 format
 
     // round tally up to sector boundary
@@ -985,30 +1778,79 @@ static int diskWrite (uint devUnitIdx, uint iomUnitIdx, uint chan)
     uint tallyWords   = tallySectors * sectorSizeWords;
     uint p72ByteCnt   = (tallyWords * 36) / 8;
     uint8 diskBuffer[p72ByteCnt];
-    (void)memset (diskBuffer, 0, sizeof (diskBuffer));
+
+#if defined(DISK_MMAP)
+    uint64 offset = (uint64) disk_statep->seekPosition * sectorSizeBytes;
+    bool mapped   = diskMapped (disk_statep, offset, p72ByteCnt);
+    if (mapped)
+      {
+        if (! disk_statep->mapWritable)
+          {
+            sim_printf ("%s: image is mapped read-only\r\n", __func__);
+            p->stati      = 04202; // attn, seek incomplete
+            p->chanStatus = chanStatIncorrectDCW;
+            return -1;
+          }
+      }
+    else
+#endif /* if defined(DISK_MMAP) */
+      {
+        int rc = fseek (unitp->fileref,
+                    (long) ((long)disk_statep->seekPosition * (long)sectorSizeBytes),
+                    SEEK_SET);
+        if (rc)
+          {
+            sim_printf ("fseek (read) returned %d, errno %d\r\n", rc, errno);
+            p->stati = 04202; // attn, seek incomplete
+            return -1;
+          }
+      }
+
+    (void)memset (diskBuffer, 0, p72ByteCnt);
     uint wordsProcessed = 0;
 
     word36 buffer[tally];
     iom_indirect_data_service (iomUnitIdx, chan, buffer,
                             & wordsProcessed, false);
     wordsProcessed = 0;
-    for (uint i = 0; i < tally; i ++)
+    (void)insertWord36BlockToBuffer (diskBuffer, p72ByteCnt, & wordsProcessed,
+                                     buffer, tally);
+
+#if defined(DISK_MMAP)
+    if (mapped)
       {
-        insertWord36toBuffer (diskBuffer, p72ByteCnt, & wordsProcessed,
-                              buffer[i]);
+        // The sectors are padded in diskBuffer and stored with one copy;
+        // a reader of the mapping never sees them zeroed ahead of the data
+        (void)memcpy (disk_statep->map + offset, diskBuffer, p72ByteCnt);
+        diskSync (disk_statep, offset, p72ByteCnt);
       }
-
-    rc = (int) fwrite (diskBuffer, sectorSizeBytes,
-                 tallySectors,
-                 unitp->fileref);
-    (void)fflush (unitp->fileref);
-
-    if (rc != (int) tallySectors)
+    else
+#endif /* if defined(DISK_MMAP) */
+    if (disk_statep->cowFile)
       {
-        sim_printf ("fwrite returned %d, errno %d\r\n", rc, errno);
-        p->stati      = 04202; // attn, seek incomplete
-        p->chanStatus = chanStatIncorrectDCW;
-        return -1;
+        if (cowWrite (disk_statep,
+                      (uint64) disk_statep->seekPosition * sectorSizeBytes,
+                      diskBuffer, p72ByteCnt))
+          {
+            p->stati      = 04202; // attn, seek incomplete
+            p->chanStatus = chanStatIncorrectDCW;
+            return -1;
+          }
+      }
+    else
+      {
+        int rc = (int) fwrite (diskBuffer, sectorSizeBytes,
+                     tallySectors,
+                     unitp->fileref);
+        (void)fflush (unitp->fileref);
+
+        if (rc != (int) tallySectors)
+          {
+            sim_printf ("fwrite returned %d, errno %d\r\n", rc, errno);
+            p->stati      = 04202; // attn, seek incomplete
+            p->chanStatus = chanStatIncorrectDCW;
+            return -1;
+          }
       }
 
     disk_statep->seekPosition += tallySectors;
@@ -1230,7 +2072,7 @@ if (chan == 014)   {if_sim_debug (DBG_TRACE, & dsk_dev) { dumpDCW (p->DCW, 0); }
   iom_cmd_rc_t rc = IOM_CMD_PROCEED;
 
 #if defined(LOCKLESS)
-  lock_ptr (& dsk_states->dsk_lock); //-V619
+  lock_ptr (& disk_statep->dsk_lock);
 #endif
 
   // IDCW?
@@ -1397,7 +2239,7 @@ if (chan == 014)
         if (p->IDCW_DEV_CODE == 077) {
           p->stati = 04502; // invalid device code
 #if defined(LOCKLESS)
-          unlock_ptr (& dsk_states->dsk_lock); //-V619
+          unlock_ptr (& disk_statep->dsk_lock);
 #endif
           return IOM_CMD_DISCONNECT;
         }
@@ -1614,7 +2456,7 @@ if (chan == 014)
 
 done:
 #if defined(LOCKLESS)
-  unlock_ptr (& dsk_states->dsk_lock); //-V619
+  unlock_ptr (& disk_statep->dsk_lock);
 #endif
   return rc;
 }
@@ -38,6 +38,16 @@ struct dsk_state
     bool seekValid; // True if seekPosition contains a valid seek address.
     uint seekPosition;
     char device_name [MAX_DEV_NAME_LEN];
+    bool mapRequested;  // attach -m
+    bool mapWritable;
+    uint8 * map;        // Image mapped into memory, or NULL
+    size_t mapSize;
+    time_t mapSyncTime; // When the mapping was last msync'd
+    bool cowRequested;  // attach -o
+    char cowPath [PATH_MAX + 1]; // Overlay (delta) file name
+    FILE * cowFile;     // Open overlay, or NULL
+    uint8 * cowBitmap;  // One bit per chunk present in the overlay
+    uint64 cowChunks;   // Number of chunks the overlay can hold
 #if defined(LOCKLESS)
     pthread_mutex_t dsk_lock;
 #endif
@@ -81,3 +91,6 @@ iom_cmd_rc_t dsk_iom_cmd (uint iomUnitIdx, uint chan);
 t_stat loadDisk (uint dsk_unit_idx, const char * disk_filename, bool ro);
 t_stat unloadDisk (uint dsk_unit_idx);
 t_stat signal_disk_ready (uint dsk_unit_idx);
+#if defined(LOCKLESS)
+bool dsk_async_connect (uint iomUnitIdx, uint chan);
+#endif
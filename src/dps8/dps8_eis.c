@@ -122,6 +122,7 @@
 //  EISReadN (p, n, dst) -- read N words to dst;
 
 //  EISget469 (cpup, k, i)
+//  EISgetWord469 (cpup, k, i, *residue, *nPos) -- read the word holding char i
 //  EISput469 (cpup, k, i, c)
 
 //  EISget49 (cpup, k, *pos, tn) get p->addr[*pos++]
@@ -902,11 +903,132 @@ if (eisaddr_idx < 0 || eisaddr_idx > 2) { sim_warn ("IDX1"); return }
     cpu.TPR.TRR = saveTRR;
   }
 
-static word9 EISget469 (cpu_state_t * cpup, int k, uint i)
+static void EISWrite8 (cpu_state_t * cpup, EISaddr * p, uint n, word36 * data)
+  {
+#if defined(EIS_PTR)
+    long eisaddr_idx = EISADDR_IDX (p);
+if (eisaddr_idx < 0 || eisaddr_idx > 2) { sim_warn ("IDX1"); return }
+    word18 addressN = (cpu.du.Dk_PTR_W[eisaddr_idx] + n) & AMASK;
+#else
+    word18 addressN = p -> address + n;
+#endif
+    addressN &= AMASK;
+
+    sim_debug (DBG_TRACEEXT, & cpu_dev, "%s addr %06o\r\n", __func__, addressN);
+    if ((addressN & paragraphOffsetMask) != 0)
+      {
+        sim_warn ("EISWrite8 not aligned %06o\r\n", addressN);
+        addressN &= paragraphMask;
+      }
+
+    word3 saveTRR = cpu.TPR.TRR;
+
+    if (p -> mat == viaPR)
+      {
+        cpu.TPR.TRR = p -> RNR;
+        cpu.TPR.TSR = p -> SNR;
+        cpu.cu.XSF = 0;
+        Write8 (cpup, addressN, data, true);
+      }
+    else
+      {
+        cpu.TPR.TRR = cpu.PPR.PRR;
+        cpu.TPR.TSR = cpu.PPR.PSR;
+        cpu.cu.XSF = 0;
+        Write8 (cpup, addressN, data, false);
+      }
+    cpu.TPR.TRR = saveTRR;
+  }
+
+//
+// Move nWords whole words from operand 1 to operand 2 for the word aligned,
+// 9-bit MLR and MRL cases, advancing CHTALLY by 4 per word moved. MLR moves
+// from the first word up, MRL from the last word down.
+//
+// If the operands cannot overlap, destination pages and paragraphs that are
+// entirely covered are stored with a single append cycle each (the source is
+// gathered through the paragraph cache first); the edges, and all of an
+// overlapping move, are stored a word at a time as before. CHTALLY is only
+// advanced after a block is stored, so a fault during the gather or the store
+// restarts the block.
+//
+
+static void EISMoveWords (cpu_state_t * cpup, uint nWords, bool descending)
   {
     EISstruct * e = & cpu.currentEISinstruction;
+    EISaddr * src = & e -> ADDR1;
+    EISaddr * dst = & e -> ADDR2;
 
-    uint nPos = 4; // CTA9
+#if defined(EIS_PTR)
+    word18 srcBase = cpu.du.D1_PTR_W;
+    word18 dstBase = cpu.du.D2_PTR_W;
+#else
+    word18 srcBase = src -> address;
+    word18 dstBase = dst -> address;
+#endif
+
+    word15 srcSeg = src -> mat == viaPR ? src -> SNR : cpu.PPR.PSR;
+    word15 dstSeg = dst -> mat == viaPR ? dst -> SNR : cpu.PPR.PSR;
+    bool bulk = srcSeg != dstSeg ||
+                srcBase + nWords <= dstBase ||
+                dstBase + nWords <= srcBase;
+
+    while (cpu.du.CHTALLY < nWords * 4)
+      {
+        uint done = cpu.du.CHTALLY / 4;
+        uint left = nWords - done;
+        uint n    = descending ? nWords - done - 1 : done;
+        word18 dstAddr = (dstBase + n) & AMASK;
+
+        if (bulk && left >= PGSZ &&
+            (dstAddr & PGMK) == (descending ? PGMK : 0))
+          {
+            uint first = descending ? n - (PGSZ - 1) : n;
+            word36 pg [PGSZ];
+            if (((srcBase + first) & PGMK) == 0)
+              EISReadPage (cpup, src, first, pg);
+            else
+              for (uint i = 0; i < PGSZ; i ++)
+                pg [i] = EISReadIdx (cpup, src, first + i);
+            if (dst -> cacheValid && dst -> cacheDirty)
+              EISWriteCache (cpup, dst);
+            dst -> cacheValid = false;
+            EISWritePage (cpup, dst, first, pg);
+            cpu.du.CHTALLY += PGSZ * 4;
+          }
+        else if (bulk && left >= 8 &&
+                 (dstAddr & paragraphOffsetMask) ==
+                   (descending ? paragraphOffsetMask : 0))
+          {
+            uint first = descending ? n - 7 : n;
+            word36 para [8];
+            for (uint i = 0; i < 8; i ++)
+              para [i] = EISReadIdx (cpup, src, first + i);
+            if (dst -> cacheValid && dst -> cacheDirty)
+              EISWriteCache (cpup, dst);
+            dst -> cacheValid = false;
+            EISWrite8 (cpup, dst, first, para);
+            cpu.du.CHTALLY += 8 * 4;
+          }
+        else
+          {
+            word36 w = EISReadIdx (cpup, src, n);
+            EISWriteIdx (cpup, dst, n, w, true);
+            cpu.du.CHTALLY += 4;
+          }
+      }
+  }
+
+// Read the word holding character i of operand k, leaving the operand
+// address where EISget469 would; the position of the character within the
+// word and the number of characters per word are returned in *residue and
+// *nPos so that callers can walk a string a word at a time.
+
+static word36 EISgetWord469 (cpu_state_t * cpup, int k, uint i, uint * residue, uint * nPos)
+  {
+    EISstruct * e = & cpu.currentEISinstruction;
+
+    * nPos = 4; // CTA9
 #if defined(EIS_PTR3)
     switch (cpu.du.TAk[k-1])
 #else
@@ -914,19 +1036,19 @@ static word9 EISget469 (cpu_state_t * cpup, int k, uint i)
 #endif
       {
         case CTA4:
-            nPos = 8;
+            * nPos = 8;
             break;
 
         case CTA6:
-            nPos = 6;
+            * nPos = 6;
             break;
       }
 
     word18 address = e -> WN [k - 1];
     uint nChars = i + e -> CN [k - 1];
 
-    address += nChars / nPos;
-    uint residue = nChars % nPos;
+    address += nChars / * nPos;
+    * residue = nChars % * nPos;
 
     PNL (cpu.du.Dk_PTR_W[k-1] = address);
 #if defined(EIS_PTR)
@@ -934,36 +1056,83 @@ static word9 EISget469 (cpu_state_t * cpup, int k, uint i)
 #else
     e -> addr [k - 1].address = address;
 #endif
-    word36 data = EISRead (cpup, & e -> addr [k - 1]);    // read it from memory
+    return EISRead (cpup, & e -> addr [k - 1]);    // read it from memory
+  }
 
-    word9 c = 0;
-#if defined(EIS_PTR3)
-    switch (cpu.du.TAk[k-1])
-#else
-    switch (e -> TA [k - 1])
-#endif
+static word9 EISchar469 (uint TA, word36 data, uint residue)
+  {
+    switch (TA)
       {
         case CTA4:
-          c = (word9) get4 (data, (int) residue);
-          break;
+          return (word9) get4 (data, (int) residue);
 
         case CTA6:
-          c = (word9) get6 (data, (int) residue);
-          break;
+          return (word9) get6 (data, (int) residue);
 
         case CTA9:
-          c = get9 (data, (int) residue);
-          break;
+          return get9 (data, (int) residue);
       }
+    return 0;
+  }
+
+static word9 EISget469 (cpu_state_t * cpup, int k, uint i)
+  {
+    uint residue, nPos;
+    word36 data = EISgetWord469 (cpup, k, i, & residue, & nPos);
+
 #if defined(EIS_PTR3)
+    word9 c = EISchar469 (cpu.du.TAk[k-1], data, residue);
     sim_debug (DBG_TRACEEXT, & cpu_dev, "EISGet469 : k: %u TAk %u coffset %u c %o\r\n", k, cpu.du.TAk[k - 1], residue, c);
 #else
+    EISstruct * e = & cpu.currentEISinstruction;
+    word9 c = EISchar469 (e -> TA [k - 1], data, residue);
     sim_debug (DBG_TRACEEXT, & cpu_dev, "EISGet469 : k: %u TAk %u coffset %u c %o\r\n", k, e -> TA [k - 1], residue, c);
 #endif
 
     return c;
   }
 
+// Test all of the characters of a TA-type word against ctest at once,
+// ignoring the bits set in mask. The characters are treated as lanes of
+// a 36-bit vector (AL39, Figures 2-3, 2-4 and 2-5): the XOR leaves a lane
+// zero where the character matches, and adding the low bits of each lane
+// to itself carries into the lane's top bit iff any bit is set, without
+// spilling into the neighbouring lane. Returns false only if no lane can
+// match.
+
+static bool EISmatchWord469 (uint TA, word36 data, word9 ctest, uint mask)
+  {
+    word36 ones, top, lane;
+    switch (TA)
+      {
+        case CTA4:
+          // Two characters in the low 8 bits of each 9-bit byte
+          ones = 0021021021021;
+          top  = 0210210210210;
+          lane = 017;
+          break;
+
+        case CTA6:
+          ones = 0010101010101;
+          top  = 0404040404040;
+          lane = 077;
+          break;
+
+        case CTA9:
+          ones = 0001001001001;
+          top  = 0400400400400;
+          lane = 0777;
+          break;
+
+        default:
+          return true;
+      }
+    word36 low = (ones * lane) & ~top;
+    word36 x = (data ^ (ones * (ctest & lane))) & (ones * (~mask & lane));
+    word36 nonZero = (((x & low) + low) | x) & top;
+    return nonZero != top;
+  }
+
 static void EISput469 (cpu_state_t * cpup, int k, uint i, word9 c469)
   {
     EISstruct * e = & cpu.currentEISinstruction;
@@ -3278,17 +3447,44 @@ void scd (cpu_state_t * cpup)
     PNL (L68_ (if (e->N1 < 128)
       DU_CYCLE_FLEN_128;))
 
+#if defined(EIS_PTR3)
+    uint TA = TA1;
+#else
+    uint TA = e -> TA1;
+#endif
+
     word9 yCharn11;
     word9 yCharn12;
     if (e -> N1)
       {
         uint limit = e -> N1 - 1;
-        for ( ; cpu.du.CHTALLY < limit; cpu.du.CHTALLY ++)
+        // Walk the string a word at a time. A word holding no c1 cannot
+        // start a pair and is stepped over, provided the word holding the
+        // second character of its last pair is read next anyway.
+        bool found = false;
+        while (! found && cpu.du.CHTALLY < limit)
           {
-            yCharn11 = EISget469 (cpup, 1, cpu.du.CHTALLY);
-            yCharn12 = EISget469 (cpup, 1, cpu.du.CHTALLY + 1);
-            if (yCharn11 == c1 && yCharn12 == c2)
-              break;
+            uint residue, nPos;
+            word36 data = EISgetWord469 (cpup, 1, cpu.du.CHTALLY, & residue, & nPos);
+            if (residue == 0 && limit - cpu.du.CHTALLY > nPos &&
+                ! EISmatchWord469 (TA, data, c1, 0))
+              {
+                cpu.du.CHTALLY += nPos;
+                continue;
+              }
+            for ( ; residue < nPos && cpu.du.CHTALLY < limit; residue ++, cpu.du.CHTALLY ++)
+              {
+                yCharn11 = EISchar469 (TA, data, residue);
+                if (residue + 1 < nPos)
+                  yCharn12 = EISchar469 (TA, data, residue + 1);
+                else
+                  yCharn12 = EISget469 (cpup, 1, cpu.du.CHTALLY + 1);
+                if (yCharn11 == c1 && yCharn12 == c2)
+                  {
+                    found = true;
+                    break;
+                  }
+              }
           }
         SC_I_TALLY (cpu.du.CHTALLY == limit);
       }
@@ -3458,6 +3654,12 @@ void scdr (cpu_state_t * cpup)
           break;
       }
 
+#if defined(EIS_PTR3)
+    uint TA = TA1;
+#else
+    uint TA = e -> TA1;
+#endif
+
     word9 yCharn11;
     word9 yCharn12;
 
@@ -3468,13 +3670,41 @@ void scdr (cpu_state_t * cpup)
       {
         uint limit = e -> N1 - 1;
 
-        for ( ; cpu.du.CHTALLY < limit; cpu.du.CHTALLY ++)
+        // As scd, walking the words from the end of the string; the word
+        // holding the second character of a word's last pair has already
+        // been read unless this is the first pair tested.
+        bool found = false;
+        while (! found && cpu.du.CHTALLY < limit)
           {
-            yCharn11 = EISget469 (cpup, 1, limit - cpu.du.CHTALLY - 1);
-            yCharn12 = EISget469 (cpup, 1, limit - cpu.du.CHTALLY);
+            uint residue, nPos;
+            word36 data = EISgetWord469 (cpup, 1, limit - cpu.du.CHTALLY - 1, & residue, & nPos);
+            if (residue == nPos - 1 && cpu.du.CHTALLY > 0 &&
+                limit - cpu.du.CHTALLY >= nPos &&
+                ! EISmatchWord469 (TA, data, c1, 0))
+              {
+                cpu.du.CHTALLY += nPos;
+                continue;
+              }
+            for ( ; cpu.du.CHTALLY < limit; cpu.du.CHTALLY ++)
+              {
+                yCharn11 = EISchar469 (TA, data, residue);
+                if (residue + 1 < nPos)
+                  yCharn12 = EISchar469 (TA, data, residue + 1);
+                else
+                  yCharn12 = EISget469 (cpup, 1, limit - cpu.du.CHTALLY);
 
-            if (yCharn11 == c1 && yCharn12 == c2)
-                break;
+                if (yCharn11 == c1 && yCharn12 == c2)
+                  {
+                    found = true;
+                    break;
+                  }
+                if (residue == 0)
+                  {
+                    cpu.du.CHTALLY ++;
+                    break;
+                  }
+                residue --;
+              }
           }
         SC_I_TALLY (cpu.du.CHTALLY == limit);
       }
@@ -3637,16 +3867,38 @@ void scm (cpu_state_t * cpup)
 
     uint limit = e -> N1;
 
-    for ( ; cpu.du.CHTALLY < limit; cpu.du.CHTALLY ++)
+#if defined(EIS_PTR3)
+    uint TA = TA1;
+#else
+    uint TA = e -> TA1;
+#endif
+
+    // Walk the string a word at a time; whole words without a masked match
+    // are stepped over, and CHTALLY is only ever left at a word boundary or
+    // at the matching character, so that a fault restarts the scan cleanly.
+    bool found = false;
+    while (! found && cpu.du.CHTALLY < limit)
       {
-        word9 yCharn1 = EISget469 (cpup, 1, cpu.du.CHTALLY);
-        word9 c = ((~mask) & (yCharn1 ^ ctest)) & 0777;
-        if (c == 0)
+        uint residue, nPos;
+        word36 data = EISgetWord469 (cpup, 1, cpu.du.CHTALLY, & residue, & nPos);
+        if (residue == 0 && limit - cpu.du.CHTALLY >= nPos &&
+            ! EISmatchWord469 (TA, data, ctest, mask))
           {
-            //00...0 → C(Y3)0,11
-            //i-1 → C(Y3)12,35
-            //Y3 = bitfieldInsert36(Y3, cpu.du.CHTALLY, 0, 24);
-            break;
+            cpu.du.CHTALLY += nPos;
+            continue;
+          }
+        for ( ; residue < nPos && cpu.du.CHTALLY < limit; residue ++, cpu.du.CHTALLY ++)
+          {
+            word9 yCharn1 = EISchar469 (TA, data, residue);
+            word9 c = ((~mask) & (yCharn1 ^ ctest)) & 0777;
+            if (c == 0)
+              {
+                //00...0 → C(Y3)0,11
+                //i-1 → C(Y3)12,35
+                //Y3 = bitfieldInsert36(Y3, cpu.du.CHTALLY, 0, 24);
+                found = true;
+                break;
+              }
           }
       }
     //word36 CY3 = bitfieldInsert36 (0, cpu.du.CHTALLY, 0, 24);
@@ -3808,16 +4060,43 @@ void scmr (cpu_state_t * cpup)
       DU_CYCLE_FLEN_128;))
 
     uint limit = e -> N1;
-    for ( ; cpu.du.CHTALLY < limit; cpu.du.CHTALLY ++)
+
+#if defined(EIS_PTR3)
+    uint TA = TA1;
+#else
+    uint TA = e -> TA1;
+#endif
+
+    // As scm, walking the words from the end of the string.
+    bool found = false;
+    while (! found && cpu.du.CHTALLY < limit)
       {
-        word9 yCharn1 = EISget469 (cpup, 1, limit - cpu.du.CHTALLY - 1);
-        word9 c = ((~mask) & (yCharn1 ^ ctest)) & 0777;
-        if (c == 0)
+        uint residue, nPos;
+        word36 data = EISgetWord469 (cpup, 1, limit - cpu.du.CHTALLY - 1, & residue, & nPos);
+        if (residue == nPos - 1 && limit - cpu.du.CHTALLY >= nPos &&
+            ! EISmatchWord469 (TA, data, ctest, mask))
           {
-            //00...0 → C(Y3)0,11
-            //i-1 → C(Y3)12,35
-            //Y3 = bitfieldInsert36(Y3, cpu.du.CHTALLY, 0, 24);
-            break;
+            cpu.du.CHTALLY += nPos;
+            continue;
+          }
+        for ( ; cpu.du.CHTALLY < limit; cpu.du.CHTALLY ++)
+          {
+            word9 yCharn1 = EISchar469 (TA, data, residue);
+            word9 c = ((~mask) & (yCharn1 ^ ctest)) & 0777;
+            if (c == 0)
+              {
+                //00...0 → C(Y3)0,11
+                //i-1 → C(Y3)12,35
+                //Y3 = bitfieldInsert36(Y3, cpu.du.CHTALLY, 0, 24);
+                found = true;
+                break;
+              }
+            if (residue == 0)
+              {
+                cpu.du.CHTALLY ++;
+                break;
+              }
+            residue --;
           }
       }
     //word36 CY3 = bitfieldInsert36 (0, cpu.du.CHTALLY, 0, 24);
@@ -4023,9 +4302,20 @@ void tct (cpu_state_t * cpup)
     PNL (L68_ (if (e->N1 < 128)
       DU_CYCLE_FLEN_128;))
 
+#if defined(EIS_PTR3)
+    uint TA = TA1;
+#else
+    uint TA = e -> TA1;
+#endif
+
+    // The source is read a word at a time and its characters taken in turn.
+    uint residue = 0, nPos = 0;
+    word36 data = 0;
     for ( ; cpu.du.CHTALLY < e -> N1; cpu.du.CHTALLY ++)
       {
-        word9 c = EISget469 (cpup, 1, cpu.du.CHTALLY); // get src char
+        if (residue == nPos)
+          data = EISgetWord469 (cpup, 1, cpu.du.CHTALLY, & residue, & nPos);
+        word9 c = EISchar469 (TA, data, residue ++); // get src char
 
         uint m = 0;
 
@@ -4218,10 +4508,25 @@ void tctr (cpu_state_t * cpup)
     PNL (L68_ (if (e->N1 < 128)
       DU_CYCLE_FLEN_128;))
 
+#if defined(EIS_PTR3)
+    uint TA = TA1;
+#else
+    uint TA = e -> TA1;
+#endif
+
+    // As tct, reading the source words from the end of the string.
+    uint residue = 0, nPos;
+    bool fetch = true;
+    word36 data = 0;
     uint limit = e -> N1;
     for ( ; cpu.du.CHTALLY < limit; cpu.du.CHTALLY ++)
       {
-        word9 c = EISget469 (cpup, 1, limit - cpu.du.CHTALLY - 1); // get src char
+        if (fetch)
+          data = EISgetWord469 (cpup, 1, limit - cpu.du.CHTALLY - 1, & residue, & nPos);
+        word9 c = EISchar469 (TA, data, residue); // get src char
+        fetch = residue == 0;
+        if (! fetch)
+          residue --;
 
         uint m = 0;
 
@@ -4585,24 +4890,23 @@ void mlr (cpu_state_t * cpup)
     if (e -> TA1 == CTA9 &&  // src and dst are both char 9
         e -> TA2 == CTA9 &&
 #endif
-        e -> N1 % 4 == 0 &&  // a whole number of words in the src
-        e -> N2 == e -> N1 && // the src is the same size as the dest.
         e -> CN1 == 0 &&  // and it starts at a word boundary // BITNO?
         e -> CN2 == 0)
       {
         sim_debug (DBG_TRACEEXT, & cpu_dev, "MLR special case #1\r\n");
-        for ( ; cpu.du.CHTALLY < e -> N2; cpu.du.CHTALLY += 4)
+        // Move the whole words; a partial last word and any fill are
+        // left to the character loop below, which resumes at CHTALLY.
+        // (After a restart in that loop CHTALLY is past the words.)
+        EISMoveWords (cpup, min (e -> N1, e -> N2) / 4, false);
+        if (e -> N1 == e -> N2 && e -> N1 % 4 == 0)
           {
-            uint n = cpu.du.CHTALLY / 4;
-            word36 w = EISReadIdx (cpup, & e -> ADDR1, n);
-            EISWriteIdx (cpup, & e -> ADDR2, n, w, true);
+            cleanupOperandDescriptor (cpup, 1);
+            cleanupOperandDescriptor (cpup, 2);
+            // truncation fault check does need to be checked for here since
+            // it is known that N1 == N2
+            CLR_I_TRUNC;
+            return;
           }
-        cleanupOperandDescriptor (cpup, 1);
-        cleanupOperandDescriptor (cpup, 2);
-        // truncation fault check does need to be checked for here since
-        // it is known that N1 == N2
-        CLR_I_TRUNC;
-        return;
       }
 
 // Test for the case of aligned word fill; and do things a word at a time,
@@ -4886,13 +5190,7 @@ void mrl (cpu_state_t * cpup)
         e -> CN2 == 0)
       {
         sim_debug (DBG_TRACEEXT, & cpu_dev, "MRL special case #1\r\n");
-        uint limit = e -> N2;
-        for ( ; cpu.du.CHTALLY < limit; cpu.du.CHTALLY += 4)
-          {
-            uint n = (limit - cpu.du.CHTALLY - 1) / 4;
-            word36 w = EISReadIdx (cpup, & e -> ADDR1, n);
-            EISWriteIdx (cpup, & e -> ADDR2, n, w, true);
-          }
+        EISMoveWords (cpup, e -> N2 / 4, true);
         cleanupOperandDescriptor (cpup, 1);
         cleanupOperandDescriptor (cpup, 2);
         // truncation fault check does need to be checked for here since
@@ -5241,14 +5539,43 @@ static void EISloadInputBufferAlphnumeric (cpu_state_t * cpup, int k)
       }
 }
 
+// Store the output buffer a word at a time; each destination word is read,
+// updated with all of its characters and written back once, in the same
+// order (and so with the same faults) as storing them one by one.
+
 static void EISwriteOutputBufferToMemory (cpu_state_t * cpup, int k)
   {
     EISstruct * e = & cpu.currentEISinstruction;
+#if defined(EIS_PTR3)
+    uint TA = cpu.du.TAk[k-1];
+#else
+    uint TA = e -> TA [k - 1];
+#endif
 
-    for (uint n = 0 ; n < (uint) e -> dstTally; n ++)
+    uint n = 0;
+    while (n < (uint) e -> dstTally)
       {
-        word9 c49 = e -> outBuffer [n];
-        EISput469 (cpup, k, n, c49);
+        uint residue, nPos;
+        word36 w = EISgetWord469 (cpup, k, n, & residue, & nPos);
+        for ( ; residue < nPos && n < (uint) e -> dstTally; residue ++, n ++)
+          {
+            word9 c49 = e -> outBuffer [n];
+            switch (TA)
+              {
+                case CTA4:
+                  w = put4 (w, (int) residue, (word4) c49);
+                  break;
+
+                case CTA6:
+                  w = put6 (w, (int) residue, (word6) c49);
+                  break;
+
+                case CTA9:
+                  w = put9 (w, (int) residue, c49);
+                  break;
+              }
+          }
+        EISWriteIdx (cpup, & e -> addr [k - 1], 0, w, true);
       }
   }
 
@@ -7651,6 +7978,44 @@ static void EISwrite49(cpu_state_t * cpup, EISaddr *p, int *pos, int tn, word9 c
     }
 }
 
+/*
+ * write n 4- or 9-bit numeric chars to dstAddr, one memory word at a time.
+ * Leaves p and *pos as n calls to EISwrite49 would.
+ */
+
+static void EISwriteString49(cpu_state_t * cpup, EISaddr *p, int *pos, int tn, const word9 *c49, int n)
+{
+    int maxPos = tn == CTN4 ? 7 : 3;
+    int i = 0;
+    while (i < n)
+    {
+        if (*pos > maxPos)    // out-of-range?
+        {
+            *pos = 0;    // reset to 1st char
+#if defined(EIS_PTR)
+            long eisaddr_idx = EISADDR_IDX (p);
+if (eisaddr_idx < 0 || eisaddr_idx > 2) { sim_warn ("IDX1"); return }
+            cpu.du.Dk_PTR_W[eisaddr_idx] = (cpu.du.Dk_PTR_W[eisaddr_idx] + 1) & AMASK;     // bump source to next address
+#else
+            p->address = (p->address + 1) & AMASK;        // goto next dstAddr in memory
+#endif
+        }
+
+        word36 w = EISRead(cpup, p);      // read dst memory into w
+
+        // AL39, Figures 2-3 and 2-5
+        for (; i < n && *pos <= maxPos; i ++, *pos += 1)
+        {
+            if (tn == CTN4)
+                w = setbits36_4 (w, (uint) (9 * (*pos / 2) + 1 + 4 * (*pos % 2)), (word4) c49[i]);
+            else
+                w = setbits36_9 (w, (uint) (9 * *pos), c49[i]);
+        }
+
+        EISWriteIdx (cpup, p, 0, w, true);
+    }
+}
+
 void mvn (cpu_state_t * cpup)
 {
     /*
@@ -9487,6 +9852,16 @@ static void _btd (bool * ovfp)
 }
 #endif
 
+// Longest btd result field, and digit pairs for the conversion
+#define BTD_CHARS 63
+
+static const char btdDigitPairs[] =
+    "00010203040506070809" "10111213141516171819"
+    "20212223242526272829" "30313233343536373839"
+    "40414243444546474849" "50515253545556575859"
+    "60616263646566676869" "70717273747576777879"
+    "80818283848586878889" "90919293949596979899";
+
 void btd (cpu_state_t * cpup)
 {
     EISstruct * e = & cpu.currentEISinstruction;
@@ -9621,10 +9996,6 @@ void btd (cpu_state_t * cpup)
     if (n2 < 1)
         doFault (FAULT_IPR, fst_ill_proc, "btd adjusted n2<1");
 
-    decContext set;
-    decContextDefaultDPS8(&set);
-    set.traps=0;
-
     load9x(cpup, (int) e->N1, &e->ADDR1, (int) e->CN1);
 
     // handle sign
@@ -9638,19 +10009,11 @@ void btd (cpu_state_t * cpup)
 
       }
 
-    // convert to decimal string, workaround missing sprintf uint128
-    char tmp[32];
-    tmp[31] = 0;
-    int i;
-    for (i=30;i>=0;i--) {
-        //tmp[i] = x%10 + '0';
-        //x /= 10;
-        uint16_t r;
-        x = divide_128_16 (x, 10, & r);
-        tmp[i] = (char) r + '0';
-        if (iszero_128 (x))
-            break;
-    }
+    // split into base 10^8 groups; |x| < 2^71 needs three
+    uint32_t grp[3];
+    x = divide_128_32 (x, 100000000, & grp[2]);
+    x = divide_128_32 (x, 100000000, & grp[1]);
+    grp[0] = (uint32_t) x.l;
 #else
     word72 x = (word72)e->x;
     if (e->x < 0) {
@@ -9660,104 +10023,95 @@ void btd (cpu_state_t * cpup)
         x = ((word72) (- (word72s) x)) & MASK72;
     }
 
-    // convert to decimal string, workaround missing sprintf uint128
-    char tmp[32];
-    tmp[31] = 0;
-    int i;
-    for (i=30;i>=0;i--) {
-        tmp[i] = x%10 + '0';
-        x /= 10;
-        if (x == 0)
-            break;
-    }
+    // split into base 10^8 groups; |x| < 2^71 needs three
+    uint32_t grp[3];
+    grp[2] = (uint32_t) (x % 100000000);
+    x /= 100000000;
+    grp[1] = (uint32_t) (x % 100000000);
+    grp[0] = (uint32_t) (x / 100000000);
 #endif /* if defined(NEED_128) */
 
-    decNumber _1;
-    decNumber *op1 = decNumberFromString(&_1, tmp+i, &set);
-    if (e->sign == -1)
-        op1->bits |= DECNEG;
-
-    bool Ovr = false, Trunc = false;
+    // convert to a right-justified decimal string, two digits at a time,
+    // zero-filled to the widest field
+    char tmp[BTD_CHARS + 1];
+    tmp[BTD_CHARS] = 0;
+    memset (tmp, '0', BTD_CHARS - 24);
+    for (int g = 0; g < 3; g++) {
+        uint32_t v = grp[g];
+        for (int j = BTD_CHARS - 24 + 8 * g + 6; j >= BTD_CHARS - 24 + 8 * g; j -= 2) {
+            memcpy (tmp + j, btdDigitPairs + 2 * (v % 100), 2);
+            v /= 100;
+        }
+    }
+    int i = 0;
+    while (i < BTD_CHARS - 1 && tmp[i] == '0')
+        i++;
 
+    bool Ovr = false, neg, zero;
     uint8_t out [256];
-    char * res = formatDecimal (out, &set, op1, n2, (int) e->S2, e->SF2, 0, &Ovr, &Trunc);
-
-    // now write to memory in proper format.....
+    const char * res;
+
+    if (e->SF2 == 0) {
+        // An unscaled integer needs no rescaling or rounding, only the loss
+        // of high-order digits when it is wider than the field, as
+        // formatDecimal would do.
+        if (BTD_CHARS - i > n2) {
+            Ovr = true;
+            i = BTD_CHARS - n2;
+            while (i < BTD_CHARS - 1 && tmp[i] == '0')
+                i++;
+        }
+        zero = tmp[i] == '0';
+        neg = e->sign == -1 && !zero;
+        res = tmp + BTD_CHARS - n2;
+    } else {
+        decContext set;
+        decContextDefaultDPS8(&set);
+        set.traps=0;
 
-    //word18 dstAddr = e->dstAddr;
-    int pos = (int) dstCN;
+        decNumber _1;
+        decNumber *op1 = decNumberFromString(&_1, tmp+i, &set);
+        if (e->sign == -1)
+            op1->bits |= DECNEG;
 
-    // 1st, take care of any leading sign .......
-    switch(e->S2)
-    {
-        case CSLS:  // fixed-point, leading sign
-            switch(dstTN)
-            {
-                case CTN4:
-                    if (e->P) //If TN2 and S2 specify a 4-bit signed number and P = 1,
-                              //   then the 13(8) plus sign character is placed appropriately
-                              //   if the result of the operation is positive.
-                        EISwrite49(cpup, &e->ADDR2, &pos, (int) dstTN,
-                                   (decNumberIsNegative(op1) && !decNumberIsZero(op1)) ? 015 : 013);  // special +
-                    else
-                        EISwrite49(cpup, &e->ADDR2, &pos, (int) dstTN,
-                                   (decNumberIsNegative(op1) && !decNumberIsZero(op1)) ? 015 : 014);  // default +
-                    break;
-                case CTN9:
-                    EISwrite49(cpup, &e->ADDR2, &pos, (int) dstTN,
-                               (decNumberIsNegative(op1) && !decNumberIsZero(op1)) ? '-' : '+');
-                    break;
-            }
-            break;
+        bool Trunc = false;
 
-        case CSTS:  // nuttin' to do here .....
-        case CSNS:
-            break;  // no sign wysiwyg
+        res = formatDecimal (out, &set, op1, n2, (int) e->S2, e->SF2, 0, &Ovr, &Trunc);
+        zero = decNumberIsZero(op1);
+        neg = decNumberIsNegative(op1) && !zero;
     }
 
-    // 2nd, write the digits .....
-    for(int i = 0 ; i < n2 ; i++)
-        switch(dstTN)
-        {
-            case CTN4:
-                EISwrite49(cpup, &e->ADDR2, &pos, (int) dstTN, (word9) (res[i] - '0'));
-                break;
-            case CTN9:
-                EISwrite49(cpup, &e->ADDR2, &pos, (int) dstTN, (word9) res[i]);
-                break;
-        }
+    // now build the result in the proper format, and write it to memory
+    // a word at a time .....
 
-    // 3rd, take care of any trailing sign or exponent ...
-    switch(e->S2)
-    {
-        case CSTS:  // write trailing sign ....
-            switch(dstTN)
-            {
-                case CTN4:
-                    if (e->P) //If TN2 and S2 specify a 4-bit signed number and P = 1,
-                              //   then the 13(8) plus sign character is placed appropriately
-                              //   if the result of the operation is positive.
-                        EISwrite49(cpup, &e->ADDR2, &pos, (int) dstTN,
-                                   (decNumberIsNegative(op1) && !decNumberIsZero(op1)) ? 015 :  013);  // special +
-                    else
-                        EISwrite49(cpup, &e->ADDR2, &pos, (int) dstTN,
-                                   (decNumberIsNegative(op1) && !decNumberIsZero(op1)) ? 015 :  014);  // default +
-                    break;
+    word9 chars[64];
+    int nc = 0;
+    word9 sign;
+    if (dstTN == CTN4)
+        //If TN2 and S2 specify a 4-bit signed number and P = 1,
+        //   then the 13(8) plus sign character is placed appropriately
+        //   if the result of the operation is positive.
+        sign = neg ? 015 : e->P ? 013 : 014;
+    else
+        sign = neg ? '-' : '+';
 
-                case CTN9:
-                    EISwrite49(cpup, &e->ADDR2, &pos, (int) dstTN,
-                               (decNumberIsNegative(op1) && !decNumberIsZero(op1)) ? '-' : '+');
-                    break;
-            }
-            break;
+    // 1st, take care of any leading sign .......
+    if (e->S2 == CSLS)
+        chars[nc++] = sign;
 
-        case CSLS:  // fixed point, leading sign - already done
-        case CSNS:  // fixed point, unsigned - nuttin' needed to do
-            break;
-    }
+    // 2nd, the digits .....
+    for (int j = 0 ; j < n2 ; j++)
+        chars[nc++] = dstTN == CTN4 ? (word9) (res[j] - '0') : (word9) res[j];
+
+    // 3rd, take care of any trailing sign ...
+    if (e->S2 == CSTS)
+        chars[nc++] = sign;
+
+    int pos = (int) dstCN;
+    EISwriteString49(cpup, &e->ADDR2, &pos, (int) dstTN, chars, nc);
 
-    SC_I_NEG (decNumberIsNegative(op1) && !decNumberIsZero(op1));  // set negative indicator if op3 < 0
-    SC_I_ZERO (decNumberIsZero(op1));     // set zero indicator if op3 == 0
+    SC_I_NEG (neg);   // set negative indicator if op3 < 0
+    SC_I_ZERO (zero); // set zero indicator if op3 == 0
 
     cleanupOperandDescriptor (cpup, 1);
     cleanupOperandDescriptor (cpup, 2);
@@ -10096,15 +10450,21 @@ sim_printf("dtb: N1 %d N2 %d nin %d CN1 %d CN2 %d msk %012"PRIo64" %012"PRIo64"\
     PRINTDEC("dtb input (op1)", op1);
 #endif
 
-    // input is unscaled fixed point, so just get the digits
+    // input is unscaled fixed point, so just get the digits, up to nine at
+    // a time: x <= msk < 2^71 and 10^9 < 2^30, so each step fits in 128
+    // bits. Until it overflows the value only grows, so testing once per
+    // group finds the same overflow as testing every digit.
     bool Ovr = false;
 #if defined(NEED_128)
     word72 x = construct_128 (0, 0);
-    for (int i = 0; i < n1; i++) {
-        //x *= 10;
-        x = multiply_128 (x, construct_128 (0, 10));
-        //x += e->inBuffer[i];
-        x = add_128 (x, construct_128 (0, (uint) e->inBuffer[i]));
+    for (int i = 0; i < n1; ) {
+        uint32_t grp = 0, scale = 1;
+        for (int j = 0; j < 9 && i < n1; j++, i++) {
+            grp = grp * 10 + e->inBuffer[i];
+            scale *= 10;
+        }
+        //x = x * scale + grp;
+        x = add_128 (multiply_128 (x, construct_128 (0, scale)), construct_128 (0, grp));
         //Ovr |= x>msk?1:0;
         Ovr |= isgt_128 (x, msk) ? 1 : 0;
         //x &= msk; // multiplication and addition mod msk+1
@@ -10116,10 +10476,13 @@ sim_printf("dtb: N1 %d N2 %d nin %d CN1 %d CN2 %d msk %012"PRIo64" %012"PRIo64"\
 
 #else
     word72 x = 0;
-    for (int i = 0; i < n1; i++) {
-        x *= 10;
-        x += e->inBuffer[i];
-        //sim_printf("%d %012"PRIo64" %012"PRIo64"\r\n",e->inBuffer[i],(word36)((x >> 36) & DMASK), (word36)(x & DMASK));
+    for (int i = 0; i < n1; ) {
+        uint32_t grp = 0, scale = 1;
+        for (int j = 0; j < 9 && i < n1; j++, i++) {
+            grp = grp * 10 + e->inBuffer[i];
+            scale *= 10;
+        }
+        x = x * scale + grp;
         Ovr |= x>msk?1:0;
         x &= msk; // multiplication and addition mod msk+1
     }
@@ -10132,17 +10495,19 @@ sim_printf("dtb: N1 %d N2 %d nin %d CN1 %d CN2 %d msk %012"PRIo64" %012"PRIo64"\
 #endif /* if defined(NEED_128) */
     int pos = (int)e->CN2;
 
-    // now write to memory in proper format.....
+    // now write to memory in proper format, a word at a time.....
 
+    word9 chars[8];
     int shift = 9*((int)e->N2-1);
     for(int i = 0; i < (int)e->N2; i++) {
 #if defined(NEED_128)
-        EISwrite9(cpup, &e->ADDR2, &pos, (word9) rshift_128 (x, (uint) shift).l & 0777);
+        chars[i] = (word9) rshift_128 (x, (uint) shift).l & 0777;
 #else
-        EISwrite9(cpup, &e->ADDR2, &pos, (word9) (x >> shift )& 0777);
+        chars[i] = (word9) (x >> shift )& 0777;
 #endif /* if defined(NEED_128) */
         shift -= 9;
     }
+    EISwriteString49(cpup, &e->ADDR2, &pos, CTN9, chars, (int)e->N2);
 
     SC_I_NEG (e->sign == -1);  // set negative indicator
 #if defined(NEED_128)
@@ -10313,7 +10678,12 @@ void ad2d (cpu_state_t * cpup)
     if (e->S2 == CSFL)
         op2->exponent = e->exponent;
 
-    decNumber *op3 = decNumberAdd(&_3, op1, op2, &set);
+    bool Ovr = false, EOvr = false, Trunc = false;
+
+    uint8_t out [256];
+    char *res = e->S2 == CSFL ? NULL :
+        decFixedAdd(out, &_3, op1, op2, &set, n2, e->SF2, R, &Ovr, &Trunc);
+    decNumber *op3 = res ? &_3 : decNumberAdd(&_3, op1, op2, &set);
 
     // ISOLTS 846 07c, 10a, 11b internal register overflow - see ad3d
     bool iOvr = 0;
@@ -10350,10 +10720,8 @@ void ad2d (cpu_state_t * cpup)
         }
     }
 
-    bool Ovr = false, EOvr = false, Trunc = false;
-
-    uint8_t out [256];
-    char *res = formatDecimal(out, &set, op3, n2, (int) e->S2, e->SF2, R, &Ovr, &Trunc);
+    if (!res)
+        res = formatDecimal(out, &set, op3, n2, (int) e->S2, e->SF2, R, &Ovr, &Trunc);
 
     Ovr |= iOvr;
 
@@ -10694,7 +11062,12 @@ void ad3d (cpu_state_t * cpup)
     if (e->S2 == CSFL)
         op2->exponent = e->exponent;
 
-    decNumber *op3 = decNumberAdd(&_3, op1, op2, &set);
+    bool Ovr = false, EOvr = false, Trunc = false;
+
+    uint8_t out [256];
+    char *res = e->S3 == CSFL ? NULL :
+        decFixedAdd(out, &_3, op1, op2, &set, n3, e->SF3, R, &Ovr, &Trunc);
+    decNumber *op3 = res ? &_3 : decNumberAdd(&_3, op1, op2, &set);
 
     // RJ78: significant digits in the result may be lost if:
     // The difference between the scaling factors (exponents) of the source
@@ -10741,10 +11114,8 @@ void ad3d (cpu_state_t * cpup)
         }
     }
 
-    bool Ovr = false, EOvr = false, Trunc = false;
-
-    uint8_t out [256];
-    char *res = formatDecimal(out, &set, op3, n3, (int) e->S3, e->SF3, R, &Ovr, &Trunc);
+    if (!res)
+        res = formatDecimal(out, &set, op3, n3, (int) e->S3, e->SF3, R, &Ovr, &Trunc);
 
     Ovr |= iOvr;
 
@@ -11025,7 +11396,12 @@ void sb2d (cpu_state_t * cpup)
     if (e->S2 == CSFL)
         op2->exponent = e->exponent;
 
-    decNumber *op3 = decNumberSubtract(&_3, op2, op1, &set);
+    bool Ovr = false, EOvr = false, Trunc = false;
+
+    uint8_t out [256];
+    char *res = e->S2 == CSFL ? NULL :
+        decFixedSubtract(out, &_3, op2, op1, &set, n2, e->SF2, R, &Ovr, &Trunc);
+    decNumber *op3 = res ? &_3 : decNumberSubtract(&_3, op2, op1, &set);
 
     // ISOLTS 846 07c, 10a, 11b internal register overflow - see ad3d
     bool iOvr = 0;
@@ -11062,10 +11438,8 @@ void sb2d (cpu_state_t * cpup)
         }
     }
 
-    bool Ovr = false, EOvr = false, Trunc = false;
-
-    uint8_t out [256];
-    char *res = formatDecimal(out, &set, op3, n2, (int) e->S2, e->SF2, R, &Ovr, &Trunc);
+    if (!res)
+        res = formatDecimal(out, &set, op3, n2, (int) e->S2, e->SF2, R, &Ovr, &Trunc);
 
     Ovr |= iOvr;
 
@@ -11366,7 +11740,12 @@ void sb3d (cpu_state_t * cpup)
     if (e->S2 == CSFL)
         op2->exponent = e->exponent;
 
-    decNumber *op3 = decNumberSubtract(&_3, op2, op1, &set);
+    bool Ovr = false, EOvr = false, Trunc = false;
+
+    uint8_t out [256];
+    char *res = e->S3 == CSFL ? NULL :
+        decFixedSubtract(out, &_3, op2, op1, &set, n3, e->SF3, R, &Ovr, &Trunc);
+    decNumber *op3 = res ? &_3 : decNumberSubtract(&_3, op2, op1, &set);
 
     // ISOLTS 846 07c, 10a, 11b internal register overflow - see ad3d
     bool iOvr = 0;
@@ -11403,10 +11782,8 @@ void sb3d (cpu_state_t * cpup)
         }
     }
 
-    bool Ovr = false, EOvr = false, Trunc = false;
-
-    uint8_t out [256];
-    char *res = formatDecimal(out, &set, op3, n3, (int) e->S3, e->SF3, R, &Ovr, &Trunc);
+    if (!res)
+        res = formatDecimal(out, &set, op3, n3, (int) e->S3, e->SF3, R, &Ovr, &Trunc);
 
     Ovr |= iOvr;
 
@@ -11682,12 +12059,15 @@ void mp2d (cpu_state_t * cpup)
     if (e->S2 == CSFL)
         op2->exponent = e->exponent;
 
-    decNumber *op3 = decNumberMultiply(&_3, op1, op2, &set);
-
     bool Ovr = false, EOvr = false, Trunc = false;
 
     uint8_t out [256];
-    char *res = formatDecimal(out, &set, op3, n2, (int) e->S2, e->SF2, R, &Ovr, &Trunc);
+    char *res = e->S2 == CSFL ? NULL :
+        decFixedMultiply(out, &_3, op1, op2, &set, n2, e->SF2, R, &Ovr, &Trunc);
+    decNumber *op3 = res ? &_3 : decNumberMultiply(&_3, op1, op2, &set);
+
+    if (!res)
+        res = formatDecimal(out, &set, op3, n2, (int) e->S2, e->SF2, R, &Ovr, &Trunc);
 
     if (decNumberIsZero(op3))
         op3->exponent = 127;
@@ -11984,7 +12364,12 @@ void mp3d (cpu_state_t * cpup)
     if (e->S2 == CSFL)
         op2->exponent = e->exponent;
 
-    decNumber *op3 = decNumberMultiply(&_3, op1, op2, &set);
+    bool Ovr = false, EOvr = false, Trunc = false;
+
+    uint8_t out [256];
+    char *res = e->S3 == CSFL ? NULL :
+        decFixedMultiply(out, &_3, op1, op2, &set, n3, e->SF3, R, &Ovr, &Trunc);
+    decNumber *op3 = res ? &_3 : decNumberMultiply(&_3, op1, op2, &set);
 
 //    char c1[1024];
 //    char c2[1024];
@@ -11997,10 +12382,8 @@ void mp3d (cpu_state_t * cpup)
 //    decNumberToString(op3, c3);
 //    sim_printf("c3:%s\r\n", c3);
 
-    bool Ovr = false, EOvr = false, Trunc = false;
-
-    uint8_t out [256];
-    char *res = formatDecimal(out, &set, op3, n3, (int) e->S3, e->SF3, R, &Ovr, &Trunc);
+    if (!res)
+        res = formatDecimal(out, &set, op3, n3, (int) e->S3, e->SF3, R, &Ovr, &Trunc);
 
     if (decNumberIsZero(op3))
         op3->exponent = 127;
@@ -13065,8 +13448,13 @@ sim_debug (DBG_TRACEEXT, & cpu_dev, "dv2d S1 %d S2 %d N1 %d N2 %d clz1 %d clz2 %
     // Note: NQ is currently unused apart from this FAULT_DIV check.
     // decNumber produces more digits than required, but they are then rounded/truncated
 
+    bool Ovr = false, EOvr = false, Trunc = false;
+
+    uint8_t out [256];
     // Yes, they're switched. op1=divisor
-    decNumber *op3 = decNumberDivide(&_3, op2, op1, &set);
+    char *res = e->S2 == CSFL ? NULL :
+        decFixedDivide(out, &_3, op2, op1, &set, n2, e->SF2, R, &Ovr, &Trunc);
+    decNumber *op3 = res ? &_3 : decNumberDivide(&_3, op2, op1, &set);
     // Note DPS88 and DPS9000 are different when NQ <= 0
     // This is a flaw in the DPS8/70 hardware which was corrected in later models
     // ISOLTS-817 05b
@@ -13101,9 +13489,6 @@ sim_debug (DBG_TRACEEXT, & cpu_dev, "dv2d S1 %d S2 %d N1 %d N2 %d clz1 %d clz2 %
         }
     }
 
-    bool Ovr = false, EOvr = false, Trunc = false;
-    uint8_t out[256];
-
     // CSFL: If the divisor is greater than the dividend after operand
     // alignment, the leading zero digit produced is counted and the effective
     // precision of the result is reduced by one.
@@ -13113,7 +13498,6 @@ sim_debug (DBG_TRACEEXT, & cpu_dev, "dv2d S1 %d S2 %d N1 %d N2 %d clz1 %d clz2 %
     // "greater after operand alignment" means scale until most-significant digits
     //   are nonzero, then compare magnitudes ignoring exponents
     // This passes ISOLTS-817 06e, ET 458,461,483,486
-    char *res;
     if (e->S2 == CSFL) {
         decNumber _1a;
         decNumber _2a;
@@ -13151,7 +13535,7 @@ sim_debug (DBG_TRACEEXT, & cpu_dev, "dv2d S1 %d S2 %d N1 %d N2 %d clz1 %d clz2 %
             // full n2 digits are returned
             res = formatDecimal(out, &set, op3, n2, (int) e->S2, e->SF2, R, &Ovr, &Trunc);
         }
-    } else {
+    } else if (!res) {
         // same as all other decimal instructions
         res = formatDecimal(out, &set, op3, n2, (int) e->S2, e->SF2, R, &Ovr, &Trunc);
     }
@@ -13508,8 +13892,13 @@ sim_debug (DBG_TRACEEXT, & cpu_dev, "dv3d S1 %d S2 %d N1 %d N2 %d clz1 %d clz2 %
     // Note: NQ is currently unused apart from this FAULT_DIV check.
     //   decNumber produces more digits than required, but they are then rounded/truncated
 
+    bool Ovr = false, EOvr = false, Trunc = false;
+
+    uint8_t out [256];
     // Yes, they're switched. op1=divisor
-    decNumber *op3 = decNumberDivide(&_3, op2, op1, &set);
+    char *res = e->S3 == CSFL ? NULL :
+        decFixedDivide(out, &_3, op2, op1, &set, n3, e->SF3, R, &Ovr, &Trunc);
+    decNumber *op3 = res ? &_3 : decNumberDivide(&_3, op2, op1, &set);
     // Note DPS88 and DPS9000 are different when NQ <= 0
     // This is a flaw in the DPS8/70 hardware which was corrected in later models
     // ISOLTS-817 05b
@@ -13544,9 +13933,6 @@ sim_debug (DBG_TRACEEXT, & cpu_dev, "dv3d S1 %d S2 %d N1 %d N2 %d clz1 %d clz2 %
         }
     }
 
-    bool Ovr = false, EOvr = false, Trunc = false;
-    uint8_t out[256];
-
     // CSFL: If the divisor is greater than the dividend after operand
     // alignment, the leading zero digit produced is counted and the effective
     // precision of the result is reduced by one.
@@ -13556,7 +13942,6 @@ sim_debug (DBG_TRACEEXT, & cpu_dev, "dv3d S1 %d S2 %d N1 %d N2 %d clz1 %d clz2 %
     // "greater after operand alignment" means scale until most-significant digits
     //   are nonzero, then compare magnitudes ignoring exponents
     // This passes ISOLTS-817 06e, ET 458,461,483,486
-    char *res;
     if (e->S3 == CSFL) {
         decNumber _1a;
         decNumber _2a;
@@ -13596,7 +13981,7 @@ sim_debug (DBG_TRACEEXT, & cpu_dev, "dv3d S1 %d S2 %d N1 %d N2 %d clz1 %d clz2 %
             // full n3 digits are returned
             res = formatDecimal(out, &set, op3, n3, (int) e->S3, e->SF3, R, &Ovr, &Trunc);
         }
-    } else {
+    } else if (!res) {
         // same as all other decimal instructions
         res = formatDecimal(out, &set, op3, n3, (int) e->S3, e->SF3, R, &Ovr, &Trunc);
     }
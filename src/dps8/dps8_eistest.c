@@ -0,0 +1,1144 @@
+/*
+ * vim: filetype=c:tabstop=4:ai:expandtab
+ * SPDX-License-Identifier: ICU
+ * scspell-id: 1c7a3f6e-cab3-11f1-9a6e-80ee73e9b8e7
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Copyright (c) 2026 The DPS8M Development Team
+ *
+ * This software is made available under the terms of the ICU License.
+ * See the LICENSE.md file at the top-level directory of this distribution.
+ *
+ * ---------------------------------------------------------------------------
+ */
+
+// EIS decimal unit test harness ("--eistest [cases [seed]]")
+//
+// Builds random operands and descriptors in a scratch corner of M[], runs
+// AD2D ... DV3D, MVN, MVNE, CMPN, BTD and DTB on CPU A through
+// executeInstruction in absolute mode, and checks the stored result, the
+// characters around it and the indicators against a reference model. The
+// model works on plain base 10^9 integers and shares no code with the
+// decimal unit, so it can be used to validate rewrites of dps8_eis.c and
+// dps8_decimal.c. It then times each instruction on a fixed set of
+// operands and reports nanoseconds per instruction.
+//
+// Only fixed-point (unscaled and scaled) operands are generated; the CSFL
+// rules of the DPS8/70 divide are not modelled. Where the simulator
+// follows its decNumber implementation rather than AL39 (65 digit sums
+// and quotients, the exponent of a sum with a zero operand, the leading
+// zero count of the divide check) the model does the same.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "dps8.h"
+#include "dps8_sys.h"
+#include "dps8_iom.h"
+#include "dps8_cable.h"
+#include "dps8_cpu.h"
+#include "dps8_faults.h"
+#include "dps8_scu.h"
+#include "dps8_ins.h"
+#include "dps8_utils.h"
+#include "dps8_state.h"
+#include "dps8_memalign.h"
+#include "dps8_console.h"
+#include "dps8_eistest.h"
+
+#define DBG_CTR cpu.cycleCnt
+
+// Scratch layout (absolute addresses)
+#define ET_IC    0100   // instruction word, descriptors follow
+#define ET_OP1   01000  // operand fields; 64 words apart
+#define ET_OP2   01100
+#define ET_OP3   01200
+#define ET_MOPS  01300  // MVNE micro operations
+#define ET_END   01400
+
+#define ET_BENCH_CASES 32
+#define ET_BENCH_REPS  256
+#define ET_MAX_REPORT  8
+
+//
+// Random numbers
+//
+
+static uint64_t etSeed;
+
+static uint32_t etRand (uint32_t n)
+  {
+    etSeed ^= etSeed << 13;
+    etSeed ^= etSeed >> 7;
+    etSeed ^= etSeed << 17;
+    return n ? (uint32_t) (etSeed % n) : 0;
+  }
+
+static int etRange (int lo, int hi)
+  {
+    return lo + (int) etRand ((uint32_t) (hi - lo + 1));
+  }
+
+//
+// Reference arithmetic: unsigned integers in base 10^9
+//
+
+#define ET_LIMBS 40
+#define ET_BASE  1000000000U
+
+typedef struct
+  {
+    uint32_t l [ET_LIMBS]; // least significant limb first
+    int n;                 // limbs in use; zero has none
+  } etBig;
+
+static const uint32_t etPow10 [10] =
+  { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
+
+static void etBigNorm (etBig * a)
+  {
+    while (a->n > 0 && a->l [a->n - 1] == 0)
+      a->n --;
+  }
+
+static void etBigSet (etBig * a, uint32_t v)
+  {
+    a->n = 0;
+    if (v)
+      {
+        a->l [0] = v % ET_BASE;
+        a->n = 1;
+        if (v >= ET_BASE)
+          a->l [a->n ++] = v / ET_BASE;
+      }
+  }
+
+// a = a * m + add; m, add < 10^9
+static void etBigMulAdd (etBig * a, uint32_t m, uint32_t add)
+  {
+    uint64_t c = add;
+    for (int i = 0; i < a->n; i ++)
+      {
+        c += (uint64_t) a->l [i] * m;
+        a->l [i] = (uint32_t) (c % ET_BASE);
+        c /= ET_BASE;
+      }
+    while (c)
+      {
+        a->l [a->n ++] = (uint32_t) (c % ET_BASE);
+        c /= ET_BASE;
+      }
+    etBigNorm (a);
+  }
+
+static int etBigCmp (const etBig * a, const etBig * b)
+  {
+    if (a->n != b->n)
+      return a->n < b->n ? -1 : 1;
+    for (int i = a->n - 1; i >= 0; i --)
+      if (a->l [i] != b->l [i])
+        return a->l [i] < b->l [i] ? -1 : 1;
+    return 0;
+  }
+
+static void etBigAdd (etBig * r, const etBig * a, const etBig * b)
+  {
+    int n = max (a->n, b->n);
+    uint32_t c = 0;
+    for (int i = 0; i < n; i ++)
+      {
+        uint32_t s = c + (i < a->n ? a->l [i] : 0) + (i < b->n ? b->l [i] : 0);
+        c = s >= ET_BASE;
+        r->l [i] = c ? s - ET_BASE : s;
+      }
+    r->n = n;
+    if (c)
+      r->l [r->n ++] = 1;
+  }
+
+// r = a - b; a >= b
+static void etBigSub (etBig * r, const etBig * a, const etBig * b)
+  {
+    int64_t c = 0;
+    for (int i = 0; i < a->n; i ++)
+      {
+        int64_t s = (int64_t) a->l [i] - (i < b->n ? b->l [i] : 0) + c;
+        c = s < 0 ? -1 : 0;
+        r->l [i] = (uint32_t) (s < 0 ? s + ET_BASE : s);
+      }
+    r->n = a->n;
+    etBigNorm (r);
+  }
+
+static void etBigMul (etBig * r, const etBig * a, const etBig * b)
+  {
+    etBig t;
+    memset (t.l, 0, sizeof (t.l));
+    for (int i = 0; i < a->n; i ++)
+      {
+        uint64_t c = 0;
+        for (int j = 0; j < b->n; j ++)
+          {
+            c += t.l [i + j] + (uint64_t) a->l [i] * b->l [j];
+            t.l [i + j] = (uint32_t) (c % ET_BASE);
+            c /= ET_BASE;
+          }
+        t.l [i + b->n] = (uint32_t) c;
+      }
+    t.n = a->n + b->n;
+    etBigNorm (& t);
+    * r = t;
+  }
+
+// q = a / b, rem = a % b; b != 0. Schoolbook division with each quotient
+// limb found by bisection, which is slow but obviously right.
+static void etBigDivMod (etBig * q, etBig * rem, const etBig * a, const etBig * b)
+  {
+    etBig r, t;
+    r.n = 0;
+    q->n = a->n;
+    for (int i = a->n - 1; i >= 0; i --)
+      {
+        for (int j = r.n; j > 0; j --)
+          r.l [j] = r.l [j - 1];
+        r.l [0] = a->l [i];
+        r.n ++;
+        etBigNorm (& r);
+
+        uint32_t lo = 0, hi = ET_BASE - 1;
+        while (lo < hi)
+          {
+            uint32_t mid = lo + (hi - lo + 1) / 2;
+            t = * b;
+            etBigMulAdd (& t, mid, 0);
+            if (etBigCmp (& t, & r) <= 0)
+              lo = mid;
+            else
+              hi = mid - 1;
+          }
+        t = * b;
+        etBigMulAdd (& t, lo, 0);
+        etBigSub (& r, & r, & t);
+        q->l [i] = lo;
+      }
+    etBigNorm (q);
+    if (rem)
+      * rem = r;
+  }
+
+static void etBigMulPow10 (etBig * a, int k)
+  {
+    for (; k > 0; k -= 9)
+      etBigMulAdd (a, etPow10 [min (k, 9)], 0);
+  }
+
+static void etBigPow10 (etBig * a, int k)
+  {
+    etBigSet (a, 1);
+    etBigMulPow10 (a, k);
+  }
+
+static int etBigDigits (const etBig * a)
+  {
+    if (a->n == 0)
+      return 0;
+    int d = (a->n - 1) * 9 + 1;
+    for (int i = 1; i < 9 && a->l [a->n - 1] >= etPow10 [i]; i ++)
+      d ++;
+    return d;
+  }
+
+// decimal digit i, counting from the least significant
+static int etBigDigitAt (const etBig * a, int i)
+  {
+    if (i / 9 >= a->n)
+      return 0;
+    return (int) ((a->l [i / 9] / etPow10 [i % 9]) % 10);
+  }
+
+static int etBigTrailingZeros (const etBig * a)
+  {
+    int i = 0;
+    while (i < etBigDigits (a) && etBigDigitAt (a, i) == 0)
+      i ++;
+    return i;
+  }
+
+// keep the low k decimal digits
+static void etBigLowDigits (etBig * a, int k)
+  {
+    if (a->n > (k + 8) / 9)
+      a->n = (k + 8) / 9;
+    if (k % 9 && a->n == (k + 8) / 9)
+      a->l [a->n - 1] %= etPow10 [k % 9];
+    etBigNorm (a);
+  }
+
+// a / 10^k, truncated or rounded half up; * inexact if digits were lost
+static void etBigDivPow10 (etBig * a, int k, bool round, bool * inexact)
+  {
+    etBig p, r;
+    etBigPow10 (& p, k);
+    etBigDivMod (a, & r, a, & p);
+    * inexact = r.n != 0;
+    if (round)
+      {
+        etBigAdd (& r, & r, & r);
+        if (etBigCmp (& r, & p) >= 0)
+          etBigMulAdd (a, 1, 1);
+      }
+  }
+
+//
+// Operand fields
+//
+
+typedef struct
+  {
+    word18 addr;
+    int cn;
+    int tn;        // CTN9, CTN4
+    int s;         // CSLS, CSTS, CSNS
+    int sf;
+    int nd;        // digits
+    uint8_t d [64]; // most significant first
+    bool neg;
+  } etField;
+
+static int etFieldChars (const etField * f)
+  {
+    return f->nd + (f->s == CSNS ? 0 : 1);
+  }
+
+static word36 etNumDesc (const etField * f)
+  {
+    // 9-bit character positions are encoded as 0, 2, 4, 6
+    int cn = f->tn == CTN9 ? 2 * f->cn : f->cn;
+    return ((word36) f->addr << 18) | ((word36) cn << 15) |
+           ((word36) f->tn << 14) | ((word36) f->s << 12) |
+           ((word36) (f->sf & 077) << 6) | (word36) etFieldChars (f);
+  }
+
+// character i of a string of sz-bit characters starting at (addr, cn)
+static void etCharPos (word18 addr, int cn, int sz, int i, word18 * w, uint * bit)
+  {
+    int perWord = sz == 4 ? 8 : sz == 6 ? 6 : 4;
+    int p = (cn + i) % perWord;
+    * w = (word18) (addr + (word18) ((cn + i) / perWord));
+    * bit = (uint) (sz == 4 ? 9 * (p / 2) + 1 + 4 * (p % 2) : sz * p);
+  }
+
+static void etPutChar (word18 addr, int cn, int sz, int i, word9 c)
+  {
+    word18 w;
+    uint bit;
+    etCharPos (addr, cn, sz, i, & w, & bit);
+    word36 v = M [w] & DMASK;
+    if (sz == 4)
+      v = setbits36_4 (v, bit, (word4) c);
+    else if (sz == 6)
+      v = setbits36_6 (v, bit, (word6) c);
+    else
+      v = setbits36_9 (v, bit, c);
+    M [w] = v;
+  }
+
+static word9 etGetChar (word18 addr, int cn, int sz, int i)
+  {
+    word18 w;
+    uint bit;
+    etCharPos (addr, cn, sz, i, & w, & bit);
+    word36 v = M [w] & DMASK;
+    if (sz == 4)
+      return getbits36_4 (v, bit);
+    if (sz == 6)
+      return getbits36_6 (v, bit);
+    return getbits36_9 (v, bit);
+  }
+
+static word9 etSignChar (int tn, bool neg, bool P)
+  {
+    if (tn == CTN4)
+      return neg ? 015 : P ? 013 : 014;
+    return neg ? '-' : '+';
+  }
+
+static word9 etDigitChar (int tn, int d)
+  {
+    return (word9) (tn == CTN4 ? d : '0' + d);
+  }
+
+// the characters of a fixed-point field holding digits d, in order
+static int etFieldImage (const etField * f, const uint8_t * d, bool neg, bool P, word9 * c)
+  {
+    int n = 0;
+    if (f->s == CSLS)
+      c [n ++] = etSignChar (f->tn, neg, P);
+    for (int i = 0; i < f->nd; i ++)
+      c [n ++] = etDigitChar (f->tn, d [i]);
+    if (f->s == CSTS)
+      c [n ++] = etSignChar (f->tn, neg, P);
+    return n;
+  }
+
+static void etStoreField (const etField * f)
+  {
+    word9 c [64];
+    int n = etFieldImage (f, f->d, f->neg, false, c);
+    for (int i = 0; i < n; i ++)
+      etPutChar (f->addr, f->cn, f->tn == CTN4 ? 4 : 9, i, c [i]);
+  }
+
+static void etFieldValue (const etField * f, etBig * v)
+  {
+    v->n = 0;
+    for (int i = 0; i < f->nd; i ++)
+      etBigMulAdd (v, 10, f->d [i]);
+  }
+
+// A random fixed-point field. Lengths and scale factors favour the small
+// values real programs use, with a tail out to the architectural limits.
+static void etRandField (etField * f, word18 addr, int maxChars)
+  {
+    f->addr = addr;
+    f->tn = etRand (2) ? CTN4 : CTN9;
+    f->cn = (int) etRand (f->tn == CTN4 ? 8 : 4);
+    static const int signs [3] = { CSLS, CSTS, CSNS };
+    f->s = signs [etRand (3)];
+    int maxDigits = maxChars - (f->s == CSNS ? 0 : 1);
+    f->nd = etRand (2) ? etRange (1, min (12, maxDigits)) : etRange (1, maxDigits);
+    f->sf = etRand (2) ? etRange (-4, 4) : etRange (-32, 31);
+    int lz = etRand (2) ? 0 : (int) etRand ((uint32_t) f->nd + 1);
+    bool zero = etRand (16) == 0;
+    for (int i = 0; i < f->nd; i ++)
+      f->d [i] = (uint8_t) (zero || i < lz ? 0 : etRand (10));
+    f->neg = f->s != CSNS && etRand (2);
+  }
+
+//
+// Expected results
+//
+
+typedef struct
+  {
+    _fault fault;         // FAULT_xxx expected, or -1
+    word18 addr;          // destination string
+    int cn, sz, nchars;
+    word9 c [64];
+    word18 flags;         // expected indicators
+    word18 flagMask;      // indicators checked
+  } etExpect;
+
+// Store |result| = C * 10^e into field f as formatDecimal does: rescale to
+// the field's scale factor, rounding half up if R, and on overflow keep the
+// low-order digits. A rescale that would need more than 126 digits gives
+// zero. Note that a field whose scale factor is below -N overflows even
+// when the result is zero.
+static void etExpectFixed (etExpect * x, const etField * f, bool P, etBig * C, int e, bool R,
+                           bool neg, bool ovf, bool trunc)
+  {
+    bool inexact;
+    if (e > f->sf && C->n && etBigDigits (C) + e - f->sf > 126)
+      {
+        C->n = 0;
+        ovf = true;
+      }
+    else if (e > f->sf)
+      etBigMulPow10 (C, e - f->sf);
+    else if (e < f->sf)
+      etBigDivPow10 (C, f->sf - e, R, & inexact);
+
+    // the integer digits must fit in the places left of the scale factor
+    int digits = etBigDigits (C);
+    int intDigits = digits == 0 ? 0 : f->sf >= 0 ? digits : max (digits + f->sf, 0);
+    int places = f->nd + min (f->sf, 0);
+    if (places < intDigits)
+      {
+        ovf = true;
+        etBigLowDigits (C, max (digits - (intDigits - places), 0));
+      }
+    bool zero = C->n == 0;
+    uint8_t d [64];
+    for (int i = 0; i < f->nd; i ++)
+      d [i] = (uint8_t) etBigDigitAt (C, f->nd - 1 - i);
+
+    x->addr = f->addr;
+    x->cn = f->cn;
+    x->sz = f->tn == CTN4 ? 4 : 9;
+    x->nchars = etFieldImage (f, d, neg && ! zero, P, x->c);
+    x->flags = (zero ? I_ZERO : 0) | (neg && ! zero ? I_NEG : 0) |
+               (ovf ? I_OFLOW : 0) | (trunc ? I_TRUNC : 0);
+    x->flagMask = I_ZERO | I_NEG | I_OFLOW | I_TRUNC;
+  }
+
+// Round V (exponent * e) half up to at most 65 digits, as the working
+// context of the decimal unit does
+static void etRound65 (etBig * V, int * e)
+  {
+    bool inexact;
+    int drop = etBigDigits (V) - 65;
+    if (drop > 0)
+      {
+        etBigDivPow10 (V, drop, true, & inexact);
+        * e += drop;
+      }
+    if (etBigDigits (V) > 65)
+      {
+        etBigDivPow10 (V, 1, false, & inexact);
+        * e += 1;
+      }
+  }
+
+enum { ET_AD2D, ET_AD3D, ET_SB2D, ET_SB3D, ET_MP2D, ET_MP3D, ET_DV2D, ET_DV3D,
+       ET_MVN, ET_CMPN, ET_MVNE, ET_BTD, ET_DTB, ET_N };
+
+static const struct
+  {
+    const char * name;
+    word9 opcode;      // all are extended (opcode bit 27 set)
+  } etInstr [ET_N] =
+  {
+    [ET_AD2D] = { "ad2d",  0202 },
+    [ET_AD3D] = { "ad3d",  0222 },
+    [ET_SB2D] = { "sb2d",  0203 },
+    [ET_SB3D] = { "sb3d",  0223 },
+    [ET_MP2D] = { "mp2d",  0206 },
+    [ET_MP3D] = { "mp3d",  0226 },
+    [ET_DV2D] = { "dv2d",  0207 },
+    [ET_DV3D] = { "dv3d",  0227 },
+    [ET_MVN]  = { "mvn",   0300 },
+    [ET_CMPN] = { "cmpn",  0303 },
+    [ET_MVNE] = { "mvne",  0024 },
+    [ET_BTD]  = { "btd",   0301 },
+    [ET_DTB]  = { "dtb",   0305 },
+  };
+
+typedef struct
+  {
+    word36 inst;
+    word36 desc [3];
+    etExpect x;
+    char text [200];   // the operands, for reports
+  } etCase;
+
+// Append "-0012e-3" style text for field f
+static void etDescribe (etCase * t, const etField * f)
+  {
+    size_t l = strlen (t->text);
+    char * p = t->text + l;
+    size_t n = sizeof (t->text) - l;
+    int k = snprintf (p, n, " %c", f->s == CSNS ? ' ' : f->neg ? '-' : '+');
+    for (int i = 0; i < f->nd && k > 0 && (size_t) k < n - 1; i ++)
+      p [k ++] = (char) ('0' + f->d [i]);
+    if (k > 0 && (size_t) k < n)
+      (void) snprintf (p + k, n - (size_t) k, "e%d", f->sf);
+  }
+
+static word36 etInstWord (int op, bool P, bool R)
+  {
+    return ((word36) P << 35) | ((word36) R << 25) |
+           ((word36) etInstr [op].opcode << 9) | (1LLU << 8);
+  }
+
+// The numeric instructions that store a decimal result
+static void etMakeArith (etCase * t, int op)
+  {
+    bool three = op == ET_AD3D || op == ET_SB3D || op == ET_MP3D || op == ET_DV3D;
+    bool P = etRand (2);
+    bool R = etRand (2);
+    etField a, b, r;
+
+    etRandField (& a, ET_OP1, 63);
+    etRandField (& b, ET_OP2, 63);
+    if (op == ET_DV2D || op == ET_DV3D)
+      {
+        // keep most divisors non-zero
+        if (etRand (32))
+          a.d [etRand ((uint32_t) a.nd)] = (uint8_t) etRange (1, 9);
+      }
+    etStoreField (& a);
+    etStoreField (& b);
+    if (three)
+      {
+        etRandField (& r, ET_OP3, 63);
+        etStoreField (& r); // old contents
+      }
+    else
+      r = b;
+
+    t->inst = etInstWord (op, P, R);
+    t->desc [0] = etNumDesc (& a);
+    t->desc [1] = etNumDesc (& b);
+    t->desc [2] = three ? etNumDesc (& r) : 0;
+    t->x.fault = (_fault) -1;
+    etDescribe (t, & a);
+    etDescribe (t, & b);
+    if (three)
+      etDescribe (t, & r);
+
+    etBig A, B, V;
+    etFieldValue (& a, & A);
+    etFieldValue (& b, & B);
+    bool neg = false, ovf = false, trunc = false;
+    int sf = r.sf, e = 0;
+
+    switch (op)
+      {
+        case ET_AD2D: case ET_AD3D:
+        case ET_SB2D: case ET_SB3D:
+          {
+            // op2 + op1, op2 - op1
+            bool negA = a.neg ^ (op == ET_SB2D || op == ET_SB3D);
+            e = min (a.sf, b.sf);
+            etBig As = A, Bs = B;
+            etBigMulPow10 (& As, a.sf - e);
+            etBigMulPow10 (& Bs, b.sf - e);
+            if (negA == b.neg)
+              {
+                etBigAdd (& V, & As, & Bs);
+                neg = b.neg;
+              }
+            else if (etBigCmp (& Bs, & As) >= 0)
+              {
+                etBigSub (& V, & Bs, & As);
+                neg = b.neg;
+              }
+            else
+              {
+                etBigSub (& V, & As, & Bs);
+                neg = negA;
+              }
+            if (V.n == 0)
+              neg = false;
+
+            // decNumber pads a sum with one zero operand only as far as
+            // its 65 digit working precision
+            int eDec = e;
+            if ((A.n == 0) != (B.n == 0))
+              {
+                const etBig * X = A.n ? & A : & B;
+                int xe = A.n ? a.sf : b.sf;
+                eDec = max (e, xe - (65 - etBigDigits (X)));
+                etBig t;
+                etBigPow10 (& t, eDec - e);
+                etBigDivMod (& V, NULL, & V, & t);
+              }
+            else
+              etRound65 (& V, & eDec);
+
+            // internal register overflow: more than 63 digits, not
+            // counting trailing zeros that the scale factor drops. AD2D
+            // and SB2D find an empty (floating point) third descriptor
+            // and use the exponent of the sum instead.
+            int D = max (etBigDigits (& V), 1);
+            int sfReg = three ? sf : eDec;
+            if (D > 63)
+              {
+                int ctz = sfReg > 0 ? etBigTrailingZeros (& V) : 0;
+                int k = min (max (sfReg, 0), ctz);
+                if (D - k > 63)
+                  {
+                    etBigLowDigits (& V, 63 + k);
+                    ovf = true;
+                  }
+              }
+            trunc = ! R && sf > eDec;
+            e = eDec;
+            break;
+          }
+
+        case ET_MP2D: case ET_MP3D:
+          etBigMul (& V, & A, & B);
+          neg = (a.neg != b.neg) && V.n;
+          e = a.sf + b.sf;
+          trunc = ! R && sf > e;
+          break;
+
+        case ET_DV2D: case ET_DV3D:
+          {
+            // op2 / op1. The leading zeros are counted only as far as the
+            // number of significant digits, as the simulator does.
+            int clz1 = 0, clz2 = 0;
+            while (clz1 < a.nd && a.d [clz1] == 0)
+              clz1 ++;
+            while (clz2 < b.nd && b.d [clz2] == 0)
+              clz2 ++;
+            clz1 = min (clz1, max (a.nd - clz1, 1));
+            clz2 = min (clz2, max (b.nd - clz2, 1));
+            int NQ = (b.nd - clz2 + 1) - (a.nd - clz1) + (b.sf - a.sf - sf);
+            if (A.n == 0 || NQ > 63)
+              {
+                t->x.fault = FAULT_DIV;
+                return;
+              }
+            neg = a.neg != b.neg;
+
+            // the quotient rounded half up to 65 digits, which the
+            // receiving field then rounds or truncates again. Divide
+            // never sets the truncation indicator.
+            e = b.sf - a.sf;
+            V.n = 0;
+            if (B.n)
+              {
+                int l = etBigDigits (& B) - etBigDigits (& A);
+                etBig x = A, y = B;
+                if (l >= 0)
+                  etBigMulPow10 (& x, l);
+                else
+                  etBigMulPow10 (& y, - l);
+                int adj = (etBigCmp (& y, & x) < 0 ? l - 1 : l) + e;
+                int e65 = adj - 64;
+
+                etBig num = B, den = A, rem;
+                if (e - e65 >= 0)
+                  etBigMulPow10 (& num, e - e65);
+                else
+                  etBigMulPow10 (& den, e65 - e);
+                etBigDivMod (& V, & rem, & num, & den);
+                etBigAdd (& rem, & rem, & rem);
+                if (etBigCmp (& rem, & den) >= 0)
+                  etBigMulAdd (& V, 1, 1);
+                e = e65;
+                etRound65 (& V, & e);
+              }
+            break;
+          }
+      }
+
+    etExpectFixed (& t->x, & r, P, & V, e, R, neg, ovf, trunc);
+  }
+
+static void etMakeMvn (etCase * t)
+  {
+    bool P = etRand (2);
+    bool R = etRand (2);
+    etField a, r;
+    etRandField (& a, ET_OP1, 63);
+    etRandField (& r, ET_OP2, 63);
+    etStoreField (& a);
+    etStoreField (& r);
+    t->inst = etInstWord (ET_MVN, P, R);
+    t->desc [0] = etNumDesc (& a);
+    t->desc [1] = etNumDesc (& r);
+    t->x.fault = (_fault) -1;
+    etDescribe (t, & a);
+    etDescribe (t, & r);
+
+    etBig V;
+    etFieldValue (& a, & V);
+    // MVN gives a zero source the exponent 127
+    int e = V.n ? a.sf : 127;
+    bool trunc = ! R && r.sf > e;
+    etExpectFixed (& t->x, & r, P, & V, e, R, a.neg, false, trunc);
+  }
+
+static void etMakeCmpn (etCase * t)
+  {
+    etField a, b;
+    etRandField (& a, ET_OP1, 63);
+    etRandField (& b, ET_OP2, 63);
+    if (etRand (4) == 0)
+      {
+        // equal values in different representations
+        int shift = etRange (0, 2);
+        b.sf = max (a.sf - shift, -32);
+        b.nd = min (a.nd + (a.sf - b.sf), 63 - (b.s != CSNS));
+        memset (b.d, 0, sizeof (b.d));
+        for (int i = 0; i < a.nd && i < b.nd; i ++)
+          b.d [i] = a.d [i];
+        b.neg = b.s != CSNS && a.neg;
+      }
+    etStoreField (& a);
+    etStoreField (& b);
+    t->inst = etInstWord (ET_CMPN, false, false);
+    t->desc [0] = etNumDesc (& a);
+    t->desc [1] = etNumDesc (& b);
+    t->x.fault = (_fault) -1;
+    etDescribe (t, & a);
+    etDescribe (t, & b);
+
+    etBig A, B;
+    etFieldValue (& a, & A);
+    etFieldValue (& b, & B);
+    int e = min (a.sf, b.sf);
+    etBigMulPow10 (& A, a.sf - e);
+    etBigMulPow10 (& B, b.sf - e);
+    int mag = etBigCmp (& A, & B);
+    bool negA = a.neg && A.n, negB = b.neg && B.n;
+    int sgn = negA == negB ? (negA ? - mag : mag) : negA ? -1 : 1;
+
+    // Zero: op1 = op2; Negative: op1 > op2; Carry: |op1| <= |op2|
+    t->x.nchars = 0;
+    t->x.flags = (sgn == 0 ? I_ZERO : 0) | (sgn > 0 ? I_NEG : 0) | (mag <= 0 ? I_CARRY : 0);
+    t->x.flagMask = I_ZERO | I_NEG | I_CARRY;
+  }
+
+// MVNE with the zero-suppressing picture PL/I uses for "put": mvzb over a
+// prefix of the digits, then mvc over the rest.
+static void etMakeMvne (etCase * t)
+  {
+    etField a;
+    etRandField (& a, ET_OP1, 63);
+    etStoreField (& a);
+    int k = (int) etRand ((uint32_t) a.nd + 1);
+
+    word9 mops [16];
+    int nm = 0;
+    for (int left = k; left > 0; left -= 16)
+      mops [nm ++] = (word9) ((004 << 4) | (min (left, 16) & 017));   // mvzb
+    for (int left = a.nd - k; left > 0; left -= 16)
+      mops [nm ++] = (word9) ((015 << 4) | (min (left, 16) & 017));   // mvc
+    for (int i = 0; i < nm; i ++)
+      etPutChar (ET_MOPS, 0, 9, i, mops [i]);
+
+    int cn3 = (int) etRand (4);
+    t->inst = etInstWord (ET_MVNE, false, false);
+    t->desc [0] = etNumDesc (& a);
+    t->desc [1] = ((word36) ET_MOPS << 18) | (word36) nm;
+    t->desc [2] = ((word36) ET_OP3 << 18) | ((word36) cn3 << 16) | (word36) a.nd;
+
+    etDescribe (t, & a);
+    etExpect * x = & t->x;
+    x->fault = (_fault) -1;
+    x->addr = ET_OP3;
+    x->cn = cn3;
+    x->sz = 9;
+    x->nchars = a.nd;
+    bool es = false;
+    for (int i = 0; i < a.nd; i ++)
+      {
+        es |= i >= k || a.d [i] != 0;
+        x->c [i] = es ? (word9) ('0' + a.d [i]) : ' ';
+      }
+    x->flagMask = 0;
+    x->flags = 0;
+  }
+
+static void etMakeBtd (etCase * t)
+  {
+    bool P = etRand (2);
+    int n1 = etRange (1, 8);
+    int cn1 = (int) etRand (4);
+    etBig V, full;
+    V.n = 0;
+    bool neg = false;
+    for (int i = 0; i < n1; i ++)
+      {
+        word9 c = (word9) etRand (01000);
+        if (i == 0 && etRand (2))
+          c = (word9) (c & (etRand (2) ? 0 : 7)); // small values
+        etPutChar (ET_OP1, cn1, 9, i, c);
+        if (i == 0)
+          neg = (c & 0400) != 0;
+        etBigMulAdd (& V, 512, c);
+      }
+    if (neg)
+      {
+        // two's complement: |x| = 2^(9 n1) - x
+        etBigSet (& full, 1);
+        for (int i = 0; i < n1; i ++)
+          etBigMulAdd (& full, 512, 0);
+        etBigSub (& V, & full, & V);
+      }
+
+    etField r;
+    etRandField (& r, ET_OP2, 63);
+    r.sf = 0;
+    etStoreField (& r);
+
+    t->inst = etInstWord (ET_BTD, P, false);
+    t->desc [0] = ((word36) ET_OP1 << 18) | ((word36) cn1 << 16) | (word36) n1;
+    t->desc [1] = etNumDesc (& r);
+    t->x.fault = (_fault) -1;
+    etDescribe (t, & r);
+    etExpectFixed (& t->x, & r, P, & V, 0, false, neg, false, false);
+    t->x.flagMask = I_ZERO | I_NEG | I_OFLOW;
+  }
+
+static void etMakeDtb (etCase * t)
+  {
+    etField a;
+    etRandField (& a, ET_OP1, 63);
+    a.sf = 0;
+    if (etRand (2))
+      a.nd = min (a.nd, 22);
+    etStoreField (& a);
+    int n2 = etRange (1, 8);
+    int cn2 = (int) etRand (4);
+    for (int i = 0; i < n2; i ++)
+      etPutChar (ET_OP2, cn2, 9, i, (word9) etRand (01000));
+
+    t->inst = etInstWord (ET_DTB, false, false);
+    t->desc [0] = etNumDesc (& a);
+    t->desc [1] = ((word36) ET_OP2 << 18) | ((word36) cn2 << 16) | (word36) n2;
+    t->x.fault = (_fault) -1;
+    etDescribe (t, & a);
+
+    // x = |value| mod 2^(9 n2 - 1), negated in 72 bits if the sign is minus
+    etBig V, m, hiB, loB, b36;
+    etFieldValue (& a, & V);
+    etBigSet (& m, 1);
+    for (int i = 0; i < 9 * n2 - 1; i ++)
+      etBigMulAdd (& m, 2, 0);
+    bool ovf = etBigCmp (& V, & m) >= 0;
+    etBigDivMod (& hiB, & V, & V, & m);
+    etBigSet (& b36, 1);
+    for (int i = 0; i < 36; i ++)
+      etBigMulAdd (& b36, 2, 0);
+    etBigDivMod (& hiB, & loB, & V, & b36);
+    word36 hi = 0, lo = 0;
+    for (int i = hiB.n - 1; i >= 0; i --)
+      hi = hi * ET_BASE + hiB.l [i];
+    for (int i = loB.n - 1; i >= 0; i --)
+      lo = lo * ET_BASE + loB.l [i];
+    bool zero = hi == 0 && lo == 0;
+    if (a.neg)
+      {
+        hi = (~hi + (lo == 0)) & DMASK;
+        lo = (- lo) & DMASK;
+      }
+
+    etExpect * x = & t->x;
+    x->addr = ET_OP2;
+    x->cn = cn2;
+    x->sz = 9;
+    x->nchars = n2;
+    for (int i = 0; i < n2; i ++)
+      {
+        int byte = n2 - 1 - i;  // counting from the least significant
+        word36 w = byte < 4 ? lo : hi;
+        x->c [i] = (word9) ((w >> (9 * (byte % 4))) & 0777);
+      }
+    x->flags = (zero ? I_ZERO : 0) | (a.neg ? I_NEG : 0) | (ovf ? I_OFLOW : 0);
+    x->flagMask = I_ZERO | I_NEG | I_OFLOW;
+  }
+
+static void etMake (etCase * t, int op)
+  {
+    t->text [0] = 0;
+    // fill the scratch area so that stray stores show up
+    for (word18 a = ET_OP1; a < ET_END; a ++)
+      M [a] = ((word36) etRand (1U << 18) << 18) | etRand (1U << 18);
+
+    switch (op)
+      {
+        case ET_MVN:  etMakeMvn (t);  break;
+        case ET_CMPN: etMakeCmpn (t); break;
+        case ET_MVNE: etMakeMvne (t); break;
+        case ET_BTD:  etMakeBtd (t);  break;
+        case ET_DTB:  etMakeDtb (t);  break;
+        default:      etMakeArith (t, op); break;
+      }
+  }
+
+//
+// Execution
+//
+
+static void etLoad (const etCase * t)
+  {
+    M [ET_IC] = t->inst;
+    for (int i = 0; i < 3; i ++)
+      M [ET_IC + 1 + i] = t->desc [i];
+  }
+
+// Run the instruction at ET_IC; returns the fault taken, or -1
+static int etExecute (cpu_state_t * cpup)
+  {
+    cpu.PPR.IC     = ET_IC;
+    cpu.cu.IWB     = M [ET_IC] & DMASK;
+    cpu.cu.IRODD   = cpu.cu.IWB;
+    cpu.cu.rd      = 0;
+    cpu.cu.rfi     = 0;
+    cpu.isExec     = false;
+    cpu.isXED      = false;
+    cpu.cu.IR      = I_ABS | I_NBAR | I_OMASK;
+    cpu.cycle      = EXEC_cycle;
+
+    if (setjmp (cpu.jmpMain) == 0)
+      {
+        (void) executeInstruction (cpup);
+        return -1;
+      }
+    return (int) cpu.faultNumber;
+  }
+
+static void etReport (int op, const etCase * t, const char * what)
+  {
+    sim_printf ("  %s mismatch (%s): %012llo %012llo %012llo %012llo\r\n   %s\r\n",
+                etInstr [op].name, what, (unsigned long long) t->inst,
+                (unsigned long long) t->desc [0], (unsigned long long) t->desc [1],
+                (unsigned long long) t->desc [2], t->text);
+  }
+
+// Check the result of the last execution of t; M[] must still hold the
+// pre-execution image in snap.
+static bool etCheck (cpu_state_t * cpup, int op, const etCase * t, int fault, const word36 * snap,
+                     bool report)
+  {
+    const etExpect * x = & t->x;
+    if (fault != (int) x->fault)
+      {
+        if (report)
+          {
+            char buf [64];
+            (void) snprintf (buf, sizeof (buf), "fault %d/%llo, expected %d",
+                             fault, (unsigned long long) cpu.subFault.bits, (int) x->fault);
+            etReport (op, t, buf);
+          }
+        return false;
+      }
+    if (fault >= 0)
+      return true;
+
+    bool ok = (cpu.cu.IR & x->flagMask) == x->flags;
+    if (! ok && report)
+      {
+        char buf [64];
+        (void) snprintf (buf, sizeof (buf), "indicators %06llo, expected %06llo",
+                         (unsigned long long) (cpu.cu.IR & x->flagMask),
+                         (unsigned long long) x->flags);
+        etReport (op, t, buf);
+      }
+
+    // the destination characters, then everything else in the scratch area
+    word18 first = ET_OP1, last = ET_OP1;
+    if (x->nchars)
+      {
+        uint bit;
+        etCharPos (x->addr, x->cn, x->sz, 0, & first, & bit);
+        etCharPos (x->addr, x->cn, x->sz, x->nchars - 1, & last, & bit);
+        for (int i = 0; i < x->nchars; i ++)
+          {
+            word9 c = etGetChar (x->addr, x->cn, x->sz, i);
+            if (c != x->c [i])
+              {
+                if (ok && report)
+                  {
+                    char buf [64];
+                    (void) snprintf (buf, sizeof (buf), "char %d is %03o, expected %03o",
+                                     i, c, x->c [i]);
+                    etReport (op, t, buf);
+                  }
+                ok = false;
+                break;
+              }
+          }
+      }
+    int perWord = x->sz == 4 ? 8 : 4;
+    for (word18 a = ET_OP1; a < ET_END && ok; a ++)
+      {
+        word36 m = DMASK;
+        if (x->nchars && a >= first && a <= last)
+          {
+            // only the characters outside the field must be unchanged
+            for (int p = 0; p < perWord; p ++)
+              {
+                int i = (int) (a - x->addr) * perWord + p - x->cn;
+                if (i >= 0 && i < x->nchars)
+                  m &= ~(x->sz == 4 ? 017LLU << (32 - (9 * (p / 2) + 1 + 4 * (p % 2)))
+                                    : 0777LLU << (27 - 9 * p));
+              }
+          }
+        if (((M [a] ^ snap [a - ET_OP1]) & m) != 0)
+          {
+            if (report)
+              {
+                char buf [64];
+                (void) snprintf (buf, sizeof (buf), "stray store at %06o", a);
+                etReport (op, t, buf);
+              }
+            ok = false;
+          }
+      }
+    return ok;
+  }
+
+static double etNow (void)
+  {
+    struct timespec ts;
+#if defined(USE_MONOTONIC)
+    (void) clock_gettime (CLOCK_MONOTONIC, & ts);
+#else
+    (void) clock_gettime (CLOCK_REALTIME, & ts);
+#endif /* if defined(USE_MONOTONIC) */
+    return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+  }
+
+int eisTest (uint32_t cases, uint32_t seed)
+  {
+    // A CPU and memory like perfTest's, without the mlock
+#if !defined(_AIX)
+    system_state = aligned_malloc (sizeof (struct system_state_s));
+#else
+    system_state = malloc (sizeof (struct system_state_s));
+#endif
+    if (! system_state)
+      {
+        (void) fprintf (stderr, "\rFATAL: Out of memory! Aborting at %s[%s:%d]\r\n",
+                        __func__, __FILE__, __LINE__);
+        abort ();
+      }
+    M = system_state->M;
+#if defined(M_SHARED)
+    cpus = system_state->cpus;
+    scu  = system_state->scus;
+    (void) memset (scu, 0, sizeof (system_state->scus));
+#endif /* if defined(M_SHARED) */
+    (void) memset (cpus, 0, sizeof (cpu_state_t) * N_CPU_UNITS_MAX);
+    (void) memset ((void *) M, 0, ET_END * sizeof (word36));
+    opc_dev.numunits = 1;
+    cpu_reset_unit_idx (0, false);
+    _cpup = & cpus [0];
+    cpu_state_t * cpup = _cpup;
+
+    etSeed = (uint64_t) seed * 0x9E3779B97F4A7C15LLU + 1;
+    sim_printf ("EIS decimal test: %lu cases per instruction, seed %lu\r\n",
+                (unsigned long) cases, (unsigned long) seed);
+    sim_printf ("  %-5s %10s %10s %10s\r\n", "", "cases", "failed", "ns/inst");
+
+    static word36 snap [ET_END - ET_OP1];
+    static etCase bench [ET_BENCH_CASES];
+    unsigned long failures = 0;
+
+    for (int op = 0; op < ET_N; op ++)
+      {
+        unsigned long failed = 0;
+        for (uint32_t i = 0; i < cases; i ++)
+          {
+            etCase t;
+            etMake (& t, op);
+            etLoad (& t);
+            memcpy (snap, (const void *) (M + ET_OP1), sizeof (snap));
+            int fault = etExecute (cpup);
+            if (! etCheck (cpup, op, & t, fault, snap, failed < ET_MAX_REPORT))
+              failed ++;
+          }
+
+        // time a fixed set of cases that do not fault
+        double ns = 0;
+        unsigned long n = 0;
+        for (int i = 0; i < ET_BENCH_CASES; i ++)
+          {
+            do
+              etMake (& bench [i], op);
+            while (bench [i].x.fault != (_fault) -1);
+            etLoad (& bench [i]);
+            double t0 = etNow ();
+            for (int j = 0; j < ET_BENCH_REPS; j ++)
+              (void) etExecute (cpup);
+            ns += etNow () - t0;
+            n += ET_BENCH_REPS;
+          }
+
+        sim_printf ("  %-5s %10lu %10lu %10.1f\r\n", etInstr [op].name,
+                    (unsigned long) cases, failed, ns / (double) n);
+        failures += failed;
+      }
+
+    sim_printf ("EIS decimal test: %s\r\n", failures ? "FAILED" : "passed");
+    return failures ? 1 : 0;
+  }
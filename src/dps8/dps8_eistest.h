@@ -0,0 +1,21 @@
+/*
+ * vim: filetype=c:tabstop=4:ai:expandtab
+ * SPDX-License-Identifier: ICU
+ * scspell-id: 1c7a4132-cab3-11f1-9a6e-80ee73e9b8e7
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Copyright (c) 2026 The DPS8M Development Team
+ *
+ * This software is made available under the terms of the ICU License.
+ * See the LICENSE.md file at the top-level directory of this distribution.
+ *
+ * ---------------------------------------------------------------------------
+ */
+
+#if !defined(INCLUDED_DPS8_EISTEST_H)
+# define INCLUDED_DPS8_EISTEST_H
+
+int eisTest (uint32_t cases, uint32_t seed);
+
+#endif /* if !defined(INCLUDED_DPS8_EISTEST_H) */
@@ -930,16 +930,10 @@ void doG7Fault (cpu_state_t * cpup, bool allowTR)
       // }
     // According AL39,  Table 7-1. List of Faults, priority of connect is 25
     // and priority of Timer runout is 26, lower number means higher priority
-#if defined(THREADZ) || defined(LOCKLESS)
-    lock_scu ();
-#endif
      if (cpu.g7Faults & (1u << FAULT_CON))
        {
          cpu.g7Faults &= ~(1u << FAULT_CON);
 
-#if defined(THREADZ) || defined(LOCKLESS)
-         unlock_scu ();
-#endif
          doFault (FAULT_CON, fst_zero, "Connect");
        }
 
@@ -948,9 +942,6 @@ void doG7Fault (cpu_state_t * cpup, bool allowTR)
          cpu . g7Faults &= ~(1u << FAULT_TRO);
 
          //sim_printf("timer runout %12o\r\n",cpu.PPR.IC);
-#if defined(THREADZ) || defined(LOCKLESS)
-         unlock_scu ();
-#endif
          doFault (FAULT_TRO, fst_zero, "Timer runout");
        }
 
@@ -961,9 +952,6 @@ void doG7Fault (cpu_state_t * cpup, bool allowTR)
        {
          cpu . g7Faults &= ~(1u << FAULT_EXF);
 
-#if defined(THREADZ) || defined(LOCKLESS)
-         unlock_scu ();
-#endif
          doFault (FAULT_EXF, fst_zero, "Execute fault");
        }
 
@@ -971,31 +959,19 @@ void doG7Fault (cpu_state_t * cpup, bool allowTR)
        if (cpu.FFV_faults & 1u)  // FFV + 2 OC TRAP
          {
            cpu.FFV_faults &= ~1u;
-#if defined(THREADZ) || defined(LOCKLESS)
-           unlock_scu ();
-#endif
            do_FFV_fault (cpup, 1, "OC TRAP");
          }
        if (cpu.FFV_faults & 2u)  // FFV + 4 CU HISTORY OVERFLOW TRAP
          {
            cpu.FFV_faults &= ~2u;
-#if defined(THREADZ) || defined(LOCKLESS)
-           unlock_scu ();
-#endif
            do_FFV_fault (cpup, 2, "CU HIST OVF TRAP");
          }
        if (cpu.FFV_faults & 4u)  // FFV + 6 ADR TRAP
          {
            cpu.FFV_faults &= ~4u;
-#if defined(THREADZ) || defined(LOCKLESS)
-           unlock_scu ();
-#endif
            do_FFV_fault (cpup, 3, "ADR TRAP");
          }
      }
-#if defined(THREADZ) || defined(LOCKLESS)
-     unlock_scu ();
-#endif
      doFault (FAULT_TRB, (_fault_subtype) {.bits=cpu.g7Faults}, "Dazed and confused in doG7Fault");
   }
 
@@ -1006,7 +982,9 @@ void advanceG7Faults (cpu_state_t * cpup)
       return;
 
 #if defined(THREADZ) || defined(LOCKLESS)
-    lock_scu ();
+    // g7Faults and FFV_faults are only touched by this CPU; other threads
+    // post into g7FaultsPreset atomically (setG7fault), so no lock is
+    // needed here.
     uint zero = 0;
     //__atomic_exchange (& cpu.g7FaultsPreset, & zero, & cpu.g7Faults, __ATOMIC_ACQUIRE);
     cpu.g7Faults = atomic_exchange_explicit(&cpu.g7FaultsPreset, zero, memory_order_acquire);
@@ -1018,7 +996,4 @@ void advanceG7Faults (cpu_state_t * cpup)
       cpu.FFV_faults |= cpu.FFV_faults_preset;
       cpu.FFV_faults_preset = 0;
     )
-#if defined(THREADZ) || defined(LOCKLESS)
-    unlock_scu ();
-#endif
   }
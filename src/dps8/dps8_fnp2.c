@@ -123,6 +123,10 @@ static t_stat fnpSetConfig (UNIT * uptr, int value, const char * cptr, void * de
 static t_stat fnpShowStatus (FILE *st, UNIT *uptr, int val, const void *desc);
 static t_stat fnpShowNUnits (FILE *st, UNIT *uptr, int val, const void *desc);
 static t_stat fnpSetNUnits (UNIT * uptr, int32 value, const char * cptr, void * desc);
+static t_stat fnpShowNetThread (FILE *st, UNIT *uptr, int val, const void *desc);
+static t_stat fnpSetNetThread (UNIT * uptr, int32 value, const char * cptr, void * desc);
+static t_stat fnpShowOutputHWM (FILE *st, UNIT *uptr, int val, const void *desc);
+static t_stat fnpSetOutputHWM (UNIT * uptr, int32 value, const char * cptr, void * desc);
 static t_stat fnpShowIPCname (FILE *st, UNIT *uptr, int val, const void *desc);
 static t_stat fnpSetIPCname (UNIT * uptr, int32 value, const char * cptr, void * desc);
 static t_stat fnpShowService (FILE *st, UNIT *uptr, int val, const void *desc);
@@ -209,6 +213,26 @@ static MTAB fnpMod [] =
       "Number of FNP units in the system",  /* Value descriptor   */
       NULL                                  /* Help               */
     },
+    {
+      MTAB_dev_value,
+      0,                                    /* Match              */
+      "NETTHREAD",                          /* Print string       */
+      "NETTHREAD",                          /* Match string       */
+      fnpSetNetThread,                      /* Validation routine */
+      fnpShowNetThread,                     /* Display routine    */
+      "Service FNP network I/O from a dedicated thread", /* Value descriptor */
+      NULL                                  /* Help               */
+    },
+    {
+      MTAB_dev_value,
+      0,                                    /* Match              */
+      "OUTPUT_HWM",                         /* Print string       */
+      "OUTPUT_HWM",                         /* Match string       */
+      fnpSetOutputHWM,                      /* Validation routine */
+      fnpShowOutputHWM,                     /* Display routine    */
+      "Output backlog that holds send_output", /* Value descriptor */
+      NULL                                  /* Help               */
+    },
     {
       MTAB_unit_valr_nouc,
       0,                                    /* Match              */
@@ -340,11 +364,14 @@ void fnpInit(void)
       }
     fnpData.telnet_port     = 6180;
     fnpData.telnet3270_port = 3270;
+    fnpData.outputHWM       = OUTPUT_HWM;
     fnpTelnetInit ();
     fnp3270Init ();
   }
 
 void fnpExit (void) {
+  // The network thread must not run the loop while its handles are freed
+  fnpuvExit ();
   if (fnpData.telnet_address) {
     FREE (fnpData.telnet_address);
     fnpData.telnet_address = NULL;
@@ -398,6 +425,85 @@ static int findMbx (uint fnpUnitIdx)
     return -1;
   }
 
+//
+// Ready lines
+//
+// fnpProcessEvent() only visits lines flagged in their FNP's readyLines
+// bitmap. Code that posts work for a line (sets one of the request
+// flags, or fills inBuffer) calls fnpLineReady() afterwards; the event
+// loop keeps a line flagged until it has nothing left to do. As a
+// safety net, every line is visited once every FULL_SCAN_TICKS.
+//
+
+#define FULL_SCAN_TICKS 100  // ~1 second at 100Hz
+
+void fnpLineReady (struct t_line * linep)
+  {
+    for (uint fnpno = 0; fnpno < N_FNP_UNITS_MAX; fnpno ++)
+      {
+        struct t_line * line0 = fnpData.fnpUnitData[fnpno].MState.line;
+        if (linep >= line0 && linep < line0 + MAX_LINES)
+          {
+            uint lineno = (uint) (linep - line0);
+            fnpData.fnpUnitData[fnpno].readyLines[lineno / 64] |= (uint64) 1 << (lineno % 64);
+            return;
+          }
+      }
+  }
+
+// Does the line have pending requests or unprocessed input?
+static bool lineBusy (struct t_line * linep)
+  {
+    return linep->send_output || linep->accept_new_terminal ||
+           linep->line_disconnected || linep->ack_echnego_init ||
+           linep->ack_echnego_stop || linep->acu_dial_failure ||
+           linep->sendLineStatus || linep->wru_timeout ||
+           linep->accept_input || linep->line_break || linep->inBuffer;
+  }
+
+// Claim the set of ready lines of an FNP
+static void takeReadyLines (uint fnpno, uint64 * ready)
+  {
+    struct fnpUnitData_s * fudp = & fnpData.fnpUnitData[fnpno];
+    for (uint w = 0; w < READY_WORDS; w ++)
+      {
+#if defined(THREADZ) || defined(LOCKLESS)
+        ready[w] = atomic_exchange (& fudp->readyLines[w], 0);
+#else
+        ready[w] = fudp->readyLines[w];
+        fudp->readyLines[w] = 0;
+#endif
+      }
+  }
+
+// Put back the claimed lines that still have work
+static void requeueReadyLines (uint fnpno, uint64 * ready)
+  {
+    struct fnpUnitData_s * fudp = & fnpData.fnpUnitData[fnpno];
+    for (uint w = 0; w < READY_WORDS; w ++)
+      for (uint64 bits = ready[w]; bits; bits &= bits - 1)
+        {
+          uint lineno = w * 64 + (uint) __builtin_ctzll (bits);
+          if (lineBusy (& fudp->MState.line[lineno]))
+            fudp->readyLines[w] |= (uint64) 1 << (lineno % 64);
+        }
+  }
+
+// Next claimed line after lineno, or -1
+static int nextReadyLine (const uint64 * ready, int lineno)
+  {
+    uint next = (uint) (lineno + 1);
+    for (uint w = next / 64; w < READY_WORDS; w ++)
+      {
+        uint64 bits = ready[w];
+        if (w == next / 64)
+          bits &= ~(uint64) 0 << (next % 64);
+        if (bits)
+          return (int) (w * 64 + (uint) __builtin_ctzll (bits));
+      }
+    return -1;
+  }
+
 static void notifyCS (uint mbx, int fnp_unit_idx, int lineno)
   {
 #if defined(TESTING)
@@ -1268,14 +1374,15 @@ static void fnpProcessBuffer (struct t_line * linep)
        }
   }
 
-static void fnpProcessBuffers (void)
+static void fnpProcessBuffers (uint64 ready [N_FNP_UNITS_MAX] [READY_WORDS])
   {
     uint numunits = (uint) fnp_dev.numunits;
     for (uint fnp_unit_idx = 0; fnp_unit_idx < numunits; fnp_unit_idx ++)
       {
         if (! fnpData.fnpUnitData[fnp_unit_idx].fnpIsRunning)
           continue;
-        for (uint lineno = 0; lineno < MAX_LINES; lineno ++)
+        for (int lineno = nextReadyLine (ready[fnp_unit_idx], -1); lineno >= 0;
+             lineno = nextReadyLine (ready[fnp_unit_idx], lineno))
           {
             struct t_line * linep = & fnpData.fnpUnitData[fnp_unit_idx].MState.line[lineno];
 
@@ -1362,6 +1469,7 @@ sim_printf ("\r\n");
     linep->force_accept_input = true;
     linep->accept_input       = 1;
     linep->input_break        = brk ? 1 : 0;
+    fnpLineReady (linep);
   }
 
 const unsigned char addr_map [ADDR_MAP_ENTRIES] =
@@ -1457,6 +1565,7 @@ static void send_stn_in_buffer (void)
         linep->force_accept_input = true;
         linep->accept_input       = 1;
         linep->nPos               = sz;
+        fnpLineReady (linep);
       }
 #if 0
     else
@@ -1489,6 +1598,7 @@ static void fnp_process_3270_event (void)
         linep->lineStatus0                          = 6llu << 18; // IBM3270_WRITE_COMPLETE
         linep->lineStatus1                          = 0;
         linep->sendLineStatus                       = true;
+        fnpLineReady (linep);
       }
 
 // Polling events
@@ -1543,7 +1653,12 @@ static void fnp_process_3270_event (void)
 // Called @ 100Hz to process FNP background events
 //
 
-void fnpProcessEvent (void)
+// 'tick' is true when called from the sys_poll_interval timer; the delay
+// counters (send_output, DISC_DELAY) and the TUN/3270 pollers are only
+// advanced then. The network thread calls with 'tick' false to deliver
+// input and post requests as soon as the data arrives.
+
+static void fnpProcess (bool tick)
   {
 #if defined(TESTING)
     cpu_state_t * cpup = _cpup;
@@ -1552,13 +1667,33 @@ void fnpProcessEvent (void)
     // Handles tcp connections, drops, read data, write data done.
     fnpuvProcessEvent ();
 
+    // Claim the lines that have work pending
+    uint64 ready [N_FNP_UNITS_MAX] [READY_WORDS];
+    uint numunits = (uint) fnp_dev.numunits;
+    bool fullScan = false;
+    if (tick)
+      {
+        fullScan = fnpData.fullScanTicks == 0;
+        if (fullScan)
+          fnpData.fullScanTicks = FULL_SCAN_TICKS;
+        fnpData.fullScanTicks --;
+      }
+    for (uint fnp_unit_idx = 0; fnp_unit_idx < numunits; fnp_unit_idx ++)
+      {
+        takeReadyLines (fnp_unit_idx, ready[fnp_unit_idx]);
+        if (fullScan)
+          (void)memset (ready[fnp_unit_idx], 0xff, sizeof (ready[fnp_unit_idx]));
+#if MAX_LINES % 64
+        ready[fnp_unit_idx][READY_WORDS - 1] &= ((uint64) 1 << (MAX_LINES % 64)) - 1;
+#endif
+      }
+
     // Move characters from inBuffer to buffer, based on line discipline
     // and data availability
 
-    fnpProcessBuffers ();
+    fnpProcessBuffers (ready);
 
     // Look for posted requests
-    uint numunits = (uint) fnp_dev.numunits;
     for (uint fnp_unit_idx = 0; fnp_unit_idx < numunits; fnp_unit_idx ++)
       {
         if (! fnpData.fnpUnitData[fnp_unit_idx].fnpIsRunning)
@@ -1567,13 +1702,14 @@ void fnpProcessEvent (void)
         if (mbx == -1)
           continue;
         bool need_intr = false;
-        for (int lineno = 0; lineno < MAX_LINES; lineno ++)
+        for (int lineno = nextReadyLine (ready[fnp_unit_idx], -1); lineno >= 0;
+             lineno = nextReadyLine (ready[fnp_unit_idx], lineno))
           {
             struct t_line * linep = & fnpData.fnpUnitData[fnp_unit_idx].MState.line[lineno];
 
 #if defined(DISC_DELAY)
             // Disconnect pending?
-            if (linep -> line_disconnected > 1)
+            if (tick && linep -> line_disconnected > 1)
               {
                 // Buffer not empty?
                 if (linep->inBuffer && linep->inUsed < linep->inSize)
@@ -1593,11 +1729,19 @@ void fnpProcessEvent (void)
             if (linep->waitForMbxDone)
               continue;
 
+            // A line_break queued behind pending input must wait for the
+            // accept_input countdown, which only runs on the tick.
+            if (! tick && linep->accept_input > 1)
+              continue;
+
             // Need to send a 'send_output' command to CS?
 
             bool do_send_output = linep->send_output == 1;
 
-            if (linep -> send_output > 0)
+            // Hold it while the connection has a backlog of output
+            if (do_send_output && fnpuv_output_backlogged (linep->line_client))
+              do_send_output = false;
+            else if (linep -> send_output > 0 && (tick || do_send_output))
                 linep->send_output --;
 
             if (do_send_output)
@@ -1787,12 +1931,31 @@ void fnpProcessEvent (void)
           }
       } // for fnp_unit_idx
 
+    // Lines with work left (timers running, mailbox busy) stay ready
+    for (uint fnp_unit_idx = 0; fnp_unit_idx < numunits; fnp_unit_idx ++)
+      requeueReadyLines (fnp_unit_idx, ready[fnp_unit_idx]);
+
+    if (! tick)
+      return;
+
 #if defined(TUN)
     fnpTUNProcessEvent ();
 #endif /* if defined(TUN) */
     fnp_process_3270_event ();
   }
 
+void fnpProcessEvent (void)
+  {
+    fnpProcess (true);
+  }
+
+#if defined(FNP_NET_THREAD)
+void fnpProcessNetEvent (void)
+  {
+    fnpProcess (false);
+  }
+#endif /* if defined(FNP_NET_THREAD) */
+
 static t_stat fnpShowNUnits (UNUSED FILE * st, UNUSED UNIT * uptr,
                              UNUSED int val, UNUSED const void * desc)
   {
@@ -1813,6 +1976,68 @@ static t_stat fnpSetNUnits (UNUSED UNIT * uptr, UNUSED int32 value,
     return SCPE_OK;
   }
 
+static t_stat fnpShowNetThread (UNUSED FILE * st, UNUSED UNIT * uptr,
+                                UNUSED int val, UNUSED const void * desc)
+  {
+    sim_printf ("FNP network thread is %s\r\n",
+                fnpData.netThread ? "enabled" : "disabled");
+    return SCPE_OK;
+  }
+
+static t_stat fnpSetNetThread (UNUSED UNIT * uptr, UNUSED int32 value,
+                               const char * cptr, UNUSED void * desc)
+  {
+    if (! cptr)
+      return SCPE_ARG;
+    bool enable;
+    if (strcasecmp (cptr, "ENABLE") == 0 || strcasecmp (cptr, "ON") == 0)
+      enable = true;
+    else if (strcasecmp (cptr, "DISABLE") == 0 || strcasecmp (cptr, "OFF") == 0)
+      enable = false;
+    else
+      return SCPE_ARG;
+#if defined(FNP_NET_THREAD)
+    // The thread owns the FNP loop; the choice is fixed once it exists.
+    if (fnpData.loop && enable != fnpData.netThread)
+      {
+        sim_printf ("FNP network thread must be set before FNPSTART\r\n");
+        return SCPE_INCOMP;
+      }
+    fnpData.netThread = enable;
+    return SCPE_OK;
+#else
+    if (enable)
+      {
+        sim_printf ("FNP network thread is not supported in this build\r\n");
+        return SCPE_NOFNC;
+      }
+    return SCPE_OK;
+#endif /* if defined(FNP_NET_THREAD) */
+  }
+
+static t_stat fnpShowOutputHWM (UNUSED FILE * st, UNUSED UNIT * uptr,
+                                UNUSED int val, UNUSED const void * desc)
+  {
+    if (fnpData.outputHWM)
+      sim_printf ("FNP output high-water mark is %u bytes\r\n", fnpData.outputHWM);
+    else
+      sim_printf ("FNP output high-water mark is disabled\r\n");
+    return SCPE_OK;
+  }
+
+static t_stat fnpSetOutputHWM (UNUSED UNIT * uptr, UNUSED int32 value,
+                               const char * cptr, UNUSED void * desc)
+  {
+    if (! cptr)
+      return SCPE_ARG;
+    char * end;
+    unsigned long n = strtoul (cptr, & end, 0);
+    if (end == cptr || * end || n > 16777216)
+      return SCPE_ARG;
+    fnpData.outputHWM = (uint) n;
+    return SCPE_OK;
+  }
+
 static t_stat fnpShowIPCname (UNUSED FILE * st, UNIT * uptr,
                               UNUSED int val, UNUSED const void * desc)
   {
@@ -2732,6 +2957,7 @@ void processLineInput (uv_tcp_t * client, unsigned char * buf, ssize_t nread)
         linep->inSize = (uint) nread;
         linep->inUsed = 0;
       }
+    fnpLineReady (linep);
 
 done:;
     // Prevent further reading until this buffer is consumed
@@ -3066,6 +3292,7 @@ associate:;
       fnpData.fnpUnitData[fnp_unit_idx].MState.line[lineno].lineType = 1; /* LINE_ASCII */
     fnpData.fnpUnitData[fnp_unit_idx].MState.line[lineno].accept_new_terminal = true;
     reset_line (& fnpData.fnpUnitData[fnp_unit_idx].MState.line[lineno]);
+    fnpLineReady (& fnpData.fnpUnitData[fnp_unit_idx].MState.line[lineno]);
   }
 
 void startFNPListener (void)
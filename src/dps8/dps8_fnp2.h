@@ -29,6 +29,19 @@ extern UNIT fnp_unit [N_FNP_UNITS_MAX];
 extern DEVICE fnp_dev;
 
 #define MAX_LINES  96  /*  max number of FNP lines - hardware  */
+#define READY_WORDS ((MAX_LINES + 63) / 64)
+
+// Default bytes of unsent output on a connection above which send_output
+// is withheld; see fnpuv_output_backlogged(). 0 disables.
+#define OUTPUT_HWM 8192
+
+// The FNP event loop can be serviced from its own thread when the
+// libuv backend exposes a pollable descriptor.
+#if (defined(THREADZ) || defined(LOCKLESS)) && \
+    !defined(__MINGW32__) && !defined(__MINGW64__) && \
+    !defined(CROSS_MINGW32) && !defined(CROSS_MINGW64)
+# define FNP_NET_THREAD
+#endif
 
 //
 // MState_t state of an FNP
@@ -215,6 +228,8 @@ struct fnpUnitData_s
     bool lineWaiting [4]; // If set, fnpMBXlineno is waiting for the mailbox to be marked clear.
     int fnpMBXlineno [4]; // Which HSLA line is using the mbx
     char ipcName [MAX_DEV_NAME_LEN];
+    // Lines with pending work; see fnpLineReady()
+    volAtomic uint64 readyLines [READY_WORDS];
 
     t_MState MState;
   };
@@ -232,6 +247,9 @@ typedef struct s_fnpData
     uv_tcp_t du3270_server;
     bool du3270_server_inited;
     int du3270_poll;
+    uint fullScanTicks; // Ticks until every line is visited regardless
+    bool netThread;     // Service the event loop from its own thread
+    uint outputHWM;     // Hold send_output above this many queued bytes
   } t_fnpData;
 
 extern t_fnpData fnpData;
@@ -332,6 +350,10 @@ void fnpExit (void);
 int lookupFnpsIomUnitNumber (int fnpUnitNum);
 int lookupFnpLink (int fnpUnitNum);
 void fnpProcessEvent (void);
+#if defined(FNP_NET_THREAD)
+void fnpProcessNetEvent (void);
+#endif /* if defined(FNP_NET_THREAD) */
+void fnpLineReady (struct t_line * linep);
 t_stat diaCommand (int fnpUnitNum, char *arg3);
 void fnpToCpuQueueMsg (int fnpUnitNum, char * msg);
 iom_cmd_rc_t fnp_iom_cmd (uint iomUnitIdx, uint chan);
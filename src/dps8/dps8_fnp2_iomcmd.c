@@ -185,6 +185,7 @@ static int wcd (struct decoded_t *decoded_p)
             linep -> line_disconnected = true;
 #endif
             linep -> listen = false;
+            fnpLineReady (linep);
             if (linep->line_client)
               {
                 close_connection ((uv_stream_t *) linep->line_client);
@@ -582,6 +583,7 @@ static int wcd (struct decoded_t *decoded_p)
             linep->echnego_on = false;
             // Post a ack echnego stop to MCS
             linep->ack_echnego_stop = true;
+            fnpLineReady (linep);
           }
           break;
 
@@ -604,6 +606,7 @@ static int wcd (struct decoded_t *decoded_p)
 
             // Post a ack echnego init to MCS
             linep->ack_echnego_init = true;
+            fnpLineReady (linep);
           }
           break;
 
@@ -731,6 +734,7 @@ static int wcd (struct decoded_t *decoded_p)
                     // XXX ignored
                     //linep -> send_output = true;
                     linep -> send_output = SEND_OUTPUT_DELAY;
+                    fnpLineReady (linep);
                   }
                   break;
 
@@ -792,6 +796,7 @@ static int wcd (struct decoded_t *decoded_p)
                     sim_debug (DBG_TRACE, & fnp_dev, "[%u]        alter_parameters wru\r\n",
                                decoded_p->slot_no);
                     linep -> wru_timeout = true;
+                    fnpLineReady (linep);
                   }
                   break;
 
@@ -1289,6 +1294,7 @@ static int wtx (struct decoded_t *decoded_p)
 #else
     decoded_p->fudp->MState.line[decoded_p->slot_no].send_output = SEND_OUTPUT_DELAY;
 #endif
+    fnpLineReady (& decoded_p->fudp->MState.line[decoded_p->slot_no]);
     return 0;
   }
 
@@ -1541,6 +1547,7 @@ static int interruptL66_FNP_to_CS (struct decoded_t *decoded_p)
 // For some reason the CS ack of accept_new_terminal is not being seen, causing the line to wedge.
 // Since a terminal accepted command always follows, clear the wedge here
                     decoded_p->fudp->MState.line[decoded_p->slot_no].waitForMbxDone = false;
+                    fnpLineReady (& decoded_p->fudp->MState.line[decoded_p->slot_no]);
                   }
                   break;
 
@@ -1558,6 +1565,7 @@ sim_printf ("reject_request_temp\r\n");
                     //sim_printf ("fnp reject_request_temp\r\n");
                     // Retry in one second;
                     decoded_p->fudp->MState.line[decoded_p->slot_no].accept_input = 100;
+                    fnpLineReady (& decoded_p->fudp->MState.line[decoded_p->slot_no]);
                   }
                   break;
 
@@ -1789,6 +1797,7 @@ static void fnpcmdBootload (uint devUnitIdx)
                 if (fnpData.fnpUnitData[devUnitIdx].MState.line[lineno].lineType == 0) /* LINE_NONE */
                   fnpData.fnpUnitData[devUnitIdx].MState.line[lineno].lineType = 7; /* LINE_BSC */
                 fnpData.fnpUnitData[devUnitIdx].MState.line[lineno].accept_new_terminal = true;
+                fnpLineReady (& fnpData.fnpUnitData[devUnitIdx].MState.line[lineno]);
               }
           }
       }
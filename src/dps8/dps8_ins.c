@@ -96,6 +96,11 @@ static word36 barrelRightMaskTable[37] = {
 # define BS_COMPL(HI) ((~(HI)) & MASK36)
 #endif // BARREL_SHIFTER
 
+// Threaded dispatch needs the GNU labels-as-values extension
+#if defined(THREADED_DISPATCH) && !defined(__GNUC__)
+# undef THREADED_DISPATCH
+#endif
+
 #if defined(LOOPTRC)
 void elapsedtime (void)
   {
@@ -1179,6 +1184,9 @@ void fetchInstruction (cpu_state_t * cpup, word18 addr)
                 cpu.cu.IWB = tmp[0];
                 cpu.cu.IRODD = tmp[1];
               }
+#if defined(DECODE_CACHE)
+            cpu.dicAddress = cpu.iefpFinalAddress;
+#endif /* if defined(DECODE_CACHE) */
           }
       }
     else
@@ -1205,6 +1213,10 @@ void fetchInstruction (cpu_state_t * cpup, word18 addr)
             ReadInstructionFetch (cpup, addr, & cpu.cu.IWB);
             cpu.cu.IRODD = cpu.cu.IWB;
           }
+#if defined(DECODE_CACHE)
+        // Remember where the instruction came from for the decode cache
+        cpu.dicAddress = cpu.iefpFinalAddress;
+#endif /* if defined(DECODE_CACHE) */
       }
 }
 
@@ -1428,7 +1440,12 @@ t_stat executeInstruction (cpu_state_t * cpup) {
 ///
 
   DCDstruct * ci = & cpu.currentInstruction;
+#if defined(DECODE_CACHE)
+  decode_instruction_cached (cpup, IWB_IRODD,
+                             (cpu.dicAddress | (cpu.PPR.IC & 1)) & MASK24, ci);
+#else
   decode_instruction (cpup, IWB_IRODD, ci);
+#endif /* if defined(DECODE_CACHE) */
   const struct opcode_s *info = ci->info;
 
 // Local caches of frequently accessed data
@@ -2396,8 +2413,15 @@ HOT static t_stat doInstruction (cpu_state_t * cpup)
     memcpy (& cpu.MR_cache, & cpu.MR, sizeof (cpu.MR_cache));
 
 // This mapping keeps nonEIS/EIS ordering, making various tables cleaner
-#define x0(n) (n)
-#define x1(n) (n|01000)
+#if defined(THREADED_DISPATCH)
+// Each case label also gets an ordinary label so that the dispatch
+// table below can jump straight to it.
+# define x0(n) (n): op_x0_##n
+# define x1(n) (n|01000): op_x1_##n
+#else
+# define x0(n) (n)
+# define x1(n) (n|01000)
+#endif /* if defined(THREADED_DISPATCH) */
 
     //t_stat ret =  i->opcodeX ? DoEISInstruction () : DoBasicInstruction ();
     uint32 opcode10 = i->opcode10;
@@ -2441,6 +2465,19 @@ HOT static t_stat doInstruction (cpu_state_t * cpup)
       }
     }
 
+#if defined(THREADED_DISPATCH)
+    // Opcodes not in the table go through the switch as usual.
+    static const void * const dispatchTable [02000] =
+      {
+        [0 ... 01777] = && dispatchSwitch,
+# define DISPATCH_OP(x, n) [(n) | ((x) ? 01000 : 0)] = && op_x##x##_##n,
+# include "dps8_ins_dispatch.h"
+# undef DISPATCH_OP
+      };
+    goto * dispatchTable [opcode10 & 01777];
+dispatchSwitch:;
+#endif /* if defined(THREADED_DISPATCH) */
+
     switch (opcode10)
       {
 // Operations sorted by frequency of use; should help with caching issues
@@ -7655,6 +7692,9 @@ elapsedtime ();
                 cpu.PTWAM[m].PAGENO  = getbits36_12 (cpu.Yblock16[i], 15);
                 cpu.PTWAM[m].FE      = getbits36_1  (cpu.Yblock16[i], 27);
               }
+            // The loaded keys may be duplicated; drop the lookup hints so
+            // that the scan order decides which register matches.
+            (void)memset (cpu.PTWAMhint, 0, sizeof (cpu.PTWAMhint));
           }
           break;
 
@@ -7698,6 +7738,9 @@ elapsedtime ();
                 cpu.SDWAM[m].POINTER = getbits36_15 (cpu.Yblock16[i],  0);
                 cpu.SDWAM[m].FE      = getbits36_1  (cpu.Yblock16[i], 27);
               }
+            // The loaded keys may be duplicated; drop the lookup hints so
+            // that the scan order decides which register matches.
+            (void)memset (cpu.SDWAMhint, 0, sizeof (cpu.SDWAMhint));
           }
           break;
 
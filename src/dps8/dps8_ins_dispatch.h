@@ -0,0 +1,576 @@
+/*
+ * vim: filetype=c:tabstop=4:ai:expandtab
+ * SPDX-License-Identifier: ICU
+ * scspell-id: 216050ea-ca99-11f1-adfc-02fc00000001
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Copyright (c) 2026 The DPS8M Development Team
+ *
+ * This software is made available under the terms of the ICU License.
+ * See the LICENSE.md file at the top-level directory of this distribution.
+ *
+ * ---------------------------------------------------------------------------
+ */
+
+// Threaded dispatch table entries for doInstruction (THREADED_DISPATCH)
+//
+// One DISPATCH_OP (x, n) per "case xX (n):" label in the doInstruction
+// switch, in the same order.  An opcode missing from this list is still
+// executed correctly (it is dispatched through the switch); a list entry
+// without a matching case label is a compile error.
+//
+// Regenerate after adding or removing instructions by running
+//
+//   sed -n 's/^        case x\([01]\) (\(0[0-7]*\)):.*/DISPATCH_OP (\1, \2)/p'
+//
+// over dps8_ins.c and re-adding the mnemonic comments.
+
+DISPATCH_OP (0, 0350) // epp0
+DISPATCH_OP (1, 0351) // epp1
+DISPATCH_OP (0, 0352) // epp2
+DISPATCH_OP (1, 0353) // epp3
+DISPATCH_OP (0, 0370) // epp4
+DISPATCH_OP (1, 0371) // epp5
+DISPATCH_OP (0, 0372) // epp6
+DISPATCH_OP (1, 0373) // epp7
+DISPATCH_OP (0, 0250) // spri0
+DISPATCH_OP (1, 0251) // spri1
+DISPATCH_OP (0, 0252) // spri2
+DISPATCH_OP (1, 0253) // spri3
+DISPATCH_OP (0, 0650) // spri4
+DISPATCH_OP (1, 0651) // spri5
+DISPATCH_OP (0, 0652) // spri6
+DISPATCH_OP (1, 0653) // spri7
+DISPATCH_OP (0, 0235) // lda
+DISPATCH_OP (0, 0710) // tra
+DISPATCH_OP (0, 0236) // ldq
+DISPATCH_OP (0, 0600) // tze
+DISPATCH_OP (0, 0601) // tnz
+DISPATCH_OP (0, 0756) // stq
+DISPATCH_OP (0, 0116) // cmpq
+DISPATCH_OP (0, 0377) // < anaq
+DISPATCH_OP (0, 0755) // sta
+DISPATCH_OP (0, 0760) // lprp0
+DISPATCH_OP (0, 0761) // lprp1
+DISPATCH_OP (0, 0762) // lprp2
+DISPATCH_OP (0, 0763) // lprp3
+DISPATCH_OP (0, 0764) // lprp4
+DISPATCH_OP (0, 0765) // lprp5
+DISPATCH_OP (0, 0766) // lprp6
+DISPATCH_OP (0, 0767) // lprp7
+DISPATCH_OP (0, 0620) // eax0
+DISPATCH_OP (0, 0621) // eax1
+DISPATCH_OP (0, 0622) // eax2
+DISPATCH_OP (0, 0623) // eax3
+DISPATCH_OP (0, 0624) // eax4
+DISPATCH_OP (0, 0625) // eax5
+DISPATCH_OP (0, 0626) // eax6
+DISPATCH_OP (0, 0627) // eax7
+DISPATCH_OP (0, 0700) // tsx0
+DISPATCH_OP (0, 0701) // tsx1
+DISPATCH_OP (0, 0702) // tsx2
+DISPATCH_OP (0, 0703) // tsx3
+DISPATCH_OP (0, 0704) // tsx4
+DISPATCH_OP (0, 0705) // tsx5
+DISPATCH_OP (0, 0706) // tsx6
+DISPATCH_OP (0, 0707) // tsx7
+DISPATCH_OP (0, 0450) // stz
+DISPATCH_OP (1, 0350) // epbp0
+DISPATCH_OP (0, 0351) // epbp1
+DISPATCH_OP (1, 0352) // epbp2
+DISPATCH_OP (0, 0353) // epbp3
+DISPATCH_OP (1, 0370) // epbp4
+DISPATCH_OP (0, 0371) // epbp5
+DISPATCH_OP (1, 0372) // epbp6
+DISPATCH_OP (0, 0373) // epbp7
+DISPATCH_OP (0, 0115) // cmpa
+DISPATCH_OP (0, 0054) // aos
+DISPATCH_OP (0, 0315) // cana
+DISPATCH_OP (0, 0237) // ldaq
+DISPATCH_OP (1, 0605) // tpnz
+DISPATCH_OP (0, 0720) // lxl0
+DISPATCH_OP (0, 0721) // lxl1
+DISPATCH_OP (0, 0722) // lxl2
+DISPATCH_OP (0, 0723) // lxl3
+DISPATCH_OP (0, 0724) // lxl4
+DISPATCH_OP (0, 0725) // lxl5
+DISPATCH_OP (0, 0726) // lxl6
+DISPATCH_OP (0, 0727) // lxl7
+DISPATCH_OP (0, 0757) // staq
+DISPATCH_OP (0, 0270) // tsp0
+DISPATCH_OP (0, 0271) // tsp1
+DISPATCH_OP (0, 0272) // tsp2
+DISPATCH_OP (0, 0273) // tsp3
+DISPATCH_OP (0, 0670) // tsp4
+DISPATCH_OP (0, 0671) // tsp5
+DISPATCH_OP (0, 0672) // tsp6
+DISPATCH_OP (0, 0673) // tsp7
+DISPATCH_OP (0, 0735) // als
+DISPATCH_OP (0, 0610) // rtcd
+DISPATCH_OP (0, 0604) // tmi
+DISPATCH_OP (0, 0740) // stx0
+DISPATCH_OP (0, 0741) // stx1
+DISPATCH_OP (0, 0742) // stx2
+DISPATCH_OP (0, 0743) // stx3
+DISPATCH_OP (0, 0744) // stx4
+DISPATCH_OP (0, 0745) // stx5
+DISPATCH_OP (0, 0746) // stx6
+DISPATCH_OP (0, 0747) // stx7
+DISPATCH_OP (0, 0634) // ldi
+DISPATCH_OP (0, 0677) // eraq
+DISPATCH_OP (0, 0275) // ora
+DISPATCH_OP (0, 0076) // adq
+DISPATCH_OP (1, 0604) // tmoz
+DISPATCH_OP (1, 0250) // spbp0
+DISPATCH_OP (0, 0251) // spbp1
+DISPATCH_OP (1, 0252) // spbp2
+DISPATCH_OP (0, 0253) // spbp3
+DISPATCH_OP (1, 0650) // spbp4
+DISPATCH_OP (0, 0651) // spbp5
+DISPATCH_OP (1, 0652) // spbp6
+DISPATCH_OP (0, 0653) // spbp7
+DISPATCH_OP (0, 0375) // ana
+DISPATCH_OP (0, 0431) // fld
+DISPATCH_OP (0, 0213) // epaq
+DISPATCH_OP (0, 0736) // qls
+DISPATCH_OP (0, 0754) // sti
+DISPATCH_OP (0, 0635) // eaa
+DISPATCH_OP (0, 0636) // eaq
+DISPATCH_OP (0, 0335) // lca
+DISPATCH_OP (0, 0336) // lcq
+DISPATCH_OP (0, 0320) // lcx0
+DISPATCH_OP (0, 0321) // lcx1
+DISPATCH_OP (0, 0322) // lcx2
+DISPATCH_OP (0, 0323) // lcx3
+DISPATCH_OP (0, 0324) // lcx4
+DISPATCH_OP (0, 0325) // lcx5
+DISPATCH_OP (0, 0326) // lcx6
+DISPATCH_OP (0, 0327) // lcx7
+DISPATCH_OP (0, 0337) // lcaq
+DISPATCH_OP (0, 0034) // ldac
+DISPATCH_OP (0, 0032) // ldqc
+DISPATCH_OP (0, 0220) // ldx0
+DISPATCH_OP (0, 0221) // ldx1
+DISPATCH_OP (0, 0222) // ldx2
+DISPATCH_OP (0, 0223) // ldx3
+DISPATCH_OP (0, 0224) // ldx4
+DISPATCH_OP (0, 0225) // ldx5
+DISPATCH_OP (0, 0226) // ldx6
+DISPATCH_OP (0, 0227) // ldx7
+DISPATCH_OP (0, 0073) // lreg
+DISPATCH_OP (0, 0753) // sreg
+DISPATCH_OP (0, 0354) // stac
+DISPATCH_OP (0, 0654) // stacq
+DISPATCH_OP (0, 0551) // stba
+DISPATCH_OP (0, 0552) // stbq
+DISPATCH_OP (0, 0554) // stc1
+DISPATCH_OP (0, 0750) // stc2
+DISPATCH_OP (0, 0751) // stca
+DISPATCH_OP (0, 0752) // stcq
+DISPATCH_OP (0, 0357) // < stcd
+DISPATCH_OP (0, 0454) // stt
+DISPATCH_OP (0, 0440) // sxl0
+DISPATCH_OP (0, 0441) // sxl1
+DISPATCH_OP (0, 0442) // sxl2
+DISPATCH_OP (0, 0443) // sxl3
+DISPATCH_OP (0, 0444) // sxl4
+DISPATCH_OP (0, 0445) // sxl5
+DISPATCH_OP (0, 0446) // sxl6
+DISPATCH_OP (0, 0447) // sxl7
+DISPATCH_OP (0, 0775) // alr
+DISPATCH_OP (0, 0771) // arl
+DISPATCH_OP (0, 0731) // ars
+DISPATCH_OP (0, 0777) // llr
+DISPATCH_OP (0, 0737) // lls
+DISPATCH_OP (0, 0773) // lrl
+DISPATCH_OP (0, 0733) // lrs
+DISPATCH_OP (0, 0776) // qlr
+DISPATCH_OP (0, 0772) // qrl
+DISPATCH_OP (0, 0732) // qrs
+DISPATCH_OP (0, 0075) // ada
+DISPATCH_OP (0, 0077) // adaq
+DISPATCH_OP (0, 0033) // adl
+DISPATCH_OP (0, 0037) // adlaq
+DISPATCH_OP (0, 0035) // adla
+DISPATCH_OP (0, 0036) // adlq
+DISPATCH_OP (0, 0020) // adlx0
+DISPATCH_OP (0, 0021) // adlx1
+DISPATCH_OP (0, 0022) // adlx2
+DISPATCH_OP (0, 0023) // adlx3
+DISPATCH_OP (0, 0024) // adlx4
+DISPATCH_OP (0, 0025) // adlx5
+DISPATCH_OP (0, 0026) // adlx6
+DISPATCH_OP (0, 0027) // adlx7
+DISPATCH_OP (0, 0060) // adx0
+DISPATCH_OP (0, 0061) // adx1
+DISPATCH_OP (0, 0062) // adx2
+DISPATCH_OP (0, 0063) // adx3
+DISPATCH_OP (0, 0064) // adx4
+DISPATCH_OP (0, 0065) // adx5
+DISPATCH_OP (0, 0066) // adx6
+DISPATCH_OP (0, 0067) // adx7
+DISPATCH_OP (0, 0055) // asa
+DISPATCH_OP (0, 0056) // asq
+DISPATCH_OP (0, 0040) // asx0
+DISPATCH_OP (0, 0041) // asx1
+DISPATCH_OP (0, 0042) // asx2
+DISPATCH_OP (0, 0043) // asx3
+DISPATCH_OP (0, 0044) // asx4
+DISPATCH_OP (0, 0045) // asx5
+DISPATCH_OP (0, 0046) // asx6
+DISPATCH_OP (0, 0047) // asx7
+DISPATCH_OP (0, 0071) // awca
+DISPATCH_OP (0, 0072) // awcq
+DISPATCH_OP (0, 0175) // sba
+DISPATCH_OP (0, 0177) // sbaq
+DISPATCH_OP (0, 0135) // sbla
+DISPATCH_OP (0, 0137) // sblaq
+DISPATCH_OP (0, 0136) // sblq
+DISPATCH_OP (0, 0120) // sblx0
+DISPATCH_OP (0, 0121) // sblx1
+DISPATCH_OP (0, 0122) // sblx2
+DISPATCH_OP (0, 0123) // sblx3
+DISPATCH_OP (0, 0124) // sblx4
+DISPATCH_OP (0, 0125) // sblx5
+DISPATCH_OP (0, 0126) // sblx6
+DISPATCH_OP (0, 0127) // sblx7
+DISPATCH_OP (0, 0176) // sbq
+DISPATCH_OP (0, 0160) // sbx0
+DISPATCH_OP (0, 0161) // sbx1
+DISPATCH_OP (0, 0162) // sbx2
+DISPATCH_OP (0, 0163) // sbx3
+DISPATCH_OP (0, 0164) // sbx4
+DISPATCH_OP (0, 0165) // sbx5
+DISPATCH_OP (0, 0166) // sbx6
+DISPATCH_OP (0, 0167) // sbx7
+DISPATCH_OP (0, 0155) // ssa
+DISPATCH_OP (0, 0156) // ssq
+DISPATCH_OP (0, 0140) // ssx0
+DISPATCH_OP (0, 0141) // ssx1
+DISPATCH_OP (0, 0142) // ssx2
+DISPATCH_OP (0, 0143) // ssx3
+DISPATCH_OP (0, 0144) // ssx4
+DISPATCH_OP (0, 0145) // ssx5
+DISPATCH_OP (0, 0146) // ssx6
+DISPATCH_OP (0, 0147) // ssx7
+DISPATCH_OP (0, 0171) // swca
+DISPATCH_OP (0, 0172) // swcq
+DISPATCH_OP (0, 0401) // mpf
+DISPATCH_OP (0, 0402) // mpy
+DISPATCH_OP (0, 0506) // div
+DISPATCH_OP (0, 0507) // dvf
+DISPATCH_OP (0, 0531) // neg
+DISPATCH_OP (0, 0533) // negl
+DISPATCH_OP (0, 0405) // cmg
+DISPATCH_OP (0, 0211) // cmk
+DISPATCH_OP (0, 0117) // cmpaq
+DISPATCH_OP (0, 0100) // cmpx0
+DISPATCH_OP (0, 0101) // cmpx1
+DISPATCH_OP (0, 0102) // cmpx2
+DISPATCH_OP (0, 0103) // cmpx3
+DISPATCH_OP (0, 0104) // cmpx4
+DISPATCH_OP (0, 0105) // cmpx5
+DISPATCH_OP (0, 0106) // cmpx6
+DISPATCH_OP (0, 0107) // cmpx7
+DISPATCH_OP (0, 0111) // cwl
+DISPATCH_OP (0, 0234) // szn
+DISPATCH_OP (0, 0214) // sznc
+DISPATCH_OP (0, 0376) // anq
+DISPATCH_OP (0, 0355) // ansa
+DISPATCH_OP (0, 0356) // ansq
+DISPATCH_OP (0, 0340) // ansx0
+DISPATCH_OP (0, 0341) // ansx1
+DISPATCH_OP (0, 0342) // ansx2
+DISPATCH_OP (0, 0343) // ansx3
+DISPATCH_OP (0, 0344) // ansx4
+DISPATCH_OP (0, 0345) // ansx5
+DISPATCH_OP (0, 0346) // ansx6
+DISPATCH_OP (0, 0347) // ansx7
+DISPATCH_OP (0, 0360) // anx0
+DISPATCH_OP (0, 0361) // anx1
+DISPATCH_OP (0, 0362) // anx2
+DISPATCH_OP (0, 0363) // anx3
+DISPATCH_OP (0, 0364) // anx4
+DISPATCH_OP (0, 0365) // anx5
+DISPATCH_OP (0, 0366) // anx6
+DISPATCH_OP (0, 0367) // anx7
+DISPATCH_OP (0, 0277) // oraq
+DISPATCH_OP (0, 0276) // orq
+DISPATCH_OP (0, 0255) // orsa
+DISPATCH_OP (0, 0256) // orsq
+DISPATCH_OP (0, 0240) // orsx0
+DISPATCH_OP (0, 0241) // orsx1
+DISPATCH_OP (0, 0242) // orsx2
+DISPATCH_OP (0, 0243) // orsx3
+DISPATCH_OP (0, 0244) // orsx4
+DISPATCH_OP (0, 0245) // orsx5
+DISPATCH_OP (0, 0246) // orsx6
+DISPATCH_OP (0, 0247) // orsx7
+DISPATCH_OP (0, 0260) // orx0
+DISPATCH_OP (0, 0261) // orx1
+DISPATCH_OP (0, 0262) // orx2
+DISPATCH_OP (0, 0263) // orx3
+DISPATCH_OP (0, 0264) // orx4
+DISPATCH_OP (0, 0265) // orx5
+DISPATCH_OP (0, 0266) // orx6
+DISPATCH_OP (0, 0267) // orx7
+DISPATCH_OP (0, 0675) // era
+DISPATCH_OP (0, 0676) // erq
+DISPATCH_OP (0, 0655) // ersa
+DISPATCH_OP (0, 0656) // ersq
+DISPATCH_OP (0, 0640) // ersx0
+DISPATCH_OP (0, 0641) // ersx1
+DISPATCH_OP (0, 0642) // ersx2
+DISPATCH_OP (0, 0643) // ersx3
+DISPATCH_OP (0, 0644) // ersx4
+DISPATCH_OP (0, 0645) // ersx5
+DISPATCH_OP (0, 0646) // ersx6
+DISPATCH_OP (0, 0647) // ersx7
+DISPATCH_OP (0, 0660) // erx0
+DISPATCH_OP (0, 0661) // erx1
+DISPATCH_OP (0, 0662) // erx2
+DISPATCH_OP (0, 0663) // erx3
+DISPATCH_OP (0, 0664) // erx4
+DISPATCH_OP (0, 0665) // erx5
+DISPATCH_OP (0, 0666) // erx6  !!!! Beware !!!!
+DISPATCH_OP (0, 0667) // erx7
+DISPATCH_OP (0, 0317) // canaq
+DISPATCH_OP (0, 0316) // canq
+DISPATCH_OP (0, 0300) // canx0
+DISPATCH_OP (0, 0301) // canx1
+DISPATCH_OP (0, 0302) // canx2
+DISPATCH_OP (0, 0303) // canx3
+DISPATCH_OP (0, 0304) // canx4
+DISPATCH_OP (0, 0305) // canx5
+DISPATCH_OP (0, 0306) // canx6
+DISPATCH_OP (0, 0307) // canx7
+DISPATCH_OP (0, 0215) // cnaa
+DISPATCH_OP (0, 0217) // cnaaq
+DISPATCH_OP (0, 0216) // cnaq
+DISPATCH_OP (0, 0200) // cnax0
+DISPATCH_OP (0, 0201) // cnax1
+DISPATCH_OP (0, 0202) // cnax2
+DISPATCH_OP (0, 0203) // cnax3
+DISPATCH_OP (0, 0204) // cnax4
+DISPATCH_OP (0, 0205) // cnax5
+DISPATCH_OP (0, 0206) // cnax6
+DISPATCH_OP (0, 0207) // cnax7
+DISPATCH_OP (0, 0433) // dfld
+DISPATCH_OP (0, 0457) // dfst
+DISPATCH_OP (0, 0472) // dfstr
+DISPATCH_OP (0, 0455) // fst
+DISPATCH_OP (0, 0470) // fstr
+DISPATCH_OP (0, 0477) // dfad
+DISPATCH_OP (0, 0437) // dufa
+DISPATCH_OP (0, 0475) // fad
+DISPATCH_OP (0, 0435) // ufa
+DISPATCH_OP (0, 0577) // dfsb
+DISPATCH_OP (0, 0537) // dufs
+DISPATCH_OP (0, 0575) // fsb
+DISPATCH_OP (0, 0535) // ufs
+DISPATCH_OP (0, 0463) // dfmp
+DISPATCH_OP (0, 0423) // dufm
+DISPATCH_OP (0, 0461) // fmp
+DISPATCH_OP (0, 0421) // ufm
+DISPATCH_OP (0, 0527) // dfdi
+DISPATCH_OP (0, 0567) // dfdv
+DISPATCH_OP (0, 0525) // fdi
+DISPATCH_OP (0, 0565) // fdv
+DISPATCH_OP (0, 0513) // fneg
+DISPATCH_OP (0, 0573) // fno
+DISPATCH_OP (0, 0473) // dfrd
+DISPATCH_OP (0, 0471) // frd
+DISPATCH_OP (0, 0427) // dfcmg
+DISPATCH_OP (0, 0517) // dfcmp
+DISPATCH_OP (0, 0425) // fcmg
+DISPATCH_OP (0, 0515) // fcmp
+DISPATCH_OP (0, 0415) // ade
+DISPATCH_OP (0, 0430) // fszn
+DISPATCH_OP (0, 0411) // lde
+DISPATCH_OP (0, 0456) // ste
+DISPATCH_OP (0, 0713) // call6
+DISPATCH_OP (0, 0630) // ret
+DISPATCH_OP (0, 0614) // teo
+DISPATCH_OP (0, 0615) // teu
+DISPATCH_OP (0, 0602) // tnc
+DISPATCH_OP (0, 0617) // tov
+DISPATCH_OP (0, 0605) // tpl
+DISPATCH_OP (0, 0603) // trc
+DISPATCH_OP (1, 0601) // trtf
+DISPATCH_OP (1, 0600) // trtn
+DISPATCH_OP (0, 0715) // tss
+DISPATCH_OP (0, 0607) // ttf
+DISPATCH_OP (1, 0606) // ttn
+DISPATCH_OP (0, 0311) // easp0
+DISPATCH_OP (1, 0310) // easp1
+DISPATCH_OP (0, 0313) // easp2
+DISPATCH_OP (1, 0312) // easp3
+DISPATCH_OP (0, 0331) // easp4
+DISPATCH_OP (1, 0330) // easp5
+DISPATCH_OP (0, 0333) // easp6
+DISPATCH_OP (1, 0332) // easp7
+DISPATCH_OP (0, 0310) // eawp0
+DISPATCH_OP (1, 0311) // eawp1
+DISPATCH_OP (0, 0312) // eawp2
+DISPATCH_OP (1, 0313) // eawp3
+DISPATCH_OP (0, 0330) // eawp4
+DISPATCH_OP (1, 0331) // eawp5
+DISPATCH_OP (0, 0332) // eawp6
+DISPATCH_OP (1, 0333) // eawp7
+DISPATCH_OP (0, 0173) // lpri
+DISPATCH_OP (0, 0254) // spri
+DISPATCH_OP (0, 0540) // sprp0
+DISPATCH_OP (0, 0541) // sprp1
+DISPATCH_OP (0, 0542) // sprp2
+DISPATCH_OP (0, 0543) // sprp3
+DISPATCH_OP (0, 0544) // sprp4
+DISPATCH_OP (0, 0545) // sprp5
+DISPATCH_OP (0, 0546) // sprp6
+DISPATCH_OP (0, 0547) // sprp7
+DISPATCH_OP (0, 0050) // adwp0
+DISPATCH_OP (0, 0051) // adwp1
+DISPATCH_OP (0, 0052) // adwp2
+DISPATCH_OP (0, 0053) // adwp3
+DISPATCH_OP (0, 0150) // adwp4
+DISPATCH_OP (0, 0151) // adwp5
+DISPATCH_OP (0, 0152) // adwp6
+DISPATCH_OP (0, 0153) // adwp7
+DISPATCH_OP (0, 0633) // rccl
+DISPATCH_OP (0, 0002) // drl
+DISPATCH_OP (0, 0716) // xec
+DISPATCH_OP (0, 0717) // xed
+DISPATCH_OP (0, 0001) // mme
+DISPATCH_OP (0, 0004) // mme2
+DISPATCH_OP (0, 0005) // mme3
+DISPATCH_OP (0, 0007) // mme4
+DISPATCH_OP (0, 0011) // nop
+DISPATCH_OP (0, 0012) // puls1
+DISPATCH_OP (0, 0013) // puls2
+DISPATCH_OP (0, 0560) // rpd
+DISPATCH_OP (0, 0500) // rpl
+DISPATCH_OP (0, 0520) // rpt
+DISPATCH_OP (1, 0754) // sra
+DISPATCH_OP (0, 0550) // sbar
+DISPATCH_OP (0, 0505) // bcd
+DISPATCH_OP (0, 0774) // gtb
+DISPATCH_OP (0, 0230) // lbar
+DISPATCH_OP (0, 0674) // lcpr
+DISPATCH_OP (0, 0232) // ldbr
+DISPATCH_OP (0, 0637) // ldt
+DISPATCH_OP (1, 0257) // lptp
+DISPATCH_OP (1, 0173) // lptr
+DISPATCH_OP (1, 0774) // lra
+DISPATCH_OP (0, 0257) // lsdp
+DISPATCH_OP (1, 0232) // lsdr
+DISPATCH_OP (0, 0613) // rcu
+DISPATCH_OP (0, 0452) // scpr
+DISPATCH_OP (0, 0657) // scu
+DISPATCH_OP (0, 0154) // sdbr
+DISPATCH_OP (1, 0557) // sptp
+DISPATCH_OP (1, 0154) // sptr
+DISPATCH_OP (0, 0557) // ssdp
+DISPATCH_OP (1, 0254) // ssdr
+DISPATCH_OP (1, 0532) // camp
+DISPATCH_OP (0, 0532) // cams
+DISPATCH_OP (0, 0233) // rmcm
+DISPATCH_OP (0, 0413) // rscr
+DISPATCH_OP (0, 0231) // rsw
+DISPATCH_OP (0, 0015) // cioc
+DISPATCH_OP (0, 0553) // smcm
+DISPATCH_OP (0, 0451) // smic
+DISPATCH_OP (0, 0057) // sscr
+DISPATCH_OP (0, 0212) // absa
+DISPATCH_OP (0, 0616) // dis
+DISPATCH_OP (1, 0560) // aar0
+DISPATCH_OP (1, 0561) // aar1
+DISPATCH_OP (1, 0562) // aar2
+DISPATCH_OP (1, 0563) // aar3
+DISPATCH_OP (1, 0564) // aar4
+DISPATCH_OP (1, 0565) // aar5
+DISPATCH_OP (1, 0566) // aar6
+DISPATCH_OP (1, 0567) // aar7
+DISPATCH_OP (1, 0760) // lar0
+DISPATCH_OP (1, 0761) // lar1
+DISPATCH_OP (1, 0762) // lar2
+DISPATCH_OP (1, 0763) // lar3
+DISPATCH_OP (1, 0764) // lar4
+DISPATCH_OP (1, 0765) // lar5
+DISPATCH_OP (1, 0766) // lar6
+DISPATCH_OP (1, 0767) // lar7
+DISPATCH_OP (1, 0463) // lareg
+DISPATCH_OP (1, 0467) // lpl
+DISPATCH_OP (1, 0660) // nar0
+DISPATCH_OP (1, 0661) // nar1
+DISPATCH_OP (1, 0662) // nar2
+DISPATCH_OP (1, 0663) // nar3
+DISPATCH_OP (1, 0664) // nar4
+DISPATCH_OP (1, 0665) // nar5
+DISPATCH_OP (1, 0666) // nar6 beware!!!! :-)
+DISPATCH_OP (1, 0667) // nar7
+DISPATCH_OP (1, 0540) // ara0
+DISPATCH_OP (1, 0541) // ara1
+DISPATCH_OP (1, 0542) // ara2
+DISPATCH_OP (1, 0543) // ara3
+DISPATCH_OP (1, 0544) // ara4
+DISPATCH_OP (1, 0545) // ara5
+DISPATCH_OP (1, 0546) // ara6
+DISPATCH_OP (1, 0547) // ara7
+DISPATCH_OP (1, 0640) // aar0
+DISPATCH_OP (1, 0641) // aar1
+DISPATCH_OP (1, 0642) // aar2
+DISPATCH_OP (1, 0643) // aar3
+DISPATCH_OP (1, 0644) // aar4
+DISPATCH_OP (1, 0645) // aar5
+DISPATCH_OP (1, 0646) // aar6
+DISPATCH_OP (1, 0647) // aar7
+DISPATCH_OP (1, 0740) // sar0
+DISPATCH_OP (1, 0741) // sar1
+DISPATCH_OP (1, 0742) // sar2
+DISPATCH_OP (1, 0743) // sar3
+DISPATCH_OP (1, 0744) // sar4
+DISPATCH_OP (1, 0745) // sar5
+DISPATCH_OP (1, 0746) // sar6
+DISPATCH_OP (1, 0747) // sar7
+DISPATCH_OP (1, 0443) // sareg
+DISPATCH_OP (1, 0447) // spl
+DISPATCH_OP (1, 0502) // a4bd
+DISPATCH_OP (1, 0501) // a6bd
+DISPATCH_OP (1, 0500) // a9bd
+DISPATCH_OP (1, 0503) // abd
+DISPATCH_OP (1, 0507) // awd
+DISPATCH_OP (1, 0522) // s4bd
+DISPATCH_OP (1, 0521) // s6bd
+DISPATCH_OP (1, 0520) // s9bd
+DISPATCH_OP (1, 0523) // sbd
+DISPATCH_OP (1, 0527) // swd
+DISPATCH_OP (1, 0106) // cmpc
+DISPATCH_OP (1, 0120) // scd
+DISPATCH_OP (1, 0121) // scdr
+DISPATCH_OP (1, 0124) // scm
+DISPATCH_OP (1, 0125) // scmr
+DISPATCH_OP (1, 0164) // tct
+DISPATCH_OP (1, 0165) // tctr
+DISPATCH_OP (1, 0100) // mlr
+DISPATCH_OP (1, 0101) // mrl
+DISPATCH_OP (1, 0020) // mve
+DISPATCH_OP (1, 0160) // mvt
+DISPATCH_OP (1, 0303) // cmpn
+DISPATCH_OP (1, 0300) // mvn
+DISPATCH_OP (1, 0024) // mvne
+DISPATCH_OP (1, 0060) // csl
+DISPATCH_OP (1, 0061) // csr
+DISPATCH_OP (1, 0066) // cmpb
+DISPATCH_OP (1, 0064) // sztl
+DISPATCH_OP (1, 0065) // sztr
+DISPATCH_OP (1, 0301) // btd
+DISPATCH_OP (1, 0305) // dtb
+DISPATCH_OP (1, 0202) // ad2d
+DISPATCH_OP (1, 0222) // ad3d
+DISPATCH_OP (1, 0203) // sb2d
+DISPATCH_OP (1, 0223) // sb3d
+DISPATCH_OP (1, 0206) // mp2d
+DISPATCH_OP (1, 0226) // mp3d
+DISPATCH_OP (1, 0207) // dv2d
+DISPATCH_OP (1, 0227) // dv3d
+DISPATCH_OP (1, 0420) // emcall instruction Custom, for an emulator call for scp
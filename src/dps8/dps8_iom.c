@@ -556,9 +556,11 @@
 #include "dps8_iom.h"
 #include "dps8_cable.h"
 #include "dps8_console.h"
+#include "dps8_disk.h"
 #include "dps8_fnp2.h"
 #include "dps8_utils.h"
-#if defined(LOCKLESS)
+#include "dps8_metrics.h"
+#if defined(LOCKLESS) || defined(THREADZ)
 # include "threadz.h"
 #endif
 
@@ -581,6 +583,20 @@
 
 iom_chan_data_t iom_chan_data[N_IOM_UNITS_MAX][MAX_CHANNELS];
 
+#if defined(LOCKLESS)
+static pthread_mutex_t chan_lock [N_IOM_UNITS_MAX] [MAX_CHANNELS];
+
+void lock_chan (uint iom_unit_idx, uint chan)
+  {
+    lock_ptr (& chan_lock[iom_unit_idx][chan]);
+  }
+
+void unlock_chan (uint iom_unit_idx, uint chan)
+  {
+    unlock_ptr (& chan_lock[iom_unit_idx][chan]);
+  }
+#endif /* if defined(LOCKLESS) */
+
 typedef enum iom_status_t
   {
     iomStatNormal         = 0,
@@ -680,6 +696,19 @@ typedef struct
 
     coreLockState_t  iomCoreLockState;
 
+#if defined(LOCKLESS)
+    // Serializes the connect channel's list service
+    pthread_mutex_t connectLock;
+#endif /* if defined(LOCKLESS) */
+
+#if defined(IO_THREADZ) && defined(AFFINITY)
+    // Host CPU placement of the IOM and channel threads
+    bool set_affinity;
+    uint affinity;
+    bool set_chan_affinity;
+    uint chan_affinity;
+#endif /* if defined(IO_THREADZ) && defined(AFFINITY) */
+
   } iom_unit_data_t;
 
 static iom_unit_data_t iom_unit_data[N_IOM_UNITS_MAX];
@@ -1016,6 +1045,23 @@ static t_stat iom_show_config (UNUSED FILE * st, UNIT * uptr, UNUSED int val,
     for (i = 0; i < N_IOM_PORTS; i ++)
       sim_printf (" %3o", p -> configSwPortStoresize[i]);
     sim_printf ("\r\n");
+#if defined(IO_THREADZ) && defined(AFFINITY)
+    if (p -> set_affinity)
+      sim_printf ("IOM affinity:             %u\r\n", p -> affinity);
+    else
+      sim_printf ("IOM affinity:             not set\r\n");
+    if (p -> set_chan_affinity)
+      sim_printf ("Channel affinity:         %u\r\n", p -> chan_affinity);
+    else
+      sim_printf ("Channel affinity:         not set\r\n");
+    if (iomThreadz[iom_unit_idx].ready)
+      {
+        char placement[256];
+        sim_printf ("IOM thread host CPUs:     %s\r\n",
+                    getThreadAffinity (iomThreadz[iom_unit_idx].iomThread,
+                                       placement, sizeof (placement)));
+      }
+#endif /* if defined(IO_THREADZ) && defined(AFFINITY) */
 
     return SCPE_OK;
   }
@@ -1038,6 +1084,8 @@ static t_stat iom_show_config (UNUSED FILE * st, UNIT * uptr, UNUSED int val,
 //             halfsize=n
 //             storesize=n
 //          bootskip=n // Hack: forward skip n records after reading boot record
+//          affinity=n | off       // host CPU for the IOM thread (IO_THREADZ)
+//          chan_affinity=n | off  // host CPU for its channel threads
 
 static config_value_list_t cfg_model_list[] =
   {
@@ -1070,6 +1118,14 @@ static config_value_list_t cfg_base_list[] =
     { NULL, 0 }
   };
 
+#if defined(IO_THREADZ) && defined(AFFINITY)
+static config_value_list_t cfg_affinity[] =
+  {
+    { "off", -1 },
+    { NULL,  0  }
+  };
+#endif /* if defined(IO_THREADZ) && defined(AFFINITY) */
+
 static config_value_list_t cfg_size_list[] =
   {
     { "32",    0 },
@@ -1111,6 +1167,10 @@ static config_list_t iom_config_list[] =
     { "initenable",     0, 1,               NULL           },
     { "halfsize",       0, 1,               NULL           },
     { "store_size",     0, 7,               cfg_size_list  },
+#if defined(IO_THREADZ) && defined(AFFINITY)
+    { "affinity",      -1, 32767,           cfg_affinity   },
+    { "chan_affinity", -1, 32767,           cfg_affinity   },
+#endif /* if defined(IO_THREADZ) && defined(AFFINITY) */
     { NULL,             0, 0,               NULL           }
   };
 
@@ -1250,6 +1310,23 @@ static t_stat iom_set_config (UNIT * uptr, UNUSED int value, const char * cptr,
             continue;
           }
 
+#if defined(IO_THREADZ) && defined(AFFINITY)
+        // Applied when the threads start
+        if (strcmp (name, "affinity") == 0)
+          {
+            p -> set_affinity = v >= 0;
+            p -> affinity = v >= 0 ? (uint) v : 0;
+            continue;
+          }
+
+        if (strcmp (name, "chan_affinity") == 0)
+          {
+            p -> set_chan_affinity = v >= 0;
+            p -> chan_affinity = v >= 0 ? (uint) v : 0;
+            continue;
+          }
+#endif /* if defined(IO_THREADZ) && defined(AFFINITY) */
+
         sim_printf ("error: %s: Invalid cfg_parse rc <%ld>\r\n", __func__, (long) rc);
         cfg_parse_done (& cfg_state);
         return SCPE_ARG;
@@ -1979,13 +2056,20 @@ void iom_direct_data_service (uint iom_unit_idx, uint chan, word24 daddr, word36
       }
 
     if (op == direct_store)
-      iom_core_write (iom_unit_idx, daddr, * data, __func__);
+      {
+        iom_core_write (iom_unit_idx, daddr, * data, __func__);
+        METRIC_ADD (p->wordsStored, 1);
+      }
     else if (op == direct_load)
-      iom_core_read (iom_unit_idx, daddr, data, __func__);
+      {
+        iom_core_read (iom_unit_idx, daddr, data, __func__);
+        METRIC_ADD (p->wordsLoaded, 1);
+      }
     else if (op == direct_read_clear)
       {
         iom_core_read_lock (iom_unit_idx, daddr, data, __func__);
         iom_core_write_unlock (iom_unit_idx, daddr, 0, __func__);
+        METRIC_ADD (p->wordsLoaded, 1);
       }
   }
 
@@ -2039,6 +2123,7 @@ void iom_indirect_data_service (uint iom_unit_idx, uint chan, word36 * data, uin
       p->tallyResidue --;
       c --;
     }
+    METRIC_ADD (p->wordsStored, * cnt - c);
   } else { // read
     uint c = 0;
     while (p -> tallyResidue) {
@@ -2068,6 +2153,7 @@ void iom_indirect_data_service (uint iom_unit_idx, uint chan, word36 * data, uin
       c ++;
     }
     * cnt = c;
+    METRIC_ADD (p->wordsLoaded, c);
   }
 }
 
@@ -3055,7 +3141,7 @@ D:;
 
 // 0 ok
 // -1 uff
-static int doPayloadChannel (uint iomUnitIdx, uint chan) {
+int doPayloadChannel (uint iomUnitIdx, uint chan) {
 #if defined(TESTING)
   cpu_state_t * cpup = _cpup;
   sim_debug (DBG_DEBUG, & iom_dev, "%s: Payload channel %c%02o\r\n", __func__, iomChar (iomUnitIdx), chan);
@@ -3078,6 +3164,7 @@ static int doPayloadChannel (uint iomUnitIdx, uint chan) {
 //     control is 0, indicating last IDCW
 
   iom_chan_data_t * p = & iom_chan_data[iomUnitIdx][chan];
+  METRIC_ADD (p->connects, 1);
 
 #if defined(TESTING)
   word36 PCW_DCW        = p->DCW;
@@ -3304,6 +3391,53 @@ pending:;
 // resulting PCW control words.
 //
 
+#if defined(LOCKLESS) && !defined(IO_THREADZ) && \
+    !defined(IO_ASYNC_PAYLOAD_CHAN) && !defined(IO_ASYNC_PAYLOAD_CHAN_THREAD)
+// Channel program locking
+//
+// Disk and tape channel programs touch only their channel and their own
+// drive, so each runs under its channel's lock and channels of the same
+// IOM progress concurrently. The other controllers share the libuv loop
+// with the poll loop and still run under the IOM lock. Status and
+// interrupts reach memory through core word locks (IMW, special status
+// queue) or channel-private mailboxes.
+
+static bool chanRunsUnlocked (uint iom_unit_idx, uint chan)
+  {
+    switch (cables->iom_to_ctlr[iom_unit_idx][chan].ctlr_type)
+      {
+        case CTLR_T_MTP:
+        case CTLR_T_MSP:
+        case CTLR_T_IPC:
+          return true;
+        default:
+          return false;
+      }
+  }
+
+static void startPayloadChannel (uint iom_unit_idx, uint chan)
+  {
+    // Disk channels may be handed to the disk I/O workers
+    if (dsk_async_connect (iom_unit_idx, chan))
+      return;
+    if (chanRunsUnlocked (iom_unit_idx, chan))
+      {
+        lock_chan (iom_unit_idx, chan);
+        (void)doPayloadChannel (iom_unit_idx, chan);
+        unlock_chan (iom_unit_idx, chan);
+      }
+    else
+      {
+        lock_iom ();
+        lock_libuv ();
+        (void)doPayloadChannel (iom_unit_idx, chan);
+        unlock_libuv ();
+        unlock_iom ();
+      }
+  }
+# define DEFER_PAYLOAD
+#endif /* if defined(LOCKLESS) && !defined(IO_THREADZ) && ... */
+
 static int doConnectChan (uint iom_unit_idx) {
   // ... the connect channel obtains a list service from the IOM Central.
   // During this service the IOM Central will do a double precision read
@@ -3320,6 +3454,14 @@ static int doConnectChan (uint iom_unit_idx) {
   cpu_state_t * cpup = _cpup;
 #endif
   sim_debug (DBG_DEBUG, & iom_dev, "%s: Connect channel\r\n", __func__);
+#if defined(LOCKLESS)
+  lock_ptr (& iom_unit_data[iom_unit_idx].connectLock);
+#endif
+#if defined(DEFER_PAYLOAD)
+  // Channels started by this connect; run once the list service is done
+  uint started [MAX_CHANNELS];
+  uint nStarted = 0;
+#endif
   iom_chan_data_t * p = & iom_chan_data[iom_unit_idx][IOM_CONNECT_CHAN];
   p -> lsFirst = true;
 #if defined(TESTING) && defined(POLTS_TESTING)
@@ -3331,6 +3473,13 @@ static int doConnectChan (uint iom_unit_idx) {
     int rc = iom_list_service (iom_unit_idx, IOM_CONNECT_CHAN, & ptro, & send, & uff);
     if (rc < 0) {
       sim_warn ("connect channel connect failed\r\n");
+#if defined(LOCKLESS)
+      unlock_ptr (& iom_unit_data[iom_unit_idx].connectLock);
+#endif
+#if defined(DEFER_PAYLOAD)
+      for (uint i = 0; i < nStarted; i ++)
+        startPayloadChannel (iom_unit_idx, started[i]);
+#endif
       return -1;
     }
     if (uff) {
@@ -3388,6 +3537,16 @@ static int doConnectChan (uint iom_unit_idx) {
         q -> start  = true;
 #if defined(IO_THREADZ)
         setChnConnect (iom_unit_idx, p -> PCW_CHAN);
+#elif defined(DEFER_PAYLOAD)
+        if (nStarted == MAX_CHANNELS) {
+          // Overlong connect list; drain it before going on
+          unlock_ptr (& iom_unit_data[iom_unit_idx].connectLock);
+          for (uint i = 0; i < nStarted; i ++)
+            startPayloadChannel (iom_unit_idx, started[i]);
+          nStarted = 0;
+          lock_ptr (& iom_unit_data[iom_unit_idx].connectLock);
+        }
+        started[nStarted ++] = p -> PCW_CHAN;
 #else
 # if !defined(IO_ASYNC_PAYLOAD_CHAN) && !defined(IO_ASYNC_PAYLOAD_CHAN_THREAD)
         doPayloadChannel (iom_unit_idx, p -> PCW_CHAN);
@@ -3399,6 +3558,15 @@ static int doConnectChan (uint iom_unit_idx) {
       }
     }
   } while (! ptro);
+#if defined(LOCKLESS)
+  unlock_ptr (& iom_unit_data[iom_unit_idx].connectLock);
+#endif
+#if defined(DEFER_PAYLOAD)
+  // The connect lock is not held here, so other connects to this IOM
+  // can start their channels while these run.
+  for (uint i = 0; i < nStarted; i ++)
+    startPayloadChannel (iom_unit_idx, started[i]);
+#endif
   return 0; // XXX
 }
 
@@ -3436,15 +3604,19 @@ int send_special_interrupt (uint iom_unit_idx, uint chan, uint devCode,
     if (iom_chan_data [iom_unit_idx] [chan] . masked)
       return(0);
 
-#if defined(LOCKLESS)
-    lock_iom();
-#endif
-
 // Multics uses an 12(8) word circular queue, managed by clever manipulation
 // of the LPW and DCW.
 // Rather then goes through the mechanics of parsing the LPW and DCW,
 // we will just assume that everything is set up the way we expect,
-// and update the circular queue.
+// and update the circular queue. Holding the core word lock on the DCW
+// while the status is stored keeps concurrent senders on their own slots.
+//
+// lock_iom is not taken: tape and disk channels send from under their
+// drive lock, and the console channel mounts tapes (taking a drive lock)
+// under lock_iom, so taking it here could deadlock. Nothing else needs
+// it; the IOM never writes the LPW or SCW, send_general_interrupt
+// updates the IMW under its core word lock, and scu_set_interrupt does
+// its own locking.
     word36 lpw;
     iom_core_read (iom_unit_idx, chanloc + IOM_MBX_LPW, & lpw, __func__);
 
@@ -3471,10 +3643,6 @@ int send_special_interrupt (uint iom_unit_idx, uint chan, uint devCode,
       dcw = scw; // reset to beginning of queue
     iom_core_write_unlock (iom_unit_idx, chanloc + IOM_MBX_DCW, dcw, __func__);
 
-#if defined(LOCKLESS)
-    unlock_iom();
-#endif
-
     send_general_interrupt (iom_unit_idx, IOM_SPECIAL_STATUS_CHAN, imwSpecialPic);
     return 0;
   }
@@ -3545,6 +3713,17 @@ void * chan_thread_main (void * arg)
       (void)sim_os_set_thread_priority (PRIORITY_ABOVE_NORMAL);
 # endif
     }
+# if defined(AFFINITY)
+    if (iom_unit_data[this_iom_idx].set_chan_affinity)
+      {
+        int rc = setThreadAffinity (pthread_self (),
+                                    (int) iom_unit_data[this_iom_idx].chan_affinity);
+        if (rc)
+          sim_warn ("Unable to bind IOM %c channel %u to host CPU %u: %s\r\n",
+                    this_iom_idx + 'a', this_chan_num,
+                    iom_unit_data[this_iom_idx].chan_affinity, xstrerror_l (rc));
+      }
+# endif /* if defined(AFFINITY) */
 
     setSignals ();
     while (1)
@@ -3567,6 +3746,15 @@ void * iom_thread_main (void * arg)
     set_cpu_idx (0);
 
     sim_printf("IOM %c thread created\r\n", 'a' + myid);
+# if defined(AFFINITY)
+    if (iom_unit_data[myid].set_affinity)
+      {
+        int rc = setThreadAffinity (pthread_self (), (int) iom_unit_data[myid].affinity);
+        if (rc)
+          sim_warn ("Unable to bind IOM %c to host CPU %u: %s\r\n",
+                    'a' + myid, iom_unit_data[myid].affinity, xstrerror_l (rc));
+      }
+# endif /* if defined(AFFINITY) */
 
     setSignals ();
     while (1)
@@ -3593,6 +3781,14 @@ void * iom_thread_main (void * arg)
 void iom_init (void)
   {
     //sim_debug (DBG_INFO, & iom_dev, "%s: running.\r\n", __func__);
+#if defined(LOCKLESS)
+    for (uint i = 0; i < N_IOM_UNITS_MAX; i ++)
+      {
+        pthread_mutex_init (& iom_unit_data[i].connectLock, NULL);
+        for (uint j = 0; j < MAX_CHANNELS; j ++)
+          pthread_mutex_init (& chan_lock[i][j], NULL);
+      }
+#endif /* if defined(LOCKLESS) */
   }
 
 #if defined(PANEL68)
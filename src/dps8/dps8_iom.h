@@ -268,10 +268,21 @@ typedef volatile struct
 
     bool start;
 
+    // Activity counters for the metrics exporter
+    uint64_t connects;
+    uint64_t wordsStored;  // words written to memory by the data services
+    uint64_t wordsLoaded;  // words read from memory by the data services
+
   } iom_chan_data_t;
 
 extern iom_chan_data_t iom_chan_data [N_IOM_UNITS_MAX] [MAX_CHANNELS];
 
+#if defined(LOCKLESS)
+// Held while a disk or tape channel program runs
+void lock_chan (uint iom_unit_idx, uint chan);
+void unlock_chan (uint iom_unit_idx, uint chan);
+#endif /* if defined(LOCKLESS) */
+
 extern DEVICE iom_dev;
 
 // Indirect data service data type
@@ -405,6 +416,7 @@ void iom_indirect_data_service (uint iom_unit_idx, uint chan, word36 * data,
                                 uint * cnt, bool write);
 void iom_init (void);
 int send_marker_interrupt (uint iom_unit_idx, int chan);
+int doPayloadChannel (uint iomUnitIdx, uint chan);
 #if defined(PANEL68)
 void do_boot (void);
 #endif
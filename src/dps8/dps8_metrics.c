@@ -0,0 +1,349 @@
+/*
+ * vim: filetype=c:tabstop=4:ai:expandtab
+ * SPDX-License-Identifier: ICU
+ * scspell-id: 5d1e82a8-ab2f-11f1-9a6e-80ee73e9b8e7
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Copyright (c) 2026 The DPS8M Development Team
+ *
+ * This software is made available under the terms of the ICU License.
+ * See the LICENSE.md file at the top-level directory of this distribution.
+ *
+ * ---------------------------------------------------------------------------
+ */
+
+// Live performance counters
+//
+// The per-CPU counters (instructions, cycles, faults, core lock waits,
+// micro-cache activity) and the per-channel IOM counters are rendered in
+// the Prometheus text exposition format, either on the console
+// ("METRICS_SHOW") or to each client connecting to a local socket
+// ("METRICS <path>"). The socket is serviced from the simulator's libuv
+// poll loop, so a scrape never stops or locks the CPUs; the counters are
+// read with relaxed loads and a scrape is a consistent-enough snapshot,
+// not an atomic one.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "dps8.h"
+#include "dps8_iom.h"
+#include "dps8_cable.h"
+#include "dps8_cpu.h"
+#include "dps8_faults.h"
+#include "dps8_metrics.h"
+#include "uv.h"
+
+#define METRICS_BACKLOG 16
+
+typedef struct
+  {
+    char * buf;
+    size_t len;
+    size_t size;
+  } mtext_t;
+
+typedef struct
+  {
+    uv_pipe_t client;
+    uv_write_t req;
+    mtext_t text;
+  } metrics_conn_t;
+
+static uv_pipe_t * metrics_server = NULL;
+static char * metrics_path = NULL;
+
+static const char * ucClassNames [UC_NUM] =
+  {
+    [UC_INSTRUCTION_FETCH]   = "instruction_fetch",
+    [UC_INDIRECT_WORD_FETCH] = "indirect_word_fetch",
+    [UC_OPERAND_READ]        = "operand_read",
+    [UC_OPERAND_READ_TRA]    = "operand_read_transfer",
+    [UC_OPERAND_READ_CALL6]  = "operand_read_call6",
+    [UC_OPERAND_STORE]       = "operand_store",
+    [UC_APU_DATA_READ]       = "apu_data_read",
+  };
+
+static void out_of_memory (const char * func, int line)
+  {
+    (void)fprintf (stderr, "\rFATAL: Out of memory! Aborting at %s[%s:%d]\r\n",
+                   func, __FILE__, line);
+#if defined(USE_BACKTRACE)
+# if defined(SIGUSR2)
+    (void)raise(SIGUSR2);
+    /*NOTREACHED*/ /* unreachable */
+# endif /* if defined(SIGUSR2) */
+#endif /* if defined(USE_BACKTRACE) */
+    abort();
+  }
+
+static void emit (mtext_t * t, const char * fmt, ...)
+  {
+    for (;;)
+      {
+        size_t room = t->size - t->len;
+        va_list ap;
+        va_start (ap, fmt);
+        int n = vsnprintf (t->buf + t->len, room, fmt, ap);
+        va_end (ap);
+        if (n < 0)
+          return;
+        if ((size_t) n < room)
+          {
+            t->len += (size_t) n;
+            return;
+          }
+        size_t size = t->size * 2 + (size_t) n;
+        char * buf = realloc (t->buf, size);
+        if (! buf)
+          out_of_memory (__func__, __LINE__);
+        t->buf  = buf;
+        t->size = size;
+      }
+  }
+
+static void family (mtext_t * t, const char * name, const char * type, const char * help)
+  {
+    emit (t, "# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+  }
+
+static void cpu_counter (mtext_t * t, const char * name, const char * help,
+                         size_t offset)
+  {
+    family (t, name, "counter", help);
+    for (uint i = 0; i < cpu_dev.numunits; i ++)
+      {
+        unsigned long long * cp = (unsigned long long *) ((char *) & cpus[i] + offset);
+        emit (t, "%s{cpu=\"%c\"} %llu\n", name, 'A' + i, METRIC_GET (* cp));
+      }
+  }
+
+static void lock_counter (mtext_t * t, const char * name, const char * type,
+                          const char * help, size_t offset)
+  {
+    family (t, name, type, help);
+    for (uint i = 0; i < cpu_dev.numunits; i ++)
+      {
+        uint64_t * cp = (uint64_t *) ((char *) & cpus[i].coreLockState + offset);
+        emit (t, "%s{cpu=\"%c\"} %llu\n", name, 'A' + i,
+              (unsigned long long) METRIC_GET (* cp));
+      }
+  }
+
+static void uc_counter (mtext_t * t, const char * name, const char * help,
+                        size_t offset)
+  {
+    family (t, name, "counter", help);
+    for (uint i = 0; i < cpu_dev.numunits; i ++)
+      {
+        uint64_t * cp = (uint64_t *) ((char *) & cpus[i].uCache + offset);
+        for (uint n = 0; n < UC_NUM; n ++)
+          emit (t, "%s{cpu=\"%c\",class=\"%s\"} %llu\n", name, 'A' + i,
+                ucClassNames[n], (unsigned long long) METRIC_GET (cp[n]));
+      }
+  }
+
+static void metrics_build (mtext_t * t)
+  {
+    t->len  = 0;
+    t->size = 16384;
+    t->buf  = malloc (t->size);
+    if (! t->buf)
+      out_of_memory (__func__, __LINE__);
+    t->buf[0] = 0;
+
+    cpu_counter (t, "dps8m_cpu_instructions_total", "Instructions executed.",
+                 offsetof (cpu_state_t, instrCnt));
+    cpu_counter (t, "dps8m_cpu_cycles_total", "Control unit cycles.",
+                 offsetof (cpu_state_t, cycleCnt));
+
+    family (t, "dps8m_cpu_faults_total", "counter", "Faults taken, by fault type.");
+    for (uint i = 0; i < cpu_dev.numunits; i ++)
+      for (uint f = 0; f < N_FAULTS; f ++)
+        {
+          unsigned long n = METRIC_GET (cpus[i].faultCnt[f]);
+          if (n)
+            emit (t, "dps8m_cpu_faults_total{cpu=\"%c\",fault=\"%s\"} %lu\n",
+                  'A' + i, faultNames[f], n);
+        }
+
+    lock_counter (t, "dps8m_cpu_core_locks_total", "counter",
+                  "Core word locks taken.", offsetof (coreLockState_t, lockCnt));
+    lock_counter (t, "dps8m_cpu_core_locks_immediate_total", "counter",
+                  "Core word locks taken without waiting.",
+                  offsetof (coreLockState_t, lockImmediate));
+    lock_counter (t, "dps8m_cpu_core_lock_waits_total", "counter",
+                  "Spins spent waiting for core word locks.",
+                  offsetof (coreLockState_t, lockWait));
+    lock_counter (t, "dps8m_cpu_core_lock_wait_max", "gauge",
+                  "Longest single wait for a core word lock, in spins.",
+                  offsetof (coreLockState_t, lockWaitMax));
+#if !defined(SCHED_NEVER_YIELD)
+    lock_counter (t, "dps8m_cpu_core_lock_yields_total", "counter",
+                  "Host yields while waiting for core word locks.",
+                  offsetof (coreLockState_t, lockYield));
+#endif /* if !defined(SCHED_NEVER_YIELD) */
+
+    uc_counter (t, "dps8m_ucache_hits_total", "Micro-cache hits.",
+                offsetof (uCache_t, hits));
+    uc_counter (t, "dps8m_ucache_misses_total", "Micro-cache misses.",
+                offsetof (uCache_t, misses));
+    uc_counter (t, "dps8m_ucache_skips_total", "Micro-cache lookups bypassed.",
+                offsetof (uCache_t, skips));
+
+    family (t, "dps8m_iom_connects_total", "counter", "Channel connects.");
+    for (uint i = 0; i < iom_dev.numunits; i ++)
+      for (uint c = 0; c < MAX_CHANNELS; c ++)
+        {
+          struct iom_to_ctlr_s * d = & cables->iom_to_ctlr[i][c];
+          if (d->in_use)
+            emit (t, "dps8m_iom_connects_total{iom=\"%c\",chan=\"%02o\",ctlr=\"%s%u\"} %llu\n",
+                  iomChar (i), c, ctlr_type_strs[d->ctlr_type], d->ctlr_unit_idx,
+                  (unsigned long long) METRIC_GET (iom_chan_data[i][c].connects));
+        }
+
+    family (t, "dps8m_iom_words_total", "counter",
+            "Words moved by the data services, by direction to or from memory.");
+    for (uint i = 0; i < iom_dev.numunits; i ++)
+      for (uint c = 0; c < MAX_CHANNELS; c ++)
+        {
+          struct iom_to_ctlr_s * d = & cables->iom_to_ctlr[i][c];
+          if (! d->in_use)
+            continue;
+          emit (t, "dps8m_iom_words_total{iom=\"%c\",chan=\"%02o\",ctlr=\"%s%u\",dir=\"store\"} %llu\n",
+                iomChar (i), c, ctlr_type_strs[d->ctlr_type], d->ctlr_unit_idx,
+                (unsigned long long) METRIC_GET (iom_chan_data[i][c].wordsStored));
+          emit (t, "dps8m_iom_words_total{iom=\"%c\",chan=\"%02o\",ctlr=\"%s%u\",dir=\"load\"} %llu\n",
+                iomChar (i), c, ctlr_type_strs[d->ctlr_type], d->ctlr_unit_idx,
+                (unsigned long long) METRIC_GET (iom_chan_data[i][c].wordsLoaded));
+        }
+  }
+
+//
+// Socket endpoint: each connection is answered with one snapshot and
+// closed, so "nc -U <path>" or "curl --http0.9 --unix-socket <path> x"
+// will scrape it.
+//
+
+static void metrics_close_cb (uv_handle_t * handle)
+  {
+    metrics_conn_t * conn = (metrics_conn_t *) handle->data;
+    FREE (conn->text.buf);
+    FREE (conn);
+  }
+
+static void metrics_write_cb (uv_write_t * req, UNUSED int status)
+  {
+    uv_close ((uv_handle_t *) req->handle, metrics_close_cb);
+  }
+
+static void metrics_connection (uv_stream_t * server, int status)
+  {
+    if (status < 0)
+      return;
+
+    metrics_conn_t * conn = calloc (1, sizeof (metrics_conn_t));
+    if (! conn)
+      out_of_memory (__func__, __LINE__);
+    uv_pipe_init (server->loop, & conn->client, 0);
+    conn->client.data = conn;
+    if (uv_accept (server, (uv_stream_t *) & conn->client) != 0)
+      {
+        uv_close ((uv_handle_t *) & conn->client, metrics_close_cb);
+        return;
+      }
+
+    metrics_build (& conn->text);
+    uv_buf_t buf = uv_buf_init (conn->text.buf, (unsigned int) conn->text.len);
+    if (uv_write (& conn->req, (uv_stream_t *) & conn->client, & buf, 1,
+                  metrics_write_cb) != 0)
+      uv_close ((uv_handle_t *) & conn->client, metrics_close_cb);
+  }
+
+static void metrics_server_close_cb (uv_handle_t * handle)
+  {
+    FREE (handle);
+  }
+
+void metrics_exit (void)
+  {
+    if (metrics_server)
+      {
+        uv_close ((uv_handle_t *) metrics_server, metrics_server_close_cb);
+        metrics_server = NULL;
+      }
+    if (metrics_path)
+      {
+        (void)unlink (metrics_path);
+        FREE (metrics_path);
+      }
+  }
+
+// METRICS <path> | OFF
+
+t_stat metrics_socket (UNUSED int32 arg, const char * buf)
+  {
+    if (! buf || ! * buf)
+      {
+        if (metrics_path)
+          sim_msg ("Metrics socket: %s\r\n", metrics_path);
+        else
+          sim_msg ("Metrics socket: off\r\n");
+        return SCPE_OK;
+      }
+
+    metrics_exit ();
+    if (strcasecmp (buf, "OFF") == 0)
+      return SCPE_OK;
+
+#if defined(S_ISSOCK)
+    // A socket left behind by an earlier run would make the bind fail
+    struct stat st;
+    if (stat (buf, & st) == 0 && S_ISSOCK (st.st_mode))
+      (void)unlink (buf);
+#endif /* if defined(S_ISSOCK) */
+
+    uv_pipe_t * server = malloc (sizeof (uv_pipe_t));
+    if (! server)
+      out_of_memory (__func__, __LINE__);
+    uv_pipe_init (uv_default_loop (), server, 0);
+
+    int rc = uv_pipe_bind (server, buf);
+    if (rc == 0)
+      rc = uv_listen ((uv_stream_t *) server, METRICS_BACKLOG, metrics_connection);
+    if (rc != 0)
+      {
+        sim_warn ("METRICS: cannot listen on %s: %s\r\n", buf, uv_strerror (rc));
+        uv_close ((uv_handle_t *) server, metrics_server_close_cb);
+        return SCPE_OPENERR;
+      }
+
+    metrics_server = server;
+    metrics_path   = strdup (buf);
+    if (! metrics_path)
+      out_of_memory (__func__, __LINE__);
+    return SCPE_OK;
+  }
+
+t_stat metrics_show (UNUSED int32 arg, UNUSED const char * buf)
+  {
+    mtext_t text;
+    metrics_build (& text);
+    char * line = text.buf;
+    char * nl;
+    while ((nl = strchr (line, '\n')) != NULL)
+      {
+        * nl = 0;
+        sim_printf ("%s\r\n", line);
+        line = nl + 1;
+      }
+    FREE (text.buf);
+    return SCPE_OK;
+  }
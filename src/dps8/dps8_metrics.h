@@ -0,0 +1,35 @@
+/*
+ * vim: filetype=c:tabstop=4:ai:expandtab
+ * SPDX-License-Identifier: ICU
+ * scspell-id: 5d1e7c62-ab2f-11f1-9a6e-80ee73e9b8e7
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Copyright (c) 2026 The DPS8M Development Team
+ *
+ * This software is made available under the terms of the ICU License.
+ * See the LICENSE.md file at the top-level directory of this distribution.
+ *
+ * ---------------------------------------------------------------------------
+ */
+
+#if !defined(INCLUDED_DPS8_METRICS_H)
+# define INCLUDED_DPS8_METRICS_H
+
+// Activity counters have a single writer and are read, unlocked, by the
+// metrics exporter. Relaxed loads and stores keep each read whole without
+// making the writer pay for a locked read-modify-write.
+# if defined(__GNUC__) || defined(__clang__)
+#  define METRIC_GET(c)    __atomic_load_n (& (c), __ATOMIC_RELAXED)
+#  define METRIC_ADD(c, n) \
+     __atomic_store_n (& (c), METRIC_GET (c) + (n), __ATOMIC_RELAXED)
+# else
+#  define METRIC_GET(c)    (c)
+#  define METRIC_ADD(c, n) ((c) += (n))
+# endif
+
+t_stat metrics_socket (int32 arg, const char * buf);
+t_stat metrics_show (int32 arg, const char * buf);
+void metrics_exit (void);
+
+#endif /* if !defined(INCLUDED_DPS8_METRICS_H) */
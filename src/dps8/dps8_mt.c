@@ -45,6 +45,10 @@
 #include "dps8_utils.h"
 #include "dps8_mt.h"
 
+#if defined(LOCKLESS)
+# include "threadz.h"
+#endif /* if defined(LOCKLESS) */
+
 #define DBG_CTR 1
 
 #if defined(FREE)
@@ -397,10 +401,21 @@ UNIT mt_unit [N_MT_UNITS_MAX] = {
 
 #define UNIT_WATCH (1 << MTUF_V_UF)
 
+#if defined(LOCKLESS)
+# define LOCK_TAPE(n)   lock_ptr (& tape_states[n].tape_lock)
+# define UNLOCK_TAPE(n) unlock_ptr (& tape_states[n].tape_lock)
+#else
+# define LOCK_TAPE(n)
+# define UNLOCK_TAPE(n)
+#endif /* if defined(LOCKLESS) */
+
 static t_stat mt_rewind (UNIT * uptr, UNUSED int32 value,
                          UNUSED const char * cptr, UNUSED void * desc)
   {
-    return sim_tape_rewind (uptr);
+    LOCK_TAPE (MT_UNIT_NUM (uptr));
+    t_stat stat = sim_tape_rewind (uptr);
+    UNLOCK_TAPE (MT_UNIT_NUM (uptr));
+    return stat;
   }
 
 static t_stat mt_show_nunits (UNUSED FILE * st, UNUSED UNIT * uptr,
@@ -661,7 +676,9 @@ static t_stat mt_set_capac (UNUSED UNIT * uptr, UNUSED int32 value,
     // allows setting capacity even though the boot tape is attached.
     for (i = 1; i < N_MT_UNITS_MAX; i ++)
       {
+        LOCK_TAPE (i);
         rc = sim_tape_set_capac (mt_unit + i, value, cptr, desc);
+        UNLOCK_TAPE (i);
         if (rc != SCPE_OK)
           return rc;
       }
@@ -838,11 +855,29 @@ static MTAB mt_mod [] =
     { 0, 0, NULL, NULL, NULL, NULL, NULL, NULL }
   };
 
+static t_stat mt_attach (UNIT * uptr, CONST char * cptr)
+  {
+    LOCK_TAPE (MT_UNIT_NUM (uptr));
+    t_stat stat = sim_tape_attach (uptr, cptr);
+    UNLOCK_TAPE (MT_UNIT_NUM (uptr));
+    return stat;
+  }
+
+static t_stat mt_detach (UNIT * uptr)
+  {
+    LOCK_TAPE (MT_UNIT_NUM (uptr));
+    t_stat stat = sim_tape_detach (uptr);
+    UNLOCK_TAPE (MT_UNIT_NUM (uptr));
+    return stat;
+  }
+
 static t_stat mt_reset (DEVICE * dptr)
   {
     for (int i = 0; i < (int) dptr -> numunits; i ++)
       {
+        LOCK_TAPE (i);
         sim_tape_reset (& mt_unit [i]);
+        UNLOCK_TAPE (i);
         //sim_cancel (& mt_unit [i]);
       }
     return SCPE_OK;
@@ -864,8 +899,8 @@ DEVICE tape_dev =
     NULL,              /* Deposit routine     */
     mt_reset,          /* Reset routine       */
     NULL,              /* Boot routine        */
-    &sim_tape_attach,  /* Attach routine      */
-    &sim_tape_detach,  /* Detach routine      */
+    &mt_attach,        /* Attach routine      */
+    &mt_detach,        /* Detach routine      */
     NULL,              /* Context             */
     DEV_DEBUG,         /* Flags               */
     0,                 /* Debug control flags */
@@ -938,7 +973,7 @@ t_stat loadTape (uint driveNumber, char * tapeFilename, bool ro)
     deterimeFullTapeFileName(tapeFilename, full_tape_file_name, (sizeof(full_tape_file_name)-1));
 
     sim_printf("loadTape Attaching drive %u to file %s\r\n", driveNumber, full_tape_file_name);
-    t_stat stat = sim_tape_attach (& mt_unit [driveNumber], full_tape_file_name);
+    t_stat stat = mt_attach (& mt_unit [driveNumber], full_tape_file_name);
     if (stat != SCPE_OK)
       {
         sim_printf ("%s sim_tape_attach returned %d\r\n", __func__, stat);
@@ -951,7 +986,7 @@ t_stat unloadTape (uint driveNumber)
   {
     if (mt_unit [driveNumber] . flags & UNIT_ATT)
       {
-        t_stat stat = sim_tape_detach (& mt_unit [driveNumber]);
+        t_stat stat = mt_detach (& mt_unit [driveNumber]);
         if (stat != SCPE_OK)
           {
             sim_warn ("%s sim_tape_detach returned %d\r\n", __func__, stat);
@@ -964,9 +999,23 @@ t_stat unloadTape (uint driveNumber)
 void mt_init(void)
   {
     (void)memset(tape_states, 0, sizeof(tape_states));
+#if defined(LOCKLESS)
+# if defined(__FreeBSD__)
+    pthread_mutexattr_t tape_attr;
+    pthread_mutexattr_init (& tape_attr);
+    pthread_mutexattr_settype (& tape_attr, PTHREAD_MUTEX_ADAPTIVE_NP);
+# endif /* if defined(__FreeBSD__) */
+#endif /* if defined(LOCKLESS) */
     for (int i = 0; i < N_MT_UNITS_MAX; i ++)
       {
         mt_unit [i] . capac = 40000000;
+#if defined(LOCKLESS)
+# if defined(__FreeBSD__)
+        pthread_mutex_init (& tape_states[i].tape_lock, & tape_attr);
+# else
+        pthread_mutex_init (& tape_states[i].tape_lock, NULL);
+# endif /* if defined(__FreeBSD__) */
+#endif /* if defined(LOCKLESS) */
       }
   }
 
@@ -1074,21 +1123,20 @@ static iom_cmd_rc_t mtReadRecord (uint devUnitIdx, uint iomUnitIdx, uint chan)
                "%s: Tally %d (%o)\r\n", __func__, tally, tally);
 
     word36 buffer [tally];
-    uint i;
-    int rc2;
-    for (i = 0; i < tally; i ++)
+    if (tape_statep -> is9)
       {
-        if (tape_statep -> is9)
-          rc2 = extractASCII36FromBuffer (tape_statep -> buf,
-                  tape_statep -> tbc, & tape_statep -> words_processed, buffer + i);
-        else
-          rc2 = extractWord36FromBuffer (tape_statep -> buf,
-                  tape_statep -> tbc, & tape_statep -> words_processed, buffer + i);
-        if (rc2)
+        for (uint i = 0; i < tally; i ++)
           {
-             break;
+            if (extractASCII36FromBuffer (tape_statep -> buf,
+                  tape_statep -> tbc, & tape_statep -> words_processed, buffer + i))
+              break;
           }
       }
+    else
+      {
+        (void)extractWord36BlockFromBuffer (tape_statep -> buf,
+                  tape_statep -> tbc, & tape_statep -> words_processed, buffer, tally);
+      }
 #if 0
             if (tape_statep -> is9) {
               sim_printf ("<");
@@ -1295,34 +1343,33 @@ static int mtWriteRecord (uint devUnitIdx, uint iomUnitIdx, uint chan)
 
     tape_statep -> words_processed = 0;
     uint i;
-    for (i = 0; i < tally; i ++)
+    if (tape_statep -> is9)
       {
-        int rc2;
-        if (tape_statep -> is9)
-          {
-            rc2 = insertASCII36toBuffer (tape_statep -> buf,
-                                         tape_statep -> tbc,
-                                         & tape_statep -> words_processed,
-                                         buffer [i]);
-          }
-        else
-          {
-            rc2 = insertWord36toBuffer (tape_statep -> buf,
-                                        tape_statep -> tbc,
-                                        & tape_statep -> words_processed,
-                                        buffer [i]);
-            }
-        if (rc2)
+        for (i = 0; i < tally; i ++)
           {
-            p -> stati = 04000;
-            if (sim_tape_wrp (unitp))
-              p -> stati |= 1;
-            sim_debug (DBG_WARN, & tape_dev,
-                       "%s: Write buffer exhausted on channel %d\r\n",
-                       __func__, chan);
-            break;
+            if (insertASCII36toBuffer (tape_statep -> buf,
+                                       tape_statep -> tbc,
+                                       & tape_statep -> words_processed,
+                                       buffer [i]))
+              break;
           }
       }
+    else
+      {
+        i = insertWord36BlockToBuffer (tape_statep -> buf,
+                                       tape_statep -> tbc,
+                                       & tape_statep -> words_processed,
+                                       buffer, tally);
+      }
+    if (i < tally)
+      {
+        p -> stati = 04000;
+        if (sim_tape_wrp (unitp))
+          p -> stati |= 1;
+        sim_debug (DBG_WARN, & tape_dev,
+                   "%s: Write buffer exhausted on channel %d\r\n",
+                   __func__, chan);
+      }
     p -> tallyResidue = (word12) (tally - i);
 
 // XXX This assumes that the tally was bigger than the record
@@ -1475,7 +1522,7 @@ static int surveyDevices (uint iomUnitIdx, uint chan)
 // set file protect, reserve device, release device, read control registers
 //   no idcw.
 
-iom_cmd_rc_t mt_iom_cmd (uint iomUnitIdx, uint chan) {
+static iom_cmd_rc_t mt_iom_cmd_unit (uint iomUnitIdx, uint chan) {
   iom_chan_data_t * p = & iom_chan_data [iomUnitIdx] [chan];
 #if defined(TESTING)
   cpu_state_t * cpup = _cpup;
@@ -2385,6 +2432,27 @@ iom_cmd_rc_t mt_iom_cmd (uint iomUnitIdx, uint chan) {
   }
 
   return rc;
+} // mt_iom_cmd_unit
+
+// The IOM runs tape channels without lock_iom; the drive's lock keeps a
+// second channel on the same MTP, or an SCP command, off the drive's
+// tape_state and sim_tape context while the program runs.
+
+iom_cmd_rc_t mt_iom_cmd (uint iomUnitIdx, uint chan) {
+#if defined(LOCKLESS)
+  iom_chan_data_t * p = & iom_chan_data [iomUnitIdx] [chan];
+  uint ctlr_unit_idx = get_ctlr_idx (iomUnitIdx, chan);
+  uint dev_code = p->IDCW_DEV_CODE;
+  if (dev_code == 0)
+    dev_code = mtp_state[ctlr_unit_idx].boot_drive;
+  uint devUnitIdx = cables->mtp_to_tape[ctlr_unit_idx][dev_code].unit_idx;
+  LOCK_TAPE (devUnitIdx);
+  iom_cmd_rc_t rc = mt_iom_cmd_unit (iomUnitIdx, chan);
+  UNLOCK_TAPE (devUnitIdx);
+  return rc;
+#else
+  return mt_iom_cmd_unit (iomUnitIdx, chan);
+#endif /* if defined(LOCKLESS) */
 } // mt_iom_cmd
 
 // 031 read statistics
@@ -36,6 +36,10 @@ struct tape_state
     word16 cntlrAddress;
     word16 cntlrTally;
     int tape_length;
+#if defined(LOCKLESS)
+    // Held while a channel program or an SCP command works on the drive
+    pthread_mutex_t tape_lock;
+#endif
   };
 
 extern struct tape_state tape_states [N_MT_UNITS_MAX];
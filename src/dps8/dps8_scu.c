@@ -555,7 +555,12 @@
 
 #define DBG_CTR 1
 
+#if defined(M_SHARED)
+// In the system state, so that SCU state is visible to other processes
+scu_t * scu = NULL;
+#else
 scu_t scu [N_SCU_UNITS_MAX];
+#endif /* if defined(M_SHARED) */
 
 #define N_SCU_UNITS 1 // Default
 
@@ -675,7 +680,7 @@ static t_stat scu_show_state (UNUSED FILE * st, UNIT *uptr, UNUSED int val,
                     scup -> mask_assignment [i]);
         sim_printf ("        cells ");
         for (int j = 0; j < N_CELL_INTERRUPTS; j ++)
-          sim_printf("%d", scup -> cells [j]);
+          sim_printf("%d", (scup -> cells & SCU_CELL (j)) ? 1 : 0);
         sim_printf ("\r\n");
       }
     sim_printf("Lower store size: %d\r\n", scup -> lower_store_size);
@@ -1079,7 +1084,7 @@ static void dump_intr_regs (char * ctx, uint scu_unit_idx)
 
     sim_debug (DBG_DEBUG, & scu_dev, "%s set cells:", ctx);
     for (uint i = 0; i < N_CELL_INTERRUPTS; i ++)
-      if (up -> cells [i])
+      if (up -> cells & SCU_CELL (i))
         {
           sim_debug (DBG_DEBUG, & scu_dev, " %d", i);
         }
@@ -1108,7 +1113,7 @@ static void dump_intr_regs (char * ctx, uint scu_unit_idx)
 
     sim_printf ("%s set cells:", ctx);
     for (uint i = 0; i < N_CELL_INTERRUPTS; i ++)
-      if (up -> cells [i])
+      if (up -> cells & SCU_CELL (i))
         {
           sim_printf (" %d", i);
         }
@@ -1319,7 +1324,7 @@ static char * pcells (uint scu_unit_idx, char * buf)
   {
     for (uint i = 0; i < N_CELL_INTERRUPTS; i ++)
       {
-        if (scu [scu_unit_idx].cells [i])
+        if (scu [scu_unit_idx].cells & SCU_CELL (i))
           buf [i] = '1';
         else
           buf [i] = '0';
@@ -1328,18 +1333,156 @@ static char * pcells (uint scu_unit_idx, char * buf)
     return buf;
   }
 
-// Either an interrupt has arrived on a port, or a mask register has
-// been updated. Bring the CPU up date on the interrupts.
+// Update the interrupt cells. Setting a cell is lock-free, so that IOM
+// terminate interrupts do not serialize on the SCU lock; clearing is
+// done under the lock, and uses the returned previous value.
+
+static inline word32 cells_or (scu_t * up, word32 bits)
+  {
+#if defined(THREADZ) || defined(LOCKLESS)
+    return atomic_fetch_or (& up->cells, bits);
+#else
+    word32 old = up->cells;
+    up->cells = old | bits;
+    return old;
+#endif /* if defined(THREADZ) || defined(LOCKLESS) */
+  }
+
+static inline word32 cells_and (scu_t * up, word32 bits)
+  {
+#if defined(THREADZ) || defined(LOCKLESS)
+    return atomic_fetch_and (& up->cells, bits);
+#else
+    word32 old = up->cells;
+    up->cells = old & bits;
+    return old;
+#endif /* if defined(THREADZ) || defined(LOCKLESS) */
+  }
+
+static inline void masks_changed (scu_t * up)
+  {
+#if defined(THREADZ) || defined(LOCKLESS)
+    atomic_fetch_add (& up->maskGen, 1);
+#else
+    (void) up;
+#endif /* if defined(THREADZ) || defined(LOCKLESS) */
+  }
+
+// Set XIP on the CPUs whose assigned mask register enables any of 'cells'.
+// XIP is only set here, never cleared, so this is safe without the SCU
+// lock as long as the cells were set first: a concurrent
+// deliver_interrupts either sees the cells or runs its clear before our
+// set. With 'lockFree', false is returned, and the caller delivers under
+// the lock instead, if a CPU would need its thread started, or if the
+// masks changed while they were being read (XIP may then have been set
+// from stale masks; the locked delivery clears and recomputes it).
 
 // threadz notes:
 //
-// deliver_interrupts is called either from a CPU instruction or from
-// IOM set_general_interrupt on the IOM thread.
-//
 // potential race conditions:
 //   CPU variables: XIP
 //   SCU variables: cells, mask_enable, exec_intr_mask, mask assignment
 
+static bool post_interrupts (cpu_state_t * cpup, uint scu_unit_idx,
+                             word32 cells, bool lockFree)
+  {
+#if !defined(THREADZ) && !defined(LOCKLESS)
+    (void) cpup;
+    (void) lockFree;
+#else
+    uint maskGen = scu [scu_unit_idx].maskGen;
+#endif
+    for (uint pima = 0; pima < N_ASSIGNMENTS; pima ++) // A, B
+      {
+        if (scu [scu_unit_idx].mask_enable [pima] == 0)
+          continue;
+        uint mask = scu [scu_unit_idx].exec_intr_mask [pima];
+        uint port = scu [scu_unit_idx].mask_assignment [pima];
+        if (scu [scu_unit_idx].ports [port].type != ADEV_CPU)
+          continue;
+        if ((mask & cells) == 0)
+          continue;
+        uint inum = (uint) __builtin_clz (mask & cells);
+        sim_debug (DBG_INTR, & scu_dev,
+                   "scu %u trying to deliver %d\r\n", scu_unit_idx, inum);
+        uint sn = 0;
+        if (scu[scu_unit_idx].ports[port].is_exp)
+          {
+            sn = (uint) scu[scu_unit_idx].ports[port].xipmaskval;
+            if (sn >= N_SCU_SUBPORTS)
+              {
+                sim_warn ("XIP mask not set; defaulting to subport 0\r\n");
+                sn = 0;
+              }
+          }
+        if (! cables->scu_to_cpu[scu_unit_idx][port][sn].in_use)
+          {
+            sim_warn ("bad scu_unit_idx %u\r\n", scu_unit_idx);
+            continue;
+          }
+        uint cpu_unit_udx = cables->scu_to_cpu[scu_unit_idx][port][sn].cpu_unit_idx;
+#if defined(THREADZ) || defined(LOCKLESS)
+        if (lockFree && ! cpuThreadz[cpu_unit_udx].run)
+          return false;
+        // Need to do this before setting XIP to avoid race condition
+        // We are about to interrupt a CPU; this is done to either
+        //   Multics signalling, such has CAM cache clear
+        //   Adding a new CPU
+        //   Reading a deleted CPU
+        //   Starting an ISOLTS CPU
+        // If it is a Multics signal, the target CPU will be marked as 'inMultics';
+        // For the other cases, 'inMultics ' will not be set.
+        // cpup != NULL means that this interrupt was generated by a CPU, rather
+        // than an IOM; we need this to set the calling thread into slave mode.
+        if ((! sys_opts.nosync) && cpup && (! cpus[cpu_unit_udx].inMultics)) {
+          // The interrupt is to start or restart a CPU.
+# ifdef SYNCTEST
+          sim_printf ("CPU %c becomes clock master\r\n", 'A' + cpu_unit_udx);
+# endif
+          becomeClockMaster (cpu_unit_udx);
+        }
+        cpus[cpu_unit_udx].events.XIP[scu_unit_idx] = true;
+# if defined(TESTING)
+        HDBGIntrSet (inum, cpu_unit_udx, scu_unit_idx, __func__);
+# endif
+# ifdef SYNCTEST
+if (cpus[cpu_unit_udx].rcfDelete) sim_printf ("Poking CPU %c in rcfDelete\r\n", 'A' + cpu_unit_udx);
+# endif
+        createCPUThread((uint) cpu_unit_udx);
+# if !defined(NO_TIMEWAIT)
+        wakeCPU ((uint) cpu_unit_udx);
+# endif
+        sim_debug (DBG_DEBUG, & scu_dev,
+                   "interrupt set for CPU %d SCU %d\r\n",
+                   cpu_unit_udx, scu_unit_idx);
+#else // ! THREADZ
+        cpus[cpu_unit_udx].events.XIP[scu_unit_idx] = true;
+sim_debug (DBG_DEBUG, & scu_dev, "interrupt set for CPU %d SCU %d\r\n", cpu_unit_udx, scu_unit_idx);
+        sim_debug (DBG_INTR, & scu_dev,
+                   "XIP set for SCU %d\r\n", scu_unit_idx);
+#endif // ! THREADZ
+      }
+#if defined(THREADZ) || defined(LOCKLESS)
+    // The XIP stores must be visible before the generation is rechecked;
+    // a mask change not yet counted is followed by its own delivery.
+    if (lockFree)
+      {
+        atomic_thread_fence (memory_order_seq_cst);
+        if (scu [scu_unit_idx].maskGen != maskGen)
+          return false;
+      }
+#endif /* if defined(THREADZ) || defined(LOCKLESS) */
+    return true;
+  }
+
+// Either an interrupt has arrived on a port, or a mask register has
+// been updated. Bring the CPU up date on the interrupts.
+
+// threadz notes:
+//
+// deliver_interrupts is called from a CPU instruction, or from the IOM
+// via scu_set_interrupt when the lock-free path can't be used.
+
 // Always called with SCU lock set
 
 static void deliver_interrupts (cpu_state_t * cpup, uint scu_unit_idx)
@@ -1350,193 +1493,16 @@ static void deliver_interrupts (cpu_state_t * cpup, uint scu_unit_idx)
       sim_debug (DBG_DEBUG, & scu_dev, "deliver_interrupts %o\r\n", scu_unit_idx);
     }
 #endif
-#if defined(THREADZ) || defined(LOCKLESS)
-    atomic_thread_fence (memory_order_seq_cst);
-#endif /* defined(THREADZ) || defined(LOCKLESS) */
     for (uint cpun = 0; cpun < cpu_dev.numunits; cpun ++)
       {
         cpus[cpun].events.XIP[scu_unit_idx] = false;
       }
-
-// If the CIOC generates marker and terminate interrupts, they will be posted simultaneously.
-// Since the interrupts are recognized by priority and terminate has a higher priority then
-// marker, if will be delivered first. The following code will deliver marker before terminate.
-
-#if defined(REORDER)
-    for (uint jnum = 0; jnum < N_CELL_INTERRUPTS; jnum ++)
-      {
-        static const uint reorder[N_CELL_INTERRUPTS] = {
-           0,  1,  2,  3,  4,  5,  6,  7,
-          16, 17, 18, 29, 20, 21, 22, 23,
-           8,  9, 10, 11, 12, 13, 14, 15,
-          25, 25, 26, 27, 28, 29, 30, 31 };
-        uint inum = reorder[jnum];
-        if (! scu [scu_unit_idx].cells [inum])
-          continue; //
-        sim_debug (DBG_DEBUG, & scu_dev, "trying to deliver %d\r\n", inum);
-        sim_debug (DBG_INTR, & scu_dev,
-                   "scu %u trying to deliver %d\r\n", scu_unit_idx, inum);
-
-        for (uint pima = 0; pima < N_ASSIGNMENTS; pima ++) // A, B
-          {
-            //sim_debug (DBG_DEBUG, & scu_dev,
-            //           "trying inum %u pima %u enable %u\r\n"
-            //           , inum, pima, scu [scu_unit_idx].mask_enable [pima]);
-            if (scu [scu_unit_idx].mask_enable [pima] == 0)
-              continue;
-            uint mask = scu [scu_unit_idx].exec_intr_mask [pima];
-            uint port = scu [scu_unit_idx].mask_assignment [pima];
-            //sim_debug (DBG_DEBUG, & scu_dev,
-            //           "mask %u port %u type %u cells %o\r\n",
-            //           mask, port, scu [scu_unit_idx].ports [port].type,
-            //           scu [scu_unit_idx].cells [inum]);
-            if (scu [scu_unit_idx].ports [port].type != ADEV_CPU)
-              continue;
-            if ((mask & (1u << (31 - inum))) != 0)
-              {
-                uint sn = 0;
-                if (scu[scu_unit_idx].ports[port].is_exp)
-                  {
-                    sn = (uint) scu[scu_unit_idx].ports[port].xipmaskval;
-                    if (sn >= N_SCU_SUBPORTS)
-                      {
-                        sim_warn ("XIP mask not set; defaulting to subport 0\r\n");
-                        sn = 0;
-                      }
-                  }
-                if (! cables->scu_to_cpu[scu_unit_idx][port][sn].in_use)
-                  {
-                    sim_warn ("bad scu_unit_idx %u\r\n", scu_unit_idx);
-                    continue;
-                  }
-                uint cpu_unit_udx = cables->scu_to_cpu[scu_unit_idx][port][sn].cpu_unit_idx;
-# if defined(THREADZ) || defined(LOCKLESS)
-                // Need to do this before setting XIP to avoid race condition
-                // We are about to interrupt a CPU; this is done to either
-                //   Multics signalling, such has CAM cache clear
-                //   Adding a new CPU
-                //   Reading a deleted CPU
-                //   Starting an ISOLTS CPU
-                // If it is a Multics signal, the target CPU will be marked as 'inMultics';
-                // For the other cases, 'inMultics ' will not be set.
-                // cpup != NULL means that this interrupt was generated by a CPU, rather
-                // than an IOM; we need this to set the calling thread into slave mode.
-                if ((! sys.sys_opts.nosync) && cpup && (! cpus[cpu_unit_udx].inMultics)) {
-                  // The interrupt is to start or restart a CPU.
-#  ifdef SYNCTEST
-                  sim_printf ("CPU %c becomes clock master\r\n", 'A' + cpu_unit_udx);
-#  endif
-                  becomeClockMaster (cpu_unit_udx);
-                  // Set this so that the calling thread will join the queue immediately.
-                  cpu.syncClockModePoll = 0;
-                  cpu.syncClockModeCache = true;
-                  __asm volatile ("");
-                  atomic_thread_fence (memory_order_seq_cst);
-                }
-                cpus[cpu_unit_udx].events.XIP[scu_unit_idx] = true;
-#  if defined(TESTING)
-                HDBGIntrSet (inum, cpu_unit_udx, scu_unit_idx, __func__);
-#  endif
-                createCPUThread((uint) cpu_unit_udx);
-#  if !defined(NO_TIMEWAIT)
-                wakeCPU ((uint) cpu_unit_udx);
-#  endif
-                sim_debug (DBG_DEBUG, & scu_dev,
-                           "interrupt set for CPU %d SCU %d\r\n",
-                           cpu_unit_udx, scu_unit_idx);
-# else // ! THREADZ
-                cpus[cpu_unit_udx].events.XIP[scu_unit_idx] = true;
-sim_debug (DBG_DEBUG, & scu_dev, "interrupt set for CPU %d SCU %d\r\n", cpu_unit_udx, scu_unit_idx);
-                sim_debug (DBG_INTR, & scu_dev,
-                           "XIP set for SCU %d\r\n", scu_unit_idx);
-# endif // ! THREADZ
-              }
-          }
-      }
-#else // !REORDER
-    for (uint inum = 0; inum < N_CELL_INTERRUPTS; inum ++)
-      {
-        if (! scu [scu_unit_idx].cells [inum])
-          continue; //
-        sim_debug (DBG_DEBUG, & scu_dev, "trying to deliver %d\r\n", inum);
-        sim_debug (DBG_INTR, & scu_dev,
-                   "scu %u trying to deliver %d\r\n", scu_unit_idx, inum);
-
-        for (uint pima = 0; pima < N_ASSIGNMENTS; pima ++) // A, B
-          {
-            //sim_debug (DBG_DEBUG, & scu_dev,
-            //           "trying inum %u pima %u enable %u\r\n"
-            //           , inum, pima, scu [scu_unit_idx].mask_enable [pima]);
-            if (scu [scu_unit_idx].mask_enable [pima] == 0)
-              continue;
-            uint mask = scu [scu_unit_idx].exec_intr_mask [pima];
-            uint port = scu [scu_unit_idx].mask_assignment [pima];
-            //sim_debug (DBG_DEBUG, & scu_dev,
-            //           "mask %u port %u type %u cells %o\r\n",
-            //           mask, port, scu [scu_unit_idx].ports [port].type,
-            //           scu [scu_unit_idx].cells [inum]);
-            if (scu [scu_unit_idx].ports [port].type != ADEV_CPU)
-              continue;
-            if ((mask & (1u << (31 - inum))) != 0)
-              {
-                uint sn = 0;
-                if (scu[scu_unit_idx].ports[port].is_exp)
-                  {
-                    sn = (uint) scu[scu_unit_idx].ports[port].xipmaskval;
-                    if (sn >= N_SCU_SUBPORTS)
-                      {
-                        sim_warn ("XIP mask not set; defaulting to subport 0\r\n");
-                        sn = 0;
-                      }
-                  }
-                if (! cables->scu_to_cpu[scu_unit_idx][port][sn].in_use)
-                  {
-                    sim_warn ("bad scu_unit_idx %u\r\n", scu_unit_idx);
-                    continue;
-                  }
-                uint cpu_unit_udx = cables->scu_to_cpu[scu_unit_idx][port][sn].cpu_unit_idx;
-# if defined(THREADZ) || defined(LOCKLESS)
-                // Need to do this before setting XIP to avoid race condition
-                // We are about to interrupt a CPU; this is done to either
-                //   Multics signalling, such has CAM cache clear
-                //   Adding a new CPU
-                //   Reading a deleted CPU
-                //   Starting an ISOLTS CPU
-                // If it is a Multics signal, the target CPU will be marked as 'inMultics';
-                // For the other cases, 'inMultics ' will not be set.
-                // cpup != NULL means that this interrupt was generated by a CPU, rather
-                // than an IOM; we need this to set the calling thread into slave mode.
-                if ((! sys_opts.nosync) && cpup && (! cpus[cpu_unit_udx].inMultics)) {
-                  // The interrupt is to start or restart a CPU.
-#  ifdef SYNCTEST
-                  sim_printf ("CPU %c becomes clock master\r\n", 'A' + cpu_unit_udx);
-#  endif
-                  becomeClockMaster (cpu_unit_udx);
-                }
-                cpus[cpu_unit_udx].events.XIP[scu_unit_idx] = true;
-#  if defined(TESTING)
-                HDBGIntrSet (inum, cpu_unit_udx, scu_unit_idx, __func__);
-#  endif
-#  ifdef SYNCTEST
-if (cpus[cpu_unit_udx].rcfDelete) sim_printf ("Poking CPU %c in rcfDelete\r\n", 'A' + cpu_unit_udx);
-#  endif
-                createCPUThread((uint) cpu_unit_udx);
-#  if !defined(NO_TIMEWAIT)
-                wakeCPU ((uint) cpu_unit_udx);
-#  endif
-                sim_debug (DBG_DEBUG, & scu_dev,
-                           "interrupt set for CPU %d SCU %d\r\n",
-                           cpu_unit_udx, scu_unit_idx);
-# else // ! THREADZ
-                cpus[cpu_unit_udx].events.XIP[scu_unit_idx] = true;
-sim_debug (DBG_DEBUG, & scu_dev, "interrupt set for CPU %d SCU %d\r\n", cpu_unit_udx, scu_unit_idx);
-                sim_debug (DBG_INTR, & scu_dev,
-                           "XIP set for SCU %d\r\n", scu_unit_idx);
-# endif // ! THREADZ
-              }
-          }
-      }
-#endif // REORDER
+    // The clear must be visible before the cells are read; see
+    // post_interrupts
+#if defined(THREADZ) || defined(LOCKLESS)
+    atomic_thread_fence (memory_order_seq_cst);
+#endif /* defined(THREADZ) || defined(LOCKLESS) */
+    (void) post_interrupts (cpup, scu_unit_idx, scu [scu_unit_idx].cells, false);
   }
 
 t_stat scu_smic (cpu_state_t * cpup, uint scu_unit_idx, uint UNUSED cpu_unit_udx,
@@ -1546,14 +1512,16 @@ t_stat scu_smic (cpu_state_t * cpup, uint scu_unit_idx, uint UNUSED cpu_unit_udx
     lock_scu ();
 #endif
 // smic can set cells but not reset them...
+    word32 bits = 0;
 #if 1
     if (getbits36_1 (rega, 35))
       {
         for (uint i = 0; i < 16; i ++)
           {
             if (getbits36_1 (rega, i))
-              scu [scu_unit_idx].cells [i + 16] = 1;
+              bits |= SCU_CELL (i + 16);
           }
+        cells_or (& scu [scu_unit_idx], bits);
         char pcellb [N_CELL_INTERRUPTS + 1];
         sim_debug (DBG_TRACE, & scu_dev,
                    "SMIC low: Unit %u Cells: %s\r\n",
@@ -1564,8 +1532,9 @@ t_stat scu_smic (cpu_state_t * cpup, uint scu_unit_idx, uint UNUSED cpu_unit_udx
         for (uint i = 0; i < 16; i ++)
           {
             if (getbits36_1 (rega, i))
-              scu [scu_unit_idx].cells [i] = 1;
+              bits |= SCU_CELL (i);
           }
+        cells_or (& scu [scu_unit_idx], bits);
         char pcellb [N_CELL_INTERRUPTS + 1];
         sim_debug (DBG_TRACE, & scu_dev,
                    "SMIC high: Unit %d Cells: %s\r\n",
@@ -1576,8 +1545,11 @@ t_stat scu_smic (cpu_state_t * cpup, uint scu_unit_idx, uint UNUSED cpu_unit_udx
       {
         for (uint i = 0; i < 16; i ++)
           {
-            scu [scu_unit_idx].cells [i + 16] = getbits36_1 (rega, i) ? 1 : 0;
+            if (getbits36_1 (rega, i))
+              bits |= SCU_CELL (i + 16);
           }
+        cells_and (& scu [scu_unit_idx], 0xffff0000u);
+        cells_or (& scu [scu_unit_idx], bits);
         char pcellb [N_CELL_INTERRUPTS + 1];
         sim_debug (DBG_TRACE, & scu_dev,
                    "SMIC low: Unit %u Cells: %s\r\n",
@@ -1587,9 +1559,11 @@ t_stat scu_smic (cpu_state_t * cpup, uint scu_unit_idx, uint UNUSED cpu_unit_udx
       {
         for (uint i = 0; i < 16; i ++)
           {
-            scu [scu_unit_idx].cells [i] =
-              getbits36_1 (rega, i) ? 1 : 0;
+            if (getbits36_1 (rega, i))
+              bits |= SCU_CELL (i);
           }
+        cells_and (& scu [scu_unit_idx], 0x0000ffffu);
+        cells_or (& scu [scu_unit_idx], bits);
         char pcellb [N_CELL_INTERRUPTS + 1];
         sim_debug (DBG_TRACE, & scu_dev,
                    "SMIC high: Unit %d Cells: %s\r\n",
@@ -1744,6 +1718,7 @@ t_stat scu_sscr (cpu_state_t * cpup, uint scu_unit_idx, UNUSED uint cpu_unit_udx
             up -> port_enable [5]  = (regq >>  2) & 01;
             up -> port_enable [6]  = (regq >>  1) & 01;
             up -> port_enable [7]  = (regq >>  0) & 01;
+            masks_changed (up);
 
 #if defined(THREADZ) || defined(LOCKLESS)
             unlock_scu ();
@@ -1830,6 +1805,7 @@ t_stat scu_sscr (cpu_state_t * cpup, uint scu_unit_idx, UNUSED uint cpu_unit_udx
                        scu [scu_unit_idx].exec_intr_mask [mask_num]);
             dump_intr_regs ("sscr set mask", scu_unit_idx);
             scu [scu_unit_idx].mask_enable [mask_num] = 1;
+            masks_changed (& scu [scu_unit_idx]);
             sim_debug (DBG_INTR, & scu_dev,
                        "SCU%u SSCR2 exec_intr mask %c set to 0x%08x"
                        " and enabled.\r\n",
@@ -1848,13 +1824,15 @@ t_stat scu_sscr (cpu_state_t * cpup, uint scu_unit_idx, UNUSED uint cpu_unit_udx
 #if defined(THREADZ) || defined(LOCKLESS)
             lock_scu ();
 #endif
+            word32 bits = 0;
             for (uint i = 0; i < 16; i ++)
               {
-                scu [scu_unit_idx].cells [i] =
-                  getbits36_1 (rega, i) ? 1 : 0;
-                scu [scu_unit_idx].cells [i + 16] =
-                  getbits36_1 (regq, i) ? 1 : 0;
+                if (getbits36_1 (rega, i))
+                  bits |= SCU_CELL (i);
+                if (getbits36_1 (regq, i))
+                  bits |= SCU_CELL (i + 16);
               }
+            scu [scu_unit_idx].cells = bits;
             char pcellb [N_CELL_INTERRUPTS + 1];
             sim_debug (DBG_TRACE, & scu_dev,
                        "SSCR Set int. cells: Unit %u Cells: %s\r\n",
@@ -2129,9 +2107,10 @@ gotit:;
             scu_t * up = scu + scu_unit_idx;
             // * rega = up -> exec_intr_mask [0];
             // * regq = up -> exec_intr_mask [1];
+            word32 cells = up -> cells;
             for (uint i = 0; i < N_CELL_INTERRUPTS; i ++)
               {
-                word1 cell = up -> cells [i] ? 1 : 0;
+                word1 cell = (cells & SCU_CELL (i)) ? 1 : 0;
                 if (i < 16)
                   putbits36_1 (rega, i, cell);
                 else
@@ -2236,9 +2215,9 @@ clock_gettime (CLOCK_REALTIME, & cioc_t0);
                cpu_unit_udx, scu_unit_idx, scu_port_num,
               expander_command, sub_mask);
 #endif
-#if defined(THREADZ) || defined(LOCKLESS)
-    lock_scu ();
-#endif
+    // Only the expander commands change SCU state; a connect to a CPU is
+    // an atomic G7 fault set and a connect to an IOM takes the IOM's own
+    // locks, so neither needs the SCU lock.
     struct ports * portp = & scu [scu_unit_idx].ports [scu_port_num];
 
     int rc = 0;
@@ -2255,10 +2234,16 @@ clock_gettime (CLOCK_REALTIME, & cioc_t0);
 
     if (expander_command == 1) // "set subport enables"
       {
+#if defined(THREADZ) || defined(LOCKLESS)
+        lock_scu ();
+#endif
         for (uint i = 0; i < N_SCU_SUBPORTS; i++)
           {
             portp->subport_enables [i] = !! (sub_mask & (0200u >> i));
           }
+#if defined(THREADZ) || defined(LOCKLESS)
+        unlock_scu ();
+#endif
         goto done;
       }
 
@@ -2266,6 +2251,9 @@ clock_gettime (CLOCK_REALTIME, & cioc_t0);
       {
         int cnt = 0;
         int val = -1;
+#if defined(THREADZ) || defined(LOCKLESS)
+        lock_scu ();
+#endif
         for (uint i = 0; i < N_SCU_SUBPORTS; i++)
           {
             portp->xipmask [i] = !! (sub_mask & (0200u >> i));
@@ -2281,6 +2269,9 @@ clock_gettime (CLOCK_REALTIME, & cioc_t0);
             val = -1;
           }
         portp->xipmaskval = val;
+#if defined(THREADZ) || defined(LOCKLESS)
+        unlock_scu ();
+#endif
         goto done;
       }
 
@@ -2288,13 +2279,17 @@ clock_gettime (CLOCK_REALTIME, & cioc_t0);
       {
         int iom_unit_idx = portp->dev_idx;
 #if defined(THREADZ) || defined(LOCKLESS)
-        unlock_scu ();
-# if !defined(IO_ASYNC_PAYLOAD_CHAN) && !defined(IO_ASYNC_PAYLOAD_CHAN_THREAD)
+// LOCKLESS: iom_interrupt runs the list service under the IOM's connect
+// lock, then each channel under its channel and drive locks, or under
+// lock_iom/lock_libuv for controllers without drive locks (see
+// startPayloadChannel). Holding lock_iom here too would serialize every
+// connect again.
+# if !defined(LOCKLESS) && !defined(IO_ASYNC_PAYLOAD_CHAN) && !defined(IO_ASYNC_PAYLOAD_CHAN_THREAD)
         lock_iom ();
         lock_libuv ();
 # endif
         iom_interrupt (scu_unit_idx, (uint) iom_unit_idx);
-# if !defined(IO_ASYNC_PAYLOAD_CHAN) && !defined(IO_ASYNC_PAYLOAD_CHAN_THREAD)
+# if !defined(LOCKLESS) && !defined(IO_ASYNC_PAYLOAD_CHAN) && !defined(IO_ASYNC_PAYLOAD_CHAN_THREAD)
         unlock_libuv ();
         unlock_iom ();
 # endif
@@ -2394,9 +2389,6 @@ clock_gettime (CLOCK_REALTIME, & cioc_t0);
         goto done;
       }
 done:
-#if defined(THREADZ) || defined(LOCKLESS)
-    unlock_scu ();
-#endif
     return rc;
 }
 
@@ -2424,11 +2416,15 @@ int scu_set_interrupt (uint scu_unit_idx, uint inum)
         return 1;
       }
 
+    // Setting a cell only ever adds XIP bits, so it can be posted without
+    // the SCU lock; starting a CPU thread still goes through the lock.
+    cells_or (& scu [scu_unit_idx], SCU_CELL (inum));
+    dump_intr_regs ("scu_set_interrupt", scu_unit_idx);
+    if (post_interrupts (NULL, scu_unit_idx, SCU_CELL (inum), true))
+      return 0;
 #if defined(THREADZ) || defined(LOCKLESS)
     lock_scu ();
 #endif
-    scu [scu_unit_idx].cells [inum] = 1;
-    dump_intr_regs ("scu_set_interrupt", scu_unit_idx);
     deliver_interrupts (NULL, scu_unit_idx);
 #if defined(THREADZ) || defined(LOCKLESS)
     unlock_scu ();
@@ -2464,13 +2460,13 @@ uint scu_get_highest_intr (uint scu_unit_idx)
             if (scu[scu_unit_idx].ports[port].type != ADEV_CPU ||
                 cpus[current_running_cpu_idx].scu_port[scu_unit_idx] != port)
               continue;
-            if (scu [scu_unit_idx].cells [inum] &&
-                (mask & (1u << (31 - inum))) != 0)
+            if ((scu [scu_unit_idx].cells & SCU_CELL (inum)) &&
+                (mask & SCU_CELL (inum)) != 0)
               {
                 sim_debug (DBG_TRACE, & scu_dev,
                            "scu_get_highest_intr inum %d pima %u mask 0%011o port %u cells 0%011o\r\n",
-                           inum, pima, mask, port, scu [scu_unit_idx].cells [inum]);
-                scu [scu_unit_idx].cells [inum] = false;
+                           inum, pima, mask, port, scu [scu_unit_idx].cells);
+                cells_and (& scu [scu_unit_idx], ~ SCU_CELL (inum));
                 dump_intr_regs ("scu_get_highest_intr", scu_unit_idx);
                 deliver_interrupts (NULL, scu_unit_idx);
 #if defined(THREADZ) || defined(LOCKLESS)
@@ -2480,6 +2476,9 @@ uint scu_get_highest_intr (uint scu_unit_idx)
               }
           }
       }
+    // XIP was set, but no cell is pending for this CPU; recompute XIP from
+    // the cells so a stale XIP is not sampled again and again.
+    deliver_interrupts (NULL, scu_unit_idx);
 #if defined(THREADZ) || defined(LOCKLESS)
     unlock_scu ();
 #endif
@@ -2701,6 +2700,7 @@ gotit:;
     scu [scu_unit_idx].port_enable [5] = (uint) getbits36_1 (regq, 33);
     scu [scu_unit_idx].port_enable [6] = (uint) getbits36_1 (regq, 34);
     scu [scu_unit_idx].port_enable [7] = (uint) getbits36_1 (regq, 35);
+    masks_changed (up);
 
     dump_intr_regs ("smcm", scu_unit_idx);
     deliver_interrupts (NULL, scu_unit_idx);
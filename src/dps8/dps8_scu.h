@@ -39,8 +39,13 @@ typedef struct
     // if (mask_enable) then mask_assignment is a port number
     volAtomic uint mask_enable [N_ASSIGNMENTS];     // enable/disable
     volAtomic uint mask_assignment [N_ASSIGNMENTS]; // assigned port number
+    // Bumped under the SCU lock whenever the masks above change; lets
+    // the lock-free interrupt post detect that it read stale masks.
+    volAtomic uint maskGen;
 
-    volAtomic uint cells [N_CELL_INTERRUPTS];
+    // Interrupt cells; cell n is bit 31-n, matching exec_intr_mask
+    volAtomic word32 cells;
+#define SCU_CELL(inum) (1u << (31 - (inum)))
 
     uint lower_store_size; // In K words, power of 2; 32 - 4096
     uint cyclic;           // 7 bits
@@ -85,7 +90,11 @@ typedef struct
     uint64 last_time;
 } scu_t;
 
+#if defined(M_SHARED)
+extern scu_t * scu;
+#else
 extern scu_t scu [N_SCU_UNITS_MAX];
+#endif /* if defined(M_SHARED) */
 
 extern DEVICE scu_dev;
 
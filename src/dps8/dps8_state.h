@@ -73,7 +73,7 @@ struct symbolTable_s {
 
 #define STATE_HDR     "dps8m state"
 #define STATE_HDR_SZ  16
-#define STATE_VER     1
+#define STATE_VER     2
 
 struct system_state_s {
   // The first three are fixed layout
@@ -82,9 +82,11 @@ struct system_state_s {
   struct      symbolTable_s symbolTable;
 #if !defined(API)
   char        commit_id [41];
+  int64_t     pid;                     // process running the simulator
   volAtomic   word36 M [MEMSIZE];
   cpu_state_t cpus [N_CPU_UNITS_MAX];
   struct cables_s cables;
+  scu_t       scus [N_SCU_UNITS_MAX];
 #endif /* if !defined(API) */
 };
 
@@ -96,4 +98,5 @@ int sim_nolock     =  0;
 int sim_randompst  =  0;
 int sim_randstate  =  0;
 int sim_nostate    =  0;
+int sim_hugepages  =  0;
 #endif /* if !defined(API) */
@@ -68,6 +68,7 @@
 #include "dps8_mgp.h"
 #include "dps8_utils.h"
 #include "dps8_memalign.h"
+#include "dps8_metrics.h"
 #include "shm.h"
 #include "ver.h"
 
@@ -3911,6 +3912,9 @@ static CTAB dps8_cmds[] =
     {"FNPSERVERADDRESS",    set_fnp_server_address,   0, "Set the FNP dialin server binding address\r\n", NULL, NULL},
     {"FNPSERVER3270PORT",   set_fnp_3270_server_port, 0, "Set the FNP TN3270 dialin port number\r\n",     NULL, NULL},
 
+    {"METRICS",             metrics_socket,           0, "Serve performance counters on a local socket\r\n", NULL, NULL},
+    {"METRICS_SHOW",        metrics_show,             0, "Show the performance counters\r\n",             NULL, NULL},
+
 //
 // System control
 //
@@ -4105,6 +4109,20 @@ static struct symbol_s symbols [] = {
     { "cpus[].DSBR.STACK",      SYM_STRUCT_OFFSET, SYM_UINT16_12, offsetof (struct dsbr_s,         STACK)       },
 
     { "cpus[].faultNumber",     SYM_STRUCT_OFFSET, SYM_UINT32,    offsetof (cpu_state_t,           faultNumber) },
+
+    { "pid",                    SYM_STATE_OFFSET,  SYM_UINT64,    offsetof (struct system_state_s, pid)         },
+
+    { "cables",                 SYM_STATE_OFFSET,  SYM_PTR,       offsetof (struct system_state_s, cables)      },
+    { "sizeof(cables)",         SYM_STRUCT_SZ,     SYM_SZ,        sizeof (struct cables_s) },
+
+    { "scus[]",                 SYM_STATE_OFFSET,  SYM_ARRAY,     offsetof (struct system_state_s, scus)        },
+    { "sizeof(*scus)",          SYM_STRUCT_SZ,     SYM_SZ,        sizeof (scu_t) },
+    { "scus[].port_enable[]",   SYM_STRUCT_OFFSET, SYM_ARRAY,     offsetof (scu_t,                 port_enable) },
+    { "scus[].exec_intr_mask[]", SYM_STRUCT_OFFSET, SYM_ARRAY,    offsetof (scu_t,                 exec_intr_mask) },
+    { "scus[].mask_enable[]",   SYM_STRUCT_OFFSET, SYM_ARRAY,     offsetof (scu_t,                 mask_enable) },
+    { "scus[].mask_assignment[]", SYM_STRUCT_OFFSET, SYM_ARRAY,   offsetof (scu_t,                 mask_assignment) },
+    { "scus[].cells",           SYM_STRUCT_OFFSET, SYM_UINT32,    offsetof (scu_t,                 cells)       },
+    { "scus[].mode_reg",        SYM_STRUCT_OFFSET, SYM_UINT32_18, offsetof (scu_t,                 mode_reg)    },
 # define SYMTAB_ENUM32(e) { #e, SYM_ENUM,          SYM_UINT32,    e }
     SYMTAB_ENUM32 (FAULT_SDF),
     SYMTAB_ENUM32 (FAULT_STR),
@@ -4447,6 +4465,9 @@ static void dps8_init (void) {
   if (!sim_nostate)
     system_state = (struct system_state_s *)
       create_shm (statenme, sizeof (struct system_state_s));
+  else if (sim_hugepages)
+    system_state = (struct system_state_s *)
+      create_huge (sizeof (struct system_state_s));
   else
 # if !defined(_AIX)
     system_state = aligned_malloc (sizeof (struct system_state_s));
@@ -4484,6 +4505,15 @@ static void dps8_init (void) {
   }
 #endif
 
+#if !defined(__MINGW64__) && !defined(__MINGW32__) && !defined(CROSS_MINGW64) && !defined(CROSS_MINGW32)
+  if (sim_hugepages && !sim_quiet) {
+    char pages[128];
+    sim_printf ("System state memory: %s\r\n",
+                describe_pages (system_state, sizeof (struct system_state_s),
+                                pages, sizeof (pages)));
+  }
+#endif
+
 #if !defined(PERF_STRIP)
 
 # if !defined(VER_H_GIT_HASH)
@@ -4508,6 +4538,7 @@ static void dps8_init (void) {
   strncpy (system_state->stateHdr, STATE_HDR, sizeof (system_state->stateHdr));
   system_state->stateVer = STATE_VER;
   strncpy (system_state->commit_id, VER_H_GIT_HASH, sizeof (system_state->commit_id));
+  system_state->pid = (int64_t) getpid ();
 
   systabInit ();
 
@@ -4570,6 +4601,12 @@ static void dps8_exit (void) {
   console_exit ();
   mt_exit ();
   fnpExit ();
+  metrics_exit ();
+#if !defined(PERF_STRIP)
+  // Tell processes attached to the state that it is no longer live
+  if (system_state)
+    system_state->pid = 0;
+#endif /* if !defined(PERF_STRIP) */
 }
 
 #if defined(TESTING)
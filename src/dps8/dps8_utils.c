@@ -1812,6 +1812,85 @@ word36 extr36 (uint8 * bits, uint woffset)
     return (word36) (w & MASK36);
   }
 
+//
+// Block converters
+//
+//   unpack72_block / pack72_block
+//     convert nWords word36s starting at woffset; the bulk of the
+//     transfer is done a word pair (72 bits, 9 bytes) at a time so
+//     that the compiler can turn each pair into a single 64 bit
+//     load/store plus one byte, instead of two read-modify-write
+//     nibble dances through extr36/put36.
+//
+
+void unpack72_block (uint8 * bits, uint woffset, word36 * words, uint nWords)
+  {
+    if (nWords == 0)
+      return;
+
+    // Leading odd word
+    if (woffset % 2)
+      {
+        * words ++ = extr36 (bits, woffset ++);
+        nWords --;
+      }
+
+    uint8 * p = bits + (woffset / 2) * 9;
+    for (uint i = 0; i < nWords / 2; i ++, p += 9)
+      {
+        uint64 w;
+        w  = ((uint64) p [0]) << 56;
+        w |= ((uint64) p [1]) << 48;
+        w |= ((uint64) p [2]) << 40;
+        w |= ((uint64) p [3]) << 32;
+        w |= ((uint64) p [4]) << 24;
+        w |= ((uint64) p [5]) << 16;
+        w |= ((uint64) p [6]) << 8;
+        w |= ((uint64) p [7]);
+        * words ++ = (word36) (w >> 28);
+        * words ++ = (word36) (((w << 8) | p [8]) & MASK36);
+      }
+
+    // Trailing even word
+    if (nWords % 2)
+      * words = extr36 (p, 0);
+  }
+
+void pack72_block (word36 * words, uint8 * bits, uint woffset, uint nWords)
+  {
+    if (nWords == 0)
+      return;
+
+    // Leading odd word
+    if (woffset % 2)
+      {
+        put36 (* words ++, bits, woffset ++);
+        nWords --;
+      }
+
+    uint8 * p = bits + (woffset / 2) * 9;
+    for (uint i = 0; i < nWords / 2; i ++, p += 9)
+      {
+        word36 even = words [0] & MASK36;
+        word36 odd  = words [1] & MASK36;
+        words += 2;
+        uint64 w = (((uint64) even) << 28) | (((uint64) odd) >> 8);
+        p [0] = (w >> 56) & 0xff;
+        p [1] = (w >> 48) & 0xff;
+        p [2] = (w >> 40) & 0xff;
+        p [3] = (w >> 32) & 0xff;
+        p [4] = (w >> 24) & 0xff;
+        p [5] = (w >> 16) & 0xff;
+        p [6] = (w >>  8) & 0xff;
+        p [7] = (w      ) & 0xff;
+        p [8] = (odd    ) & 0xff;
+      }
+
+    // Trailing even word
+    if (nWords % 2)
+      put36 (* words, p, 0);
+  }
+
 static void putASCII36 (word36 val, uint8 * bits, uint woffset)
   {
     uint8 * p = bits + woffset * 4;
@@ -1932,6 +2011,44 @@ int insertWord36toBuffer (uint8 * bufp, t_mtrlnt tbc, uint * words_processed, wo
     return 0;
   }
 
+// Block forms of extractWord36FromBuffer/insertWord36toBuffer; they
+// transfer up to n words, stopping at the same tbc limit as the single
+// word versions, and return the number of words transferred.
+
+// Number of packed words that start within the first tbc bytes
+static uint words72InBytes (t_mtrlnt tbc)
+  {
+    if (tbc == 0)
+      return 0;
+    return (uint) ((tbc * 2 - 2) / 9 + 1);
+  }
+
+uint extractWord36BlockFromBuffer (uint8 * bufp, t_mtrlnt tbc, uint * words_processed, word36 * wordp, uint n)
+  {
+    uint wp = * words_processed;
+    uint avail = words72InBytes (tbc);
+    if (wp >= avail)
+      return 0;
+    if (n > avail - wp)
+      n = avail - wp;
+    unpack72_block (bufp, wp, wordp, n);
+    (* words_processed) += n;
+    return n;
+  }
+
+uint insertWord36BlockToBuffer (uint8 * bufp, t_mtrlnt tbc, uint * words_processed, word36 * wordp, uint n)
+  {
+    uint wp = * words_processed;
+    uint avail = words72InBytes (tbc);
+    if (wp >= avail)
+      return 0;
+    if (n > avail - wp)
+      n = avail - wp;
+    pack72_block (wordp, bufp, wp, n);
+    (* words_processed) += n;
+    return n;
+  }
+
 #if !defined(NEED_128)
 static void print_uint128o_r (uint128 n, char * p)
   {
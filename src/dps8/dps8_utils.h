@@ -880,10 +880,14 @@ static inline void clrmask (word36 * v, word36 mask)
 char * strdupesc (const char * str);
 word36 extr36 (uint8 * bits, uint woffset);
 void put36 (word36 val, uint8 * bits, uint woffset);
+void unpack72_block (uint8 * bits, uint woffset, word36 * words, uint nWords);
+void pack72_block (word36 * words, uint8 * bits, uint woffset, uint nWords);
 int extractASCII36FromBuffer (uint8 * bufp, t_mtrlnt tbc, uint * words_processed, word36 *wordp);
 int extractWord36FromBuffer (uint8 * bufp, t_mtrlnt tbc, uint * words_processed, word36 *wordp);
 int insertASCII36toBuffer (uint8 * bufp, t_mtrlnt tbc, uint * words_processed, word36 word);
 int insertWord36toBuffer (uint8 * bufp, t_mtrlnt tbc, uint * words_processed, word36 word);
+uint extractWord36BlockFromBuffer (uint8 * bufp, t_mtrlnt tbc, uint * words_processed, word36 * wordp, uint n);
+uint insertWord36BlockToBuffer (uint8 * bufp, t_mtrlnt tbc, uint * words_processed, word36 * wordp, uint n);
 void print_int128 (int128 n, char * p);
 char * print_int128o (int128 n, char * p);
 word36 Add36b (cpu_state_t * cpup, word36 op1, word36 op2, word1 carryin, word18 flagsToSet, word18 * flags, bool * ovf);
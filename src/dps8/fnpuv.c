@@ -128,13 +128,28 @@
 // 'uvClientData' is inspected for telnet usage; if so, the data is passed
 // to libtelnet for telnet packaging and is sent on to
 // 'fnpuv_start_write_actual'. If telnet is not in play, the data is sent
-// directly on to 'fnpuv_start_write_actual()' There, a buffer is allocated
-// and the data copied and a 'uv_write_t' request object is created and
-// initialized data the buffer address and length, and a write request
-// is send to libuv.
-//
-// When the write is complete, libuv calls the write callback 'fuv_write_cb()',
-// which frees the data buffers and destroys the write request object.
+// directly on to 'fnpuv_start_write_actual()' There, the data is copied
+// into the connection's output ring, and if no write is already in flight,
+// a write request for the queued data is sent to libuv.
+//
+// When the write is complete, libuv calls the write callback 'fuv_out_cb()',
+// which releases the written bytes and writes whatever was queued while
+// the request was in flight.
+
+// Network thread
+//
+// By default the FNP loop is the default libuv loop, and is run once per
+// sys_poll_interval by 'fnpProcessEvent()'; input typed at a terminal waits
+// up to a full poll interval before the FNP sees it. With 'SET FNP
+// NETTHREAD=ENABLE', the FNP gets a loop of its own and a thread that
+// blocks in poll() on the loop's backend descriptor. When a descriptor
+// becomes ready, the thread takes the same locks as the CPU event-poll
+// path and runs 'fnpProcessNetEvent()', which delivers input and posts
+// requests to Multics without advancing the FNP delay counters. The timer
+// path still runs the loop and owns the counters, so all FNP state stays
+// serialized by the libuv lock. The thread is started once a listener has
+// been set up on the loop, and 'fnpExit()' stops and joins it before the
+// line data is freed.
 
 // Dialout logic
 //
@@ -184,10 +199,13 @@
 #include <unistd.h>
 #include <ctype.h>
 #include <signal.h>
+#include <errno.h>
+#if !defined(__MINGW32__) && !defined(__MINGW64__) && !defined(CROSS_MINGW32) && !defined(CROSS_MINGW64)
+# include <poll.h>
+#endif /* if !defined(__MINGW32__) && !defined(__MINGW64__) && !defined(CROSS_MINGW32) && !defined(CROSS_MINGW64) */
 #if defined(TUN)
 # include <string.h>
 # include <fcntl.h>
-# include <errno.h>
 # include <sys/ioctl.h>
 # include <sys/types.h>
 # include <sys/stat.h>
@@ -207,6 +225,9 @@
 #include "dps8_utils.h"
 #include "fnpuv.h"
 #include "fnptelnet.h"
+#if defined(THREADZ) || defined(LOCKLESS)
+# include "threadz.h"
+#endif /* if defined(THREADZ) || defined(LOCKLESS) */
 
 #if defined(NO_LOCALE)
 # define xstrerror_l strerror
@@ -290,6 +311,7 @@ void fnpuv_associated_brk (uv_tcp_t * client)
     // the line_break before the accept input?
     linep->accept_input = 1;
     linep->line_break=true;
+    fnpLineReady (linep);
   }
 
 // read callback for connections that are associated with an HSLA line;
@@ -320,6 +342,8 @@ void fnpuv_unassociated_readcb (uv_tcp_t * client,
     processUserInput (client, buf, nread);
   }
 
+static void fnpuvOutRelease (uvClientData * p);
+
 static void fuv_close_cb (uv_handle_t * stream)
   {
     FREE (stream);
@@ -360,6 +384,7 @@ void close_connection (uv_stream_t* stream)
                 linep -> line_disconnected = true;
 #endif /* if defined(DISC_DELAY) */
                 linep -> listen = false;
+                fnpLineReady (linep);
                 if (linep->inBuffer)
                   FREE (linep->inBuffer);
                 linep->inBuffer = NULL;
@@ -388,6 +413,7 @@ void close_connection (uv_stream_t* stream)
           }
         if (((uvClientData *) stream->data)->ttype)
           FREE (((uvClientData *) stream->data)->ttype);
+        fnpuvOutRelease (p);
         FREE (stream->data);
         stream->data = NULL;
       } // if (p)
@@ -572,42 +598,208 @@ static void fnpuv_start_write_3270_actual (UNUSED uv_tcp_t * client, unsigned ch
 #endif /* if !defined(__clang_analyzer__) */
   }
 
-void fnpuv_start_write_actual (uv_tcp_t * client, unsigned char * data, ssize_t datalen)
+// Output ring
+//
+// Each connection queues its output in a ring buffer. If no write is in
+// flight the data is written at once; otherwise it accumulates until the
+// in-flight write completes, and everything queued meanwhile goes out in
+// a single uv_write of (at most) two iovecs. This coalesces the fragments
+// produced by libtelnet escaping and by successive mailbox output blocks
+// without adding latency to the first one.
+
+#define OUT_RING_MIN 4096
+
+struct fnpuvOut_s
   {
-    if (! client || uv_is_closing ((uv_handle_t *) client))
+    unsigned char * ring;
+    size_t size;     // power of two
+    size_t head;     // bytes queued, monotonic
+    size_t tail;     // bytes completed, monotonic
+    size_t sent;     // bytes in the in-flight write
+    bool busy;       // 'req' is in flight
+    bool orphaned;   // connection closed while busy; free on completion
+    unsigned char * reqRing; // ring the in-flight write points into
+    uv_write_t req;
+  };
+
+static void fnpuvOutFree (struct fnpuvOut_s * out)
+  {
+    if (out->reqRing && out->reqRing != out->ring)
+      FREE (out->reqRing);
+    FREE (out->ring);
+    FREE (out);
+  }
+
+// Called when the connection's client data is torn down
+
+static void fnpuvOutRelease (uvClientData * p)
+  {
+    struct fnpuvOut_s * out = p->out;
+    p->out = NULL;
+    if (! out)
       return;
-/* Suppress Clang Analyzer's possible memory leak warning */
-#if !defined(__clang_analyzer__)
-    uv_write_t * req = (uv_write_t *) malloc (sizeof (uv_write_t));
-    if (!req)
+    if (out->busy)
+      out->orphaned = true;
+    else
+      fnpuvOutFree (out);
+  }
+
+static void fnpuvOutFlush (uv_tcp_t * client, struct fnpuvOut_s * out);
+
+static void fuv_out_cb (uv_write_t * req, int status)
+  {
+    struct fnpuvOut_s * out = (struct fnpuvOut_s *) req->data;
+    out->busy = false;
+    if (out->orphaned)
+      {
+        fnpuvOutFree (out);
+        return;
+      }
+    if (out->reqRing != out->ring)
+      FREE (out->reqRing);
+    out->reqRing = NULL;
+
+    // The in-flight bytes still count as queued until they are retired
+    uv_tcp_t * client = (uv_tcp_t *) req->handle;
+    bool wasBacklogged = fnpuv_output_backlogged (client);
+    out->tail += out->sent;
+    out->sent  = 0;
+
+    if (status < 0)
+      {
+        if (status != -ECONNRESET && status != -ECANCELED &&
+            status != -EPIPE)
+          sim_warn ("fuv_out_cb status %d (%s)\r\n", -status, xstrerror_l(-status));
+        out->tail = out->head;
+        // connection reset by peer
+        close_connection (req->handle);
+        return;
+      }
+
+    fnpuvOutFlush (client, out);
+
+    // A send_output held back by fnpuv_output_backlogged can go now
+    uvClientData * p = (uvClientData *) client->data;
+    if (wasBacklogged && ! fnpuv_output_backlogged (client) && p && p->assoc)
+      fnpLineReady (& fnpData.fnpUnitData[p->fnpno].MState.line[p->lineno]);
+  }
+
+static void fnpuvOutFlush (uv_tcp_t * client, struct fnpuvOut_s * out)
+  {
+    size_t pending = out->head - out->tail;
+    if (out->busy || pending == 0)
+      return;
+    size_t start = out->tail & (out->size - 1);
+    size_t first = out->size - start;
+    if (first > pending)
+      first = pending;
+    uv_buf_t bufs [2];
+    uint nbufs = 1;
+    bufs[0] = uv_buf_init ((char *) out->ring + start, (uint) first);
+    if (pending > first)
+      bufs[nbufs ++] = uv_buf_init ((char *) out->ring, (uint) (pending - first));
+    out->sent     = pending;
+    out->busy     = true;
+    out->reqRing  = out->ring;
+    out->req.data = out;
+    int ret = uv_write (& out->req, (uv_stream_t *) client, bufs, nbufs, fuv_out_cb);
+// There seems to be a race condition when Multics signals a disconnect_line;
+// We close the socket, but Multics is still writing its goodbye text trailing
+// NULs.
+// If the socket has been closed, write will return BADF; just ignore it.
+    if (ret < 0)
+      {
+        out->busy    = false;
+        out->reqRing = NULL;
+        out->sent    = 0;
+        out->tail    = out->head;
+        if (ret != -EBADF)
+          sim_printf ("\r[FNP emulation: uv_write returned %d]\r\n", ret);
+      }
+  }
+
+static void fnpuvOutGrow (struct fnpuvOut_s * out, size_t need)
+  {
+    size_t size = out->size ? out->size : OUT_RING_MIN;
+    while (size < need)
+      size <<= 1;
+    if (size == out->size)
+      return;
+    unsigned char * ring = (unsigned char *) malloc (size);
+    if (! ring)
       {
         (void)fprintf (stderr, "\rFATAL: Out of memory! Aborting at %s[%s:%d]\r\n",
                        __func__, __FILE__, __LINE__);
-# if defined(USE_BACKTRACE)
-#  if defined(SIGUSR2)
+#if defined(USE_BACKTRACE)
+# if defined(SIGUSR2)
         (void)raise(SIGUSR2);
         /*NOTREACHED*/ /* unreachable */
-#  endif /* if defined(SIGUSR2) */
-# endif /* if defined(USE_BACKTRACE) */
+# endif /* if defined(SIGUSR2) */
+#endif /* if defined(USE_BACKTRACE) */
         abort();
       }
-    // This makes sure that bufs*.base and bufsml*.base are NULL
-    (void)memset (req, 0, sizeof (uv_write_t));
-    uv_buf_t buf = uv_buf_init ((char *) malloc ((unsigned long) datalen), (uint) datalen);
-//sim_printf ("allocated req %p data %p\r\n", req, buf.base);
-# if defined(USE_REQ_DATA)
-    req->data = buf.base;
-# endif
-//sim_printf ("fnpuv_start_write_actual req %p buf.base %p\r\n", req, buf.base);
-    memcpy (buf.base, data, (unsigned long) datalen);
-    int ret = uv_write (req, (uv_stream_t *) client, & buf, 1, fuv_write_cb);
-// There seems to be a race condition when Multics signals a disconnect_line;
-// We close the socket, but Multics is still writing its goodbye text trailing
-// NULs.
-// If the socket has been closed, write will return BADF; just ignore it.
-    if (ret < 0 && ret != -EBADF)
-      sim_printf ("\r[FNP emulation: uv_write returned %d]\r\n", ret);
-#endif /* if !defined(__clang_analyzer__) */
+    // Linearize the queued bytes (including any in flight) at the start
+    // of the new ring; an in-flight write keeps using the old one.
+    size_t pending = out->head - out->tail;
+    for (size_t i = 0; i < pending; i ++)
+      ring[i] = out->ring[(out->tail + i) & (out->size - 1)];
+    if (out->ring && out->ring != out->reqRing)
+      FREE (out->ring);
+    out->ring = ring;
+    out->size = size;
+    out->tail = 0;
+    out->head = pending;
+  }
+
+void fnpuv_start_write_actual (uv_tcp_t * client, unsigned char * data, ssize_t datalen)
+  {
+    if (! client || uv_is_closing ((uv_handle_t *) client) || datalen <= 0)
+      return;
+    uvClientData * p = (uvClientData *) client->data;
+    if (! p)
+      return;
+    struct fnpuvOut_s * out = p->out;
+    if (! out)
+      {
+        out = (struct fnpuvOut_s *) calloc (1, sizeof (struct fnpuvOut_s));
+        if (! out)
+          {
+            (void)fprintf (stderr, "\rFATAL: Out of memory! Aborting at %s[%s:%d]\r\n",
+                           __func__, __FILE__, __LINE__);
+#if defined(USE_BACKTRACE)
+# if defined(SIGUSR2)
+            (void)raise(SIGUSR2);
+            /*NOTREACHED*/ /* unreachable */
+# endif /* if defined(SIGUSR2) */
+#endif /* if defined(USE_BACKTRACE) */
+            abort();
+          }
+        p->out = out;
+      }
+    size_t len  = (size_t) datalen;
+    size_t need = out->head - out->tail + len;
+    if (need > out->size)
+      fnpuvOutGrow (out, need);
+    size_t start = out->head & (out->size - 1);
+    size_t first = out->size - start;
+    if (first > len)
+      first = len;
+    memcpy (out->ring + start, data, first);
+    if (len > first)
+      memcpy (out->ring, data + first, len - first);
+    out->head += len;
+    fnpuvOutFlush (client, out);
+  }
+
+// True if more than the FNP output high-water mark is queued on the
+// connection; the FNP then holds back 'send_output' until it drains.
+
+bool fnpuv_output_backlogged (uv_tcp_t * client)
+  {
+    if (! client || ! client->data || ! fnpData.outputHWM)
+      return false;
+    struct fnpuvOut_s * out = ((uvClientData *) client->data)->out;
+    return out && out->head - out->tail > fnpData.outputHWM;
   }
 
 //
@@ -822,6 +1014,7 @@ sim_printf ("\r[FNP emulation: dropping 2nd slave]\r\n");
     p->assoc           = false;
     p->nPos            = 0;
     p->ttype           = NULL;
+    p->out             = NULL;
     p->write_actual_cb = fnpuv_start_write_actual;
     // dialup connections are routed through libtelent
     if (! server->data)
@@ -857,6 +1050,7 @@ sim_printf ("\r[FNP emulation: dropping 2nd slave]\r\n");
           linep->lineType = 1; /* LINE_ASCII */
         linep->accept_new_terminal = true;
         reset_line (linep);
+        fnpLineReady (linep);
       }
   }
 
@@ -864,6 +1058,105 @@ sim_printf ("\r[FNP emulation: dropping 2nd slave]\r\n");
 // Setup the dialup listener
 //
 
+#if defined(FNP_NET_THREAD)
+// Upper bound on a poll() wait; bounds the latency of loop changes made
+// by the CPU thread that libuv does not signal on the backend descriptor.
+# define NET_POLL_MAX_MS 10
+
+static uv_loop_t fnpNetLoop;
+static pthread_t fnpNetThread;
+static bool fnpNetStarted;
+static volAtomic bool fnpNetStop; // Set by fnpuvExit; seen within NET_POLL_MAX_MS
+
+static void * fnpNetThreadMain (UNUSED void * arg)
+  {
+    _cpup = & cpus[0];
+    struct pollfd pfd;
+    pfd.fd     = uv_backend_fd (fnpData.loop);
+    pfd.events = POLLIN;
+    int timeout = 0;
+    while (! fnpNetStop)
+      {
+        if (timeout < 0 || timeout > NET_POLL_MAX_MS)
+          timeout = NET_POLL_MAX_MS;
+        if (poll (& pfd, 1, timeout) < 0 && errno != EINTR)
+          {
+            sim_warn ("\r[FNP emulation: network thread poll: %s]\r\n",
+                      xstrerror_l (errno));
+            return NULL;
+          }
+# if defined(LOCKLESS)
+        lock_iom ();
+# endif /* if defined(LOCKLESS) */
+        lock_libuv ();
+        fnpProcessNetEvent ();
+        timeout = uv_backend_timeout (fnpData.loop);
+        unlock_libuv ();
+# if defined(LOCKLESS)
+        unlock_iom ();
+# endif /* if defined(LOCKLESS) */
+      }
+    return NULL;
+  }
+
+// Start the network thread once a listener exists on its loop. Until
+// then, and if the thread cannot be started, the timer path runs the loop.
+
+static void fnpNetThreadStart (void)
+  {
+    if (! fnpData.netThread || fnpNetStarted || fnpData.loop != & fnpNetLoop)
+      return;
+    fnpNetStop = false;
+    int rc = pthread_create (& fnpNetThread, NULL, fnpNetThreadMain, NULL);
+    if (rc != 0)
+      {
+        sim_warn ("\r[FNP emulation: network thread: %s]\r\n",
+                  xstrerror_l (rc));
+        return;
+      }
+    fnpNetStarted = true;
+    sim_printf ("\r[FNP emulation: network thread started]\r\n");
+  }
+#endif /* if defined(FNP_NET_THREAD) */
+
+// Stop the network thread; called at exit before the FNP handles and
+// line data are freed.
+
+void fnpuvExit (void)
+  {
+#if defined(FNP_NET_THREAD)
+    if (! fnpNetStarted)
+      return;
+    fnpNetStop = true;
+    (void) pthread_join (fnpNetThread, NULL);
+    fnpNetStarted = false;
+#endif /* if defined(FNP_NET_THREAD) */
+  }
+
+// Pick the loop the FNP handles live on; called before the first handle
+// is created.
+
+static void fnpuvLoopInit (void)
+  {
+    if (fnpData.loop)
+      return;
+#if defined(FNP_NET_THREAD)
+    if (fnpData.netThread)
+      {
+        int rc = uv_loop_init (& fnpNetLoop);
+        if (rc == 0 && uv_backend_fd (& fnpNetLoop) >= 0)
+          {
+            fnpData.loop = & fnpNetLoop;
+            return;
+          }
+        if (rc == 0)
+          (void) uv_loop_close (& fnpNetLoop);
+        fnpData.netThread = false;
+      }
+#endif /* if defined(FNP_NET_THREAD) */
+    fnpData.loop = uv_default_loop ();
+  }
+
 int fnpuvInit (int telnet_port, char * telnet_address)
   {
     // Ignore multiple calls; this means that once the listen port is
@@ -875,11 +1168,13 @@ int fnpuvInit (int telnet_port, char * telnet_address)
         return 1;
       }
 
-    if (! fnpData.loop)
-      fnpData.loop = uv_default_loop ();
+#if defined(FNP_NET_THREAD)
+    // The network thread may already be running the loop (3270 listener)
+    lock_libuv ();
+#endif /* if defined(FNP_NET_THREAD) */
+    fnpuvLoopInit ();
 
     // Initialize the server socket
-    fnpData.loop = uv_default_loop ();
     uv_tcp_init (fnpData.loop, & fnpData.du_server);
 
 // XXX to do clean shutdown
@@ -894,6 +1189,9 @@ int fnpuvInit (int telnet_port, char * telnet_address)
     uv_tcp_bind (& fnpData.du_server, (const struct sockaddr *) & addr, 0);
     int r = uv_listen ((uv_stream_t *) & fnpData.du_server, DEFAULT_BACKLOG,
                        on_new_connection);
+#if defined(FNP_NET_THREAD)
+    unlock_libuv ();
+#endif /* if defined(FNP_NET_THREAD) */
     if (r)
      {
         sim_printf ("\r[FNP emulation: listen error: %s:%ld: %s]\r\n", telnet_address, (long) telnet_port, uv_strerror(r));
@@ -901,6 +1199,9 @@ int fnpuvInit (int telnet_port, char * telnet_address)
      }
     fnpData.du_server_inited = true;
     sim_printf ("\r[FNP emulation: TELNET server listening on %s:%ld]\r\n", telnet_address, (long) telnet_port);
+#if defined(FNP_NET_THREAD)
+    fnpNetThreadStart ();
+#endif /* if defined(FNP_NET_THREAD) */
     return 0;
   }
 
@@ -942,6 +1243,7 @@ static void on_dialout_connect (uv_connect_t * server, int status)
         //sim_printf ("%p\r\n", p);
         //sim_printf ("%d.%d\r\n", p->fnpno, p->lineno);
         linep->acu_dial_failure = true;
+        fnpLineReady (linep);
         return;
       }
 
@@ -950,6 +1252,7 @@ static void on_dialout_connect (uv_connect_t * server, int status)
     if (linep->lineType == 0) /* LINE_NONE */
       linep->lineType = 1; /* LINE_ASCII */
     linep->accept_new_terminal = true;
+    fnpLineReady (linep);
     linep->was_CR              = false;
     linep->line_client->data   = p;
     if (p->telnetp)
@@ -1053,6 +1356,7 @@ void fnpuv_dial_out (uint fnpno, uint lineno, word36 d1, word36 d2, word36 d3)
       {
         sim_printf ("Dialout %c.d%03d denied\r\n", fnpno + 'a', lineno);
         linep->acu_dial_failure = true;
+        fnpLineReady (linep);
         return;
       }
 
@@ -1095,6 +1399,7 @@ void fnpuv_dial_out (uint fnpno, uint lineno, word36 d1, word36 d2, word36 d3)
     p->read_cb               = fnpuv_associated_readcb;
     p->nPos                  = 0;
     p->ttype                 = NULL;
+    p->out                   = NULL;
     p->fnpno                 = fnpno;
     p->lineno                = lineno;
     linep->line_client->data = p;
@@ -1134,6 +1439,7 @@ static void on_slave_connect (uv_stream_t * server, int status)
 
     uv_read_start ((uv_stream_t *) & linep->line_client, alloc_buffer, do_readcb);
     linep->accept_new_terminal = true;
+    fnpLineReady (linep);
   }
 #endif
 
@@ -1178,6 +1484,7 @@ void fnpuv_open_slave (uint fnpno, uint lineno)
     p->write_actual_cb = fnpuv_start_write_actual;
     p->nPos            = 0;
     p->ttype           = NULL;
+    p->out             = NULL;
     p->fnpno           = fnpno;
     p->lineno          = lineno;
     linep->server.data = p;
@@ -1250,7 +1557,7 @@ static void processPacketInput (int fnpno, int lineno, unsigned char * buf, ssiz
         linep->inSize = (uint) nread;
         linep->inUsed = 0;
       }
-
+    fnpLineReady (linep);
   }
 
 static void fnoTUNProcessLine (int fnpno, int lineno, struct t_line * linep)
@@ -1456,6 +1763,7 @@ static void on_new_3270_connection (uv_stream_t * server, int status)
     p->lineno          = lineno;
     p->nPos            = 0;
     p->ttype           = NULL;
+    p->out             = NULL;
     p->read_cb         = fnpuv_3270_readcb;
     p->write_cb        = fnpuv_start_3270_write;
     p->write_actual_cb = fnpuv_start_write_3270_actual;
@@ -1517,8 +1825,11 @@ int fnpuv3270Init (int telnet3270_port)
         sim_printf ("\r[FNP emulation: FNP already initialized]\r\n");
         return 1;
       }
-    if (! fnpData.loop)
-      fnpData.loop = uv_default_loop ();
+#if defined(FNP_NET_THREAD)
+    // The network thread may already be running the loop
+    lock_libuv ();
+#endif /* if defined(FNP_NET_THREAD) */
+    fnpuvLoopInit ();
     // Initialize the server socket
     uv_tcp_init (fnpData.loop, & fnpData.du3270_server);
 
@@ -1531,6 +1842,9 @@ int fnpuv3270Init (int telnet3270_port)
     uv_tcp_bind (& fnpData.du3270_server, (const struct sockaddr *) & addr, 0);
     int r = uv_listen ((uv_stream_t *) & fnpData.du3270_server, DEFAULT_BACKLOG,
                    on_new_3270_connection);
+#if defined(FNP_NET_THREAD)
+    unlock_libuv ();
+#endif /* if defined(FNP_NET_THREAD) */
     if (r)
      {
         sim_printf ("\r[FNP emulation: listen error: %s:%ld: %s]\r\n",
@@ -1541,5 +1855,8 @@ int fnpuv3270Init (int telnet3270_port)
     sim_printf ("\r[FNP emulation: TN3270 server listening on %s:%ld]\r\n",
                 fnpData.telnet_address, (long) telnet3270_port);
     fnpuv3270Poll (false);
+#if defined(FNP_NET_THREAD)
+    fnpNetThreadStart ();
+#endif /* if defined(FNP_NET_THREAD) */
     return 0;
   }
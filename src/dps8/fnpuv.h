@@ -31,11 +31,14 @@ struct uvClientData_s
     // 3270
     char * ttype;
     uint stationNo;
+    // Output ring; see fnpuv_start_write_actual
+    struct fnpuvOut_s * out;
   };
 
 typedef struct uvClientData_s uvClientData;
 
 int fnpuvInit (int telnet_port, char * telnet_address);
+void fnpuvExit (void);
 int fnpuv3270Init (int telnet3270_port);
 void fnpuv3270Poll (bool start);
 void fnpuvProcessEvent (void);
@@ -44,6 +47,7 @@ void fnpuv_start_writestr (uv_tcp_t * client, unsigned char * data);
 void fnpuv_send_eor (uv_tcp_t * client);
 void fnpuv_recv_eor (uv_tcp_t * client);
 void fnpuv_start_write_actual (uv_tcp_t * client, unsigned char * data, ssize_t datalen);
+bool fnpuv_output_backlogged (uv_tcp_t * client);
 void fnpuv_associated_brk (uv_tcp_t * client);
 void fnpuv_unassociated_readcb (uv_tcp_t * client, ssize_t nread, unsigned char * buf);
 void fnpuv_associated_readcb (uv_tcp_t * client, ssize_t nread, unsigned char * buf);
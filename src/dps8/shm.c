@@ -22,6 +22,7 @@
 #include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
 #include <sys/file.h>
 #include <sys/mman.h>
@@ -57,11 +58,139 @@ extern int sim_randompst;
 extern int sim_nostate;
 extern int sim_iglock;
 extern int sim_nolock;
+extern int sim_hugepages;
 
 #if !defined(NO_LOCALE)
 const char *xstrerror_l(int errnum);
 #endif
 
+#if defined(MADV_HUGEPAGE)
+/* PMD size on the hosts that have transparent huge pages */
+# define HUGE_PAGE_ALIGN ((size_t)2 * 1024 * 1024)
+
+/* Map an anonymous region of len bytes (a multiple of the page size)  */
+/* aligned to align bytes, so that it can be backed by huge pages.     */
+
+static void *
+map_aligned(size_t len, size_t align, int prot)
+{
+  size_t rlen = len + align;
+  char *r = mmap(NULL, rlen, prot, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (r == MAP_FAILED)
+    {
+      return NULL;
+    }
+  char *a = (char *)(((uintptr_t)r + align - 1) & ~((uintptr_t)align - 1));
+  if (a > r)
+    {
+      (void)munmap(r, (size_t)(a - r));
+    }
+  if (r + rlen > a + len)
+    {
+      (void)munmap(a + len, (size_t)((r + rlen) - (a + len)));
+    }
+  return a;
+}
+#endif /* if defined(MADV_HUGEPAGE) */
+
+static size_t
+round_up(size_t size, size_t align)
+{
+  return (size + align - 1) / align * align;
+}
+
+/* Allocate anonymous memory for the system state, backed by explicit */
+/* huge pages if any are reserved, else advised for transparent huge  */
+/* pages, else by ordinary pages.                                     */
+
+void *
+create_huge(size_t shm_size)
+{
+  void *p;
+  long pgsz = sysconf(_SC_PAGESIZE);
+  size_t len = round_up(shm_size, pgsz > 0 ? (size_t)pgsz : 4096);
+
+#if defined(MADV_HUGEPAGE)
+  len = round_up(shm_size, HUGE_PAGE_ALIGN);
+# if defined(MAP_HUGETLB)
+  p = mmap(NULL, len, PROT_READ | PROT_WRITE,
+           MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  if (p != MAP_FAILED)
+    {
+      return p;
+    }
+# endif /* if defined(MAP_HUGETLB) */
+  p = map_aligned(len, HUGE_PAGE_ALIGN, PROT_READ | PROT_WRITE);
+  if (p)
+    {
+      (void)madvise(p, len, MADV_HUGEPAGE);
+      return p;
+    }
+#endif /* if defined(MADV_HUGEPAGE) */
+
+  p = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (p == MAP_FAILED)
+    {
+      return NULL;
+    }
+  return p;
+}
+
+/* Describe the pages backing [p, p + size) as seen by the kernel. */
+
+char *
+describe_pages(void *p, size_t size, char *buf, size_t buflen)
+{
+  (void)snprintf(buf, buflen, "base pages");
+#if defined(__linux__)
+  FILE *fp = fopen("/proc/self/smaps", "r");
+  if (!fp)
+    {
+      return buf;
+    }
+
+  uintptr_t lo = (uintptr_t)p, hi = lo + size;
+  unsigned long huge_kb = 0, kernel_kb = 0;
+  int in_range = 0;
+  char line[512];
+  while (fgets(line, sizeof(line), fp))
+    {
+      unsigned long start, end, kb;
+      if (sscanf(line, "%lx-%lx ", &start, &end) == 2)
+        {
+          in_range = start < hi && end > lo;
+          continue;
+        }
+      if (!in_range)
+        {
+          continue;
+        }
+      if (sscanf(line, "AnonHugePages: %lu kB", &kb) == 1 ||
+          sscanf(line, "ShmemPmdMapped: %lu kB", &kb) == 1 ||
+          sscanf(line, "FilePmdMapped: %lu kB", &kb) == 1)
+        {
+          huge_kb += kb;
+        }
+      else if (sscanf(line, "KernelPageSize: %lu kB", &kb) == 1 && kb > kernel_kb)
+        {
+          kernel_kb = kb;
+        }
+    }
+  (void)fclose(fp);
+
+  if (kernel_kb > 4)
+    {
+      (void)snprintf(buf, buflen, "explicit huge pages (%lu kB)", kernel_kb);
+    }
+  else if (huge_kb)
+    {
+      (void)snprintf(buf, buflen, "transparent huge pages (%lu of %lu MiB)",
+                     huge_kb / 1024, (unsigned long)(size >> 20));
+    }
+#endif /* if defined(__linux__) */
+  return buf;
+}
+
 void *
 create_shm(char *key, size_t shm_size)
 {
@@ -290,12 +419,34 @@ create_shm(char *key, size_t shm_size)
       return NULL;
     }
 
-  p = mmap(NULL, shm_size, PROT_READ | PROT_WRITE,
+  void *addr = NULL;
+  int fixed = 0;
+  int populate =
 #if defined(MAP_POPULATE)
-          MAP_POPULATE |
+                 MAP_POPULATE;
 #elif defined(MAP_PREFAULT_READ)
-          MAP_PREFAULT_READ |
+                 MAP_PREFAULT_READ;
+#else
+                 0;
 #endif
+#if defined(MADV_HUGEPAGE)
+  /* A PMD-aligned mapping lets a state file on a huge page capable */
+  /* file system (e.g. tmpfs with huge=advise) use huge pages.      */
+  if (sim_hugepages)
+    {
+      long pgsz = sysconf(_SC_PAGESIZE);
+      addr = map_aligned(round_up(shm_size, pgsz > 0 ? (size_t)pgsz : 4096),
+                         HUGE_PAGE_ALIGN, PROT_NONE);
+      if (addr)
+        {
+          fixed = MAP_FIXED;
+        }
+      /* Fault pages in only after the madvise below */
+      populate = 0;
+    }
+#endif /* if defined(MADV_HUGEPAGE) */
+
+  p = mmap(addr, shm_size, PROT_READ | PROT_WRITE, fixed | populate |
 #if defined(MAP_NOSYNC)
            MAP_NOSYNC |
 #endif
@@ -307,134 +458,59 @@ create_shm(char *key, size_t shm_size)
       return NULL;
     }
 
+#if defined(MADV_HUGEPAGE)
+  if (sim_hugepages)
+    {
+      (void)madvise(p, shm_size, MADV_HUGEPAGE);
+    }
+#endif /* if defined(MADV_HUGEPAGE) */
+
   return p;
 }
 
 #if defined(API)
+/* Attach to the system state of a running simulator ("dps8m.<key>"),  */
+/* read-only unless writable is set. The simulator holds the exclusive */
+/* lock on the state file, so none is taken here. A shm_size of 0 maps */
+/* the whole file.                                                     */
+
 void *
-open_shm(char *key, size_t shm_size)
+open_shm(char *key, size_t shm_size, int writable)
 {
   void *p;
   char buf[256];
 
-# if defined(USE_BFLOCK)
-  char lck[260];
-# endif /* if defined(USE_BFLOCK) */
-
-  (void)sprintf (buf, "dps8m.%s", key);
-
-# if defined(USE_BFLOCK)
-  (void)sprintf (lck, ".%s", buf);
+  (void)snprintf (buf, sizeof(buf), "dps8m.%s", key);
 
-  int lck_fd = open(lck, O_RDWR, 0);
-  if (lck_fd == -1)
-    {
-      (void)fprintf(stderr, "%s(): Failed to open \"%s\": %s (Error %d)\r\n",
-                    __func__, lck, xstrerror_l(errno), errno);
-      return NULL;
-    }
-# endif /* if defined(USE_BFLOCK) */
-
-  int fd = open(buf, O_RDWR, 0);
+  int fd = open(buf, writable ? O_RDWR : O_RDONLY, 0);
   if (fd == -1)
     {
-      (void)fprintf(stderr, "%s(); Failed to open \"%s\": %s (Error %d)\r\n",
+      (void)fprintf(stderr, "%s(): Failed to open \"%s\": %s (Error %d)\r\n",
                     __func__, buf, xstrerror_l(errno), errno);
       return NULL;
     }
 
-# if defined(USE_BFLOCK)
-  struct flock bflock;
-  (void)memset(&bflock, 0, sizeof ( bflock ));
-  bflock.l_type = F_WRLCK;
-  int brc = 0;
-  if (!sim_nolock)
-    {
-      brc = fcntl(lck_fd, F_SETLK, &bflock);
-    }
-
-  if (brc < 0)
-    {
-      (void)fprintf(stderr, "%s(): Failed to lock \"%s\": %s (Error %d)\r\n",
-                    __func__, lck, xstrerror_l(errno), errno);
-      if (!sim_iglock)
-        {
-          return NULL;
-        }
-    }
-# endif /* if defined(USE_BFLOCK) */
-
-# if defined(USE_FLOCK)
-  int rc = 0;
-  if (!sim_nolock)
-    {
-      rc = flock(fd, LOCK_EX | LOCK_NB);
-    }
-
-  if (rc < 0)
+  if (shm_size == 0)
     {
-      (void)fprintf(stderr, "%s(): Failed to lock \"%s\": %s (Error %d)\r\n",
-                    __func__, buf, xstrerror_l(errno), errno);
-      if(!sim_iglock) return NULL;
-    }
-
-# elif defined(USE_FCNTL)
-  struct flock lock;
-  (void)memset(&lock, 0, sizeof ( lock ));
-  lock.l_type = F_WRLCK;
-  int rc = 0;
-  if (!sim_nolock)
-    {
-      rc = fcntl(fd, F_SETLK, &lock);
-    }
-
-  if (rc < 0)
-    {
-      (void)fprintf(stderr, "%s(): Failed to lock \"%s\": %s (Error %d)\r\n",
-                    __func__, buf, xstrerror_l(errno), errno);
-      if (!sim_iglock)
+      struct stat sb;
+      if (fstat(fd, &sb) == -1)
         {
+          (void)fprintf(stderr, "%s(): Failed to stat \"%s\": %s (Error %d)\r\n",
+                        __func__, buf, xstrerror_l(errno), errno);
+          (void)close(fd);
           return NULL;
         }
+      shm_size = (size_t)sb.st_size;
     }
-# endif
 
-  p = mmap(NULL, size, PROT_READ | PROT_WRITE,
-# if defined(MAP_POPULATE)
-          MAP_POPULATE |
-# elif defined(MAP_PREFAULT_READ)
-          MAP_PREFAULT_READ |
-# endif
+  p = mmap(NULL, shm_size, writable ? PROT_READ | PROT_WRITE : PROT_READ,
 # if defined(MAP_NOSYNC)
            MAP_NOSYNC |
 # endif
            MAP_SHARED, fd, 0);
+  (void)close(fd);
   if (p == MAP_FAILED)
     {
-# if defined(USE_FCNTL)
-      lock.l_type = F_UNLCK;
-      if (!sim_nolock)
-        {
-          (void)fcntl(fd, F_SETLK, &lock);
-        }
-
-      if ( !(sim_nostate) )
-        (void)fsync(fd);
-      (void)close(fd);
-# endif /* if defined(USE_FCNTL) */
-
-# if defined(USE_BFLOCK)
-      bflock.l_type = F_UNLCK;
-      if (!sim_nolock)
-        {
-          (void)fcntl(lck_fd, F_SETLK, &bflock);
-        }
-
-      if ( !(sim_nostate) )
-        (void)fsync(lck_fd);
-      (void)close(lck_fd);
-# endif /* if defined(USE_BFLOCK) */
-
       (void)fprintf(stderr, "%s(): Failed to memory map \"%s\": %s (Error %d)\r\n",
                     __func__, buf, xstrerror_l(errno), errno);
       return NULL;
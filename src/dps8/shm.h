@@ -15,4 +15,6 @@
  */
 
 void *create_shm(char *key, size_t size);
-void *open_shm(char *key, size_t size);
+void *create_huge(size_t size);
+char *describe_pages(void *p, size_t size, char *buf, size_t buflen);
+void *open_shm(char *key, size_t size, int writable);
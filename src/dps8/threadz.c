@@ -401,6 +401,66 @@ int pthread_create_with_cpu_policy(
 }
 #endif /* if defined(__APPLE__) */
 
+#if defined(AFFINITY)
+// Pin a thread to a single host CPU; a negative hostCPU restores the
+// placement threads are created with (that of the main thread).
+// Returns 0 or an errno value.
+
+int setThreadAffinity (pthread_t thread, int hostCPU)
+  {
+    cpu_set_t cpuset;
+    CPU_ZERO (& cpuset);
+    if (hostCPU < 0)
+      {
+        int rc = pthread_getaffinity_np (main_thread_id, sizeof (cpu_set_t), & cpuset);
+        if (rc)
+          return rc;
+      }
+    else
+      {
+        if (hostCPU >= CPU_SETSIZE)
+          return EINVAL;
+        CPU_SET (hostCPU, & cpuset);
+      }
+    return pthread_setaffinity_np (thread, sizeof (cpu_set_t), & cpuset);
+  }
+
+// Describe the host CPUs a thread may run on as a list of ranges,
+// e.g. "3" or "0-7,16-23".
+
+char * getThreadAffinity (pthread_t thread, char * buf, size_t len)
+  {
+    cpu_set_t cpuset;
+    if (len == 0)
+      return buf;
+    buf[0] = 0;
+    if (pthread_getaffinity_np (thread, sizeof (cpu_set_t), & cpuset))
+      {
+        (void)snprintf (buf, len, "unknown");
+        return buf;
+      }
+    size_t used = 0;
+    for (int i = 0; i < CPU_SETSIZE && used < len; i ++)
+      {
+        if (! CPU_ISSET (i, & cpuset))
+          continue;
+        int j = i;
+        while (j + 1 < CPU_SETSIZE && CPU_ISSET (j + 1, & cpuset))
+          j ++;
+        int n;
+        if (j == i)
+          n = snprintf (buf + used, len - used, "%s%d", used ? "," : "", i);
+        else
+          n = snprintf (buf + used, len - used, "%s%d-%d", used ? "," : "", i, j);
+        if (n < 0)
+          break;
+        used += (size_t) n;
+        i = j;
+      }
+    return buf;
+  }
+#endif /* if defined(AFFINITY) */
+
 // Create CPU thread
 
 void createCPUThread (uint cpuNum)
@@ -482,13 +542,10 @@ void createCPUThread (uint cpuNum)
 #if defined(AFFINITY)
     if (cpus[cpuNum].set_affinity)
       {
-        cpu_set_t cpuset;
-        CPU_ZERO (& cpuset);
-        CPU_SET (cpus[cpuNum].affinity, & cpuset);
-        int s = pthread_setaffinity_np (p->cpuThread, sizeof (cpu_set_t), & cpuset);
+        int s = setThreadAffinity (p->cpuThread, (int) cpus[cpuNum].affinity);
         if (s)
-          sim_printf ("pthread_setaffinity_np %u on CPU %u returned %d\r\n",
-                      cpus[cpuNum].affinity, cpuNum, s);
+          sim_warn ("Unable to bind CPU %c to host CPU %u: %s\r\n",
+                    'A' + cpuNum, cpus[cpuNum].affinity, xstrerror_l (s));
       }
 #endif /* if defined(AFFINITY) */
   }
@@ -585,6 +642,12 @@ void wakeCPU (uint cpuNum)
     int rc;
     struct cpuThreadz_t * p = & cpuThreadz[cpuNum];
 
+    // Most wakes are for a running CPU; don't take the lock for those. A
+    // CPU that sets 'sleeping' after this test is the same window as
+    // waking before it locks, and is bounded by the sleep timeout.
+    if (! p->sleeping)
+      return;
+
     rc = pthread_mutex_lock (& p->sleepLock);
     if (rc)
       sim_printf ("sleepCPU pthread_mutex_lock sleepLock %d\r\n", rc);
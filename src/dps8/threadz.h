@@ -231,6 +231,12 @@ void setChnConnect (uint iomNum, uint chnNum);
 void chnRdyWait (uint iomNum, uint chnNum);
 #endif /* if defined(IO_THREADZ) */
 
+#if defined(AFFINITY)
+// host CPU placement
+int setThreadAffinity (pthread_t thread, int hostCPU);
+char * getThreadAffinity (pthread_t thread, char * buf, size_t len);
+#endif /* if defined(AFFINITY) */
+
 void initThreadz (void);
 void setSignals (void);
 
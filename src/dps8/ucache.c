@@ -19,24 +19,82 @@
 #include "dps8.h"
 #include "dps8_cpu.h"
 
+uint ucache_sets = UC_DEFAULT_SIZE / UC_DEFAULT_WAYS;
+uint ucache_ways = UC_DEFAULT_WAYS;
+
+// The operand store and APU data read classes are saved only after the
+// ring checks have passed for the TRR in effect; a hit requires the same TRR.
+static const bool ucRingChecked [UC_NUM] = {
+  [UC_OPERAND_STORE] = true,
+  [UC_APU_DATA_READ] = true,
+};
+
+#define UC_LIVE(ep) ((ep)->valid && (ep)->gen == cpu.uCache.gen)
+
 void ucInvalidate (cpu_state_t * cpup) {
-  (void)memset (cpu.uCache.caches, 0, sizeof (cpu.uCache.caches));
+  cpu.uCache.flushes ++;
+  cpu.uCache.gen ++;
+  // On wrap, stale entries would become live again; really clear them.
+  if (cpu.uCache.gen == 0)
+    (void)memset (cpu.uCache.caches, 0, sizeof (cpu.uCache.caches));
+}
+
+// The caches belong to the CPU threads, so the geometry may be changed
+// only while no CPU is executing.
+
+t_stat ucSetGeometry (uint size, uint ways) {
+#if defined(THREADZ) || defined(LOCKLESS)
+  for (uint i = 0; i < N_CPU_UNITS_MAX; i ++)
+    if (cpus[i].executing)
+      return SCPE_NOFNC;
+#endif /* if defined(THREADZ) || defined(LOCKLESS) */
+  if (ways < 1 || ways > UC_MAX_WAYS || size < ways || size > UC_CACHE_MAX)
+    return SCPE_ARG;
+  uint sets = size / ways;
+  // The set index is taken from the low bits of the segment number
+  if (sets * ways != size || (sets & (sets - 1)) != 0)
+    return SCPE_ARG;
+  ucache_sets = sets;
+  ucache_ways = ways;
+  for (uint i = 0; i < N_CPU_UNITS_MAX; i ++)
+    (void)memset (cpus[i].uCache.caches, 0, sizeof (cpus[i].uCache.caches));
+  return SCPE_OK;
 }
 
 void ucCacheSave \
          (cpu_state_t * cpup, uint ucNum, word15 segno, word18 offset, word14 bound,
           word1 p, word24 address, word3 r1, bool paged) {
-  if (segno >= UC_CACHE_SZ) {
-    return;
+  uint ways = ucache_ways;
+  uint base  = (segno & (ucache_sets - 1)) * ways;
+  ucache_t * set = & cpu.uCache.caches[ucNum][base];
+  ucache_t * ep  = NULL;
+  // Prefer the entry already holding this segment (and page); then an
+  // empty way; otherwise evict round-robin.
+  for (uint w = 0; w < ways; w ++) {
+    ucache_t * wp = set + w;
+    if (! UC_LIVE (wp)) {
+      if (! ep)
+        ep = wp;
+      continue;
+    }
+    if (wp->segno == segno &&
+        (! paged || ! wp->paged || (wp->offset & PG18MASK) == (offset & PG18MASK))) {
+      ep = wp;
+      break;
+    }
+  }
+  if (! ep) {
+    ep = set + (cpu.uCache.victim[ucNum] ++ % ways);
+    cpu.uCache.evictions ++;
   }
-  ucache_t * ep;
-  ep          = & cpu.uCache.caches[ucNum][segno];
   ep->valid   = true;
+  ep->gen     = cpu.uCache.gen;
   ep->segno   = segno;
   ep->offset  = offset;
   ep->bound   = bound;
   ep->address = address;
   ep->r1      = r1;
+  ep->trr     = cpu.TPR.TRR;
   ep->p       = p;
   ep->paged   = paged;
 #if defined(HDBG)
@@ -48,165 +106,104 @@ void ucCacheSave \
 bool ucCacheCheck \
          (cpu_state_t * cpup, uint ucNum, word15 segno, word18 offset, word14 * bound,
           word1 * p, word24 * address, word3 * r1, bool * paged) {
-  if (segno >= UC_CACHE_SZ) {
-#if defined(UCACHE_STATS)
-    cpu.uCache.segnoSkips ++;
-#endif
-    return false;
-  }
-  ucache_t * ep;
-  ep = & cpu.uCache.caches[ucNum][segno];
-  // Is cache entry valid?
-  if (! ep->valid) {
+  uint ways = ucache_ways;
+  uint base  = (segno & (ucache_sets - 1)) * ways;
+  ucache_t * set = & cpu.uCache.caches[ucNum][base];
+  for (uint w = 0; w < ways; w ++) {
+    ucache_t * ep = set + w;
+    // Is cache entry valid?
+    if (! UC_LIVE (ep))
+      continue;
+    // Same segment?
+    if (ep->segno != segno)
+      continue;
+    // Same page?
+    if (ep->paged && ((ep->offset & PG18MASK) != (offset & PG18MASK))) {
 #if defined(HDBG)
-    hdbgNote ("ucache", "check not valid");
-#endif
-    goto miss;
-  }
-#if 0
-  // Same segment?
-  if (ep->segno != segno) {
-# if defined(HDBG)
-    hdbgNote ("ucache", "segno %o != %o\r\n", ep->segno, segno);
-# endif
-    goto miss;
-  }
+      hdbgNote ("ucache", "pgno %o != %o\r\n", (ep->offset & PG18MASK), (offset & PG18MASK));
 #endif
-  // Same page?
-  if (ep->paged && ((ep->offset & PG18MASK) != (offset & PG18MASK))) {
+      continue;
+    }
+    // In bounds?
+    if (((offset >> 4) & 037777) > ep->bound) {
 #if defined(HDBG)
-    hdbgNote ("ucache", "pgno %o != %o\r\n", (ep->offset & PG18MASK), (offset & PG18MASK));
+      hdbgNote ("ucache", "bound %o != %o\r\n", ((offset >> 4) & 037777), ep->bound);
 #endif
-    goto miss;
-  }
-  // In bounds?
-  if (((offset >> 4) & 037777) > ep->bound) {
-    //sim_printf ("bound %o != %o\r\n", ((offset >> 4) & 037777), ep->bound);
+      goto miss;
+    }
+    // Validated for this ring?
+    if (ucRingChecked[ucNum] && ep->trr != cpu.TPR.TRR)
+      goto miss;
 #if defined(HDBG)
-    hdbgNote ("ucache", "bound %o != %o\r\n", ((offset >> 4) & 037777), ep->bound);
+    hdbgNote ("ucache", "hit %u %05o:%06o %05o %o %08o %o %o",
+              ucNum, segno, offset, ep->bound, ep->p, ep->address, ep->r1, ep->paged);
 #endif
-    goto miss;
+    * bound   = ep->bound;
+    * address = ep->address;
+    * r1      = ep->r1;
+    * p       = ep->p;
+    * paged   = ep->paged;
+    cpu.uCache.hits[ucNum] ++;
+    return true;
   }
 #if defined(HDBG)
-  hdbgNote ("ucache", "hit %u %05o:%06o %05o %o %08o %o %o",
-            ucNum, segno, offset, ep->bound, ep->p, ep->address, ep->r1, ep->paged);
+  hdbgNote ("ucache", "check not valid");
 #endif
-  * bound = ep->bound;
-#if 0
-  if (ep->paged) {
-    word18 pgoffset = offset & OS18MASK;
-    * address = (ep->address & PG24MASK) + pgoffset;
-# if defined(HDBG)
-    hdbgNote ("ucache", "  FAP pgoffset %06o address %08o", pgoffset, * address);
-# endif
-  } else {
-    * address = (ep->address & 077777760) + offset;
-# if defined(HDBG)
-    hdbgNote ("ucache", "  FANP pgoffset %06o address %08o", pgoffset, * address);
-# endif
-  }
-#else
-  * address = ep->address;
-#endif
-  * r1      = ep->r1;
-  * p       = ep->p;
-  * paged   = ep->paged;
-#if defined(UCACHE_STATS)
-  cpu.uCache.hits[ucNum] ++;
-#endif
-  return true;
 miss:;
-#if defined(UCACHE_STATS)
   cpu.uCache.misses[ucNum] ++;
-#endif
   return false;
 }
 
-#if defined(UCACHE_STATS)
+static void ucStatsClass (const char * title, uint64_t hits, uint64_t misses, uint64_t skips) {
+  double eff = (hits + misses + skips) ? hits * 100.0 / (hits + misses + skips) : 0;
+  sim_msg ("\r|  %-31s|\r\n", title);
+#if defined(WIN_STDIO)
+  sim_msg ("\r|    Hits        %15llu  |\r\n|    Misses      %15llu  |"
+           "\r\n|    Skipped     %15llu  |\r\n|    Effectiveness   %10.2f%%  |\r\n",
+#else
+  sim_msg ("\r|    Hits        %'15llu  |\r\n|    Misses      %'15llu  |"
+           "\r\n|    Skipped     %'15llu  |\r\n|    Effectiveness   %'10.2f%%  |\r\n",
+#endif
+           (long long unsigned)hits, (long long unsigned)misses,
+           (long long unsigned)skips, eff);
+  sim_msg ("\r+---------------------------------+\r\n");
+}
+
+static void ucStatsCount (const char * title, uint64_t n) {
+#if defined(WIN_STDIO)
+  sim_msg ("\r|    %-12s%15llu  |\r\n", title, (long long unsigned)n);
+#else
+  sim_msg ("\r|    %-12s%'15llu  |\r\n", title, (long long unsigned)n);
+#endif
+}
+
 void ucacheStats (int cpuNo) {
+  uCache_t * ucp = & cpus[cpuNo].uCache;
   (void)fflush(stdout);
   (void)fflush(stderr);
   sim_msg ("\r\n|   CPU %c Micro-cache Statistics  |", 'A' + cpuNo);
   sim_msg ("\r\n+---------------------------------+\r\n");
-# define pct(a, b) ((b) ? (a) * 100.0 / ((a) + (b)) : 0)
-# define args(a, b, c) a, b, c, pct (a, (b + c))
-# define stats(n) args ( (long long unsigned)cpus[cpuNo].uCache.hits  [n], \
-                         (long long unsigned)cpus[cpuNo].uCache.misses[n], \
-                         (long long unsigned)cpus[cpuNo].uCache.skips [n] )
-  (void)fflush(stdout);
-  (void)fflush(stderr);
-# if defined(WIN_STDIO)
-  sim_msg ("\r|  Instruction Fetch:             |\r\n|    Hits        %15llu  |"
-           "\r\n|    Misses      %15llu  |\r\n|    Skipped     %15llu  |"
-           "\r\n|    Effectiveness   %10.2f%%  |\r\n",
-           stats (UC_INSTRUCTION_FETCH));
-  (void)fflush(stdout);
-  (void)fflush(stderr);
-  sim_msg ("\r+---------------------------------+\r\n");
-  sim_msg ("\r|  Operand Read:                  |\r\n|    Hits        %15llu  |"
-           "\r\n|    Misses      %15llu  |\r\n|    Skipped     %15llu  |"
-           "\r\n|    Effectiveness   %10.2f%%  |\r\n",
-           stats (UC_OPERAND_READ));
-  (void)fflush(stdout);
-  (void)fflush(stderr);
-#  if defined(IDWF_CACHE)
-  sim_msg ("\r+---------------------------------+\r\n");
-  sim_msg ("\r|  Indirect Word Fetch:           |\r\n|    Hits        %15llu  |"
-           "\r\n|    Misses      %15llu  |\r\n|    Skipped     %15llu  |"
-           "\r\n|    Effectiveness   %10.2f%%  |\r\n",
-           stats (UC_INDIRECT_WORD_FETCH));
-  (void)fflush(stdout);
-  (void)fflush(stderr);
-#  endif
+  sim_msg ("\r|  Geometry   %5u sets %2u ways  |\r\n", ucache_sets, ucache_ways);
   sim_msg ("\r+---------------------------------+\r\n");
+#define stats(n) ucp->hits[n], ucp->misses[n], ucp->skips[n]
+  ucStatsClass ("Instruction Fetch:", stats (UC_INSTRUCTION_FETCH));
+  ucStatsClass ("Operand Read:", stats (UC_OPERAND_READ));
+  ucStatsClass ("Operand Read (Transfer):", stats (UC_OPERAND_READ_TRA));
+  ucStatsClass ("Operand Store:", stats (UC_OPERAND_STORE));
+  ucStatsClass ("APU Data Read:", stats (UC_APU_DATA_READ));
+#if defined(IDWF_CACHE)
+  ucStatsClass ("Indirect Word Fetch:", stats (UC_INDIRECT_WORD_FETCH));
+#endif
+#undef stats
   sim_msg ("\r|  Cache Bypasses:                |\r\n");
-  sim_msg ("\r|    RALR        %15llu  |\r\n",
-           (long long unsigned)cpus[cpuNo].uCache.ralrSkips);
-  sim_msg ("\r|    CALL6       %15llu  |\r\n",
-           (long long unsigned)cpus[cpuNo].uCache.call6Skips);
-  sim_msg ("\r|    Segno       %15llu  |\r\n",
-           (long long unsigned)cpus[cpuNo].uCache.segnoSkips);
-  (void)fflush(stdout);
-  (void)fflush(stderr);
-# else
-  sim_msg ("\r|  Instruction Fetch:             |\r\n|    Hits        %'15llu  |"
-           "\r\n|    Misses      %'15llu  |\r\n|    Skipped     %'15llu  |"
-           "\r\n|    Effectiveness   %'10.2f%%  |\r\n",
-           stats (UC_INSTRUCTION_FETCH));
-  (void)fflush(stdout);
-  (void)fflush(stderr);
+  ucStatsCount ("RALR", ucp->ralrSkips);
+  ucStatsCount ("CALL6", ucp->call6Skips);
+  ucStatsCount ("Prepage", ucp->prepageSkips);
   sim_msg ("\r+---------------------------------+\r\n");
-  sim_msg ("\r|  Operand Read:                  |\r\n|    Hits        %'15llu  |"
-           "\r\n|    Misses      %'15llu  |\r\n|    Skipped     %'15llu  |"
-           "\r\n|    Effectiveness   %'10.2f%%  |\r\n",
-           stats (UC_OPERAND_READ));
-  (void)fflush(stdout);
-  (void)fflush(stderr);
-#  if defined(IDWF_CACHE)
+  sim_msg ("\r|  Replacement:                   |\r\n");
+  ucStatsCount ("Evictions", ucp->evictions);
+  ucStatsCount ("Flushes", ucp->flushes);
   sim_msg ("\r+---------------------------------+\r\n");
-  sim_msg ("\r|  Indirect Word Fetch:           |\r\n|    Hits        %'15llu  |"
-           "\r\n|    Misses      %'15llu  |\r\n|    Skipped     %'15llu  |"
-           "\r\n|    Effectiveness   %'10.2f%%  |\r\n",
-           stats (UC_INDIRECT_WORD_FETCH));
   (void)fflush(stdout);
   (void)fflush(stderr);
-#  endif
-  sim_msg ("\r+---------------------------------+\r\n");
-  sim_msg ("\r|  Cache Bypasses:                |\r\n");
-  sim_msg ("\r|    RALR        %'15llu  |\r\n",
-           (long long unsigned)cpus[cpuNo].uCache.ralrSkips);
-  sim_msg ("\r|    CALL6       %'15llu  |\r\n",
-           (long long unsigned)cpus[cpuNo].uCache.call6Skips);
-  sim_msg ("\r|    Segno       %'15llu  |\r\n",
-           (long long unsigned)cpus[cpuNo].uCache.segnoSkips);
-  (void)fflush(stdout);
-  (void)fflush(stderr);
-# endif
-  sim_msg ("\r+---------------------------------+\r\n");
-  (void)fflush(stdout);
-  (void)fflush(stderr);
-# undef pct
-# undef args
-# undef stats
 }
-#endif
@@ -18,9 +18,17 @@
 // It is believed that the maximum segment
 // number that Multics uses will be 4095.
 // Normal usage should be <= ~512 (0400)?
+//
+// Each cycle class has UC_CACHE_MAX entries of storage, arranged as
+// (size / ways) sets of 'ways' entries; the set is selected by the low
+// bits of the segment number and the entries of a set hold different
+// segments or different pages of the same segment. The geometry is
+// changed with "SET CPU UCACHE=size:ways".
 
-//#define UC_CACHE_SZ 4096
-#define UC_CACHE_SZ 512
+#define UC_CACHE_MAX     4096
+#define UC_DEFAULT_SIZE  1024
+#define UC_DEFAULT_WAYS  2
+#define UC_MAX_WAYS      16
 
 // Micro-cache
 
@@ -32,7 +40,9 @@ struct ucache_s {
   word1  p;
   word24 address;
   word3  r1;
+  word3  trr;
   bool   paged;
+  uint32 gen;
 };
 typedef struct ucache_s ucache_t;
 
@@ -41,24 +51,32 @@ typedef struct ucache_s ucache_t;
 #define UC_OPERAND_READ        2
 #define UC_OPERAND_READ_TRA    3
 #define UC_OPERAND_READ_CALL6  4
-#define UC_NUM                 5
+#define UC_OPERAND_STORE       5
+#define UC_APU_DATA_READ       6
+#define UC_NUM                 7
 
 struct uCache_s {
-  ucache_t caches [UC_NUM][UC_CACHE_SZ];
-#if defined(UCACHE_STATS)
+  ucache_t caches [UC_NUM][UC_CACHE_MAX];
+  // Entries are live only if their gen matches; ucInvalidate bumps it.
+  uint32   gen;
+  uint     victim [UC_NUM];
   uint64_t hits   [UC_NUM];
   uint64_t misses [UC_NUM];
   uint64_t skips  [UC_NUM];
+  uint64_t evictions;
+  uint64_t flushes;
   uint64_t call6Skips;
   uint64_t ralrSkips;
-  uint64_t segnoSkips;
-#endif /* if defined(UCACHE_STATS) */
+  uint64_t prepageSkips;
 };
 
 typedef struct uCache_s uCache_t;
 
 struct cpu_state_s;
 
+extern uint ucache_sets;
+extern uint ucache_ways;
+
 void ucInvalidate (struct cpu_state_s * cpup);
 void ucCacheSave  \
  (struct cpu_state_s * cpup, uint ucNum, word15 segno,
@@ -66,6 +84,5 @@ void ucCacheSave  \
 bool ucCacheCheck \
  (struct cpu_state_s * cpup, uint ucNum, word15 segno,
   word18 offset, word14 * bound, word1 * p, word24 * address, word3 * r1, bool * paged);
-#if defined(UCACHE_STATS)
+t_stat ucSetGeometry (uint size, uint ways);
 void ucacheStats (int cpuNo);
-#endif /* if defined(UCACHE_STATS) */
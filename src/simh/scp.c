@@ -158,6 +158,7 @@
 #include "../dps8/dps8_rt.h"
 #include "../dps8/dps8_priv.h"
 #include "../dps8/dps8_topo.h"
+#include "../dps8/dps8_eistest.h"
 #include "../dps8/ver.h"
 
 #include "../dps8/dps8_iom.h"
@@ -433,6 +434,7 @@ int32 sim_quiet                  = 0;
 int32 sim_localopc               = 1;
 int32 sim_randompst              = 0;
 int32 sim_randstate              = 0;
+int32 sim_hugepages              = 0;
 int32 sim_step                   = 0;
 int nodist                       = 0;
 #if defined(PERF_STRIP)
@@ -1971,6 +1973,17 @@ for (i = 1; i < argc; i++) {                            /* loop thru args */
     }
 # endif
 
+/* EIS decimal unit test */
+    int eistestflag  = strcmp(argv[i], "--eistest");
+    if (eistestflag == 0) {
+      uint32_t cases = 10000, seed = 1;
+      if (i + 1 < argc)
+        cases = (uint32_t) strtoul (argv[i + 1], NULL, 0);
+      if (i + 2 < argc)
+        seed = (uint32_t) strtoul (argv[i + 2], NULL, 0);
+      return eisTest (cases, seed);
+    }
+
 /* requested only version? */
     int onlyvers  = strcmp(argv[i], "--version");
     if (onlyvers == 0) {
@@ -2022,6 +2035,7 @@ for (i = 1; i < argc; i++) {                            /* loop thru args */
         (void)fprintf (stdout, "\r\n  -h, -H, --help    Prints only this informational help text and exits");
         (void)fprintf (stdout, "\r\n  -k, -K            Disables all support for exclusive file locking");
         (void)fprintf (stdout, "\r\n  -l, -L            Reports but ignores all exclusive file locking errors");
+        (void)fprintf (stdout, "\r\n  -m, -M            Backs the system state with huge pages when available");
         (void)fprintf (stdout, "\r\n  -o, -O            Makes scripting ON conditions and actions inheritable");
 # if !defined(__MINGW32__) && !defined(__MINGW64__) && !defined(CROSS_MINGW32) && !defined(CROSS_MINGW64) && !defined(__CYGWIN__)
         (void)fprintf (stdout, "\r\n  -p, -P            Enables real-time scheduling (may require privileges)");
@@ -2085,6 +2099,7 @@ if (sim_nostate)                                    /*    and disables -s and -r
     sim_randstate = 0;
   }
 sim_on_inherit = sim_switches & SWMASK ('O');       /* -o means inherit on state */
+sim_hugepages = sim_switches & SWMASK ('M');        /* -m means huge page memory */
 
 # if !defined(__MVS__) && !defined(__MINGW32__) && !defined(__MINGW64__) && \
      !defined(CROSS_MINGW32) && !defined(CROSS_MINGW64) && !defined(__CYGWIN__)
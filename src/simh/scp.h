@@ -236,6 +236,7 @@ extern int32 sim_quiet;
 extern int32 sim_localopc;
 extern int32 sim_randstate;
 extern int32 sim_nostate;
+extern int32 sim_hugepages;
 extern int32 sim_step;
 extern t_stat sim_last_cmd_stat;                        /* Command Status */
 extern FILE *sim_log;                                   /* log file */
@@ -72,6 +72,7 @@
 #include "sim_defs.h"
 #include "sim_tape.h"
 #include <ctype.h>
+#include <fcntl.h>
 #include <signal.h>
 
 #if defined(NO_LOCALE)
@@ -122,9 +123,14 @@ struct tape_context {
     DEVICE              *dptr;              /* Device for unit (access to debug flags) */
     uint32              dbit;               /* debugging bit for trace */
     uint32              auto_format;        /* Format determined dynamically */
+    uint8               *rabuf;             /* read-ahead window */
+    t_addr              rapos;              /* tape position of rabuf[0] */
+    size_t              ralen;              /* valid bytes in rabuf */
     };
 #define tape_ctx up8                        /* Field in Unit structure which points to the tape_context */
 
+#define TAPE_RA_SIZE    (1024 * 1024)       /* read-ahead window size */
+
 /*
    This routine is called when the simulator stops and any time
    the asynch mode is changed (enabled or disabled)
@@ -269,6 +275,8 @@ switch (f) {                                            /* case on format */
         }
 
 sim_tape_rewind (uptr);
+if (ctx && ctx->rabuf)
+    FREE (ctx->rabuf);
 FREE (uptr->tape_ctx);
 uptr->tape_ctx = NULL;
 uptr->io_flush = NULL;
@@ -770,6 +778,52 @@ sim_debug (MTSE_DBG_STR, ctx->dptr, "rd_lnt: st: %lld, lnt: %lld, pos: %" T_ADDR
 return r;
 }
 
+/* Read-ahead window (internal routine)
+
+   Returns a pointer to the len bytes of the tape image starting at pos, or
+   NULL if they are not all present in the image or do not fit in the window.
+   The window is refilled with a single large read starting at pos whenever it
+   does not already hold the requested bytes, and the kernel is asked to start
+   reading the following window so that a sequential reader rarely waits for
+   the disk.  The window is discarded by every write to the tape image.
+
+   The stream position and EOF/error indicators of the unit's file are left
+   undefined; every other routine seeks before reading or writing, and any
+   read error is left for the unbuffered path to report.
+*/
+
+static const uint8 *sim_tape_ra_get (UNIT *uptr, t_addr pos, size_t len)
+{
+struct tape_context *ctx = (struct tape_context *)uptr->tape_ctx;
+
+if (len > TAPE_RA_SIZE)                                 /* never fits? */
+    return NULL;
+if (ctx->ralen != 0 && pos >= ctx->rapos
+  && pos + len <= ctx->rapos + ctx->ralen)              /* in the window? */
+    return ctx->rabuf + (pos - ctx->rapos);
+if (ctx->rabuf == NULL) {                               /* first use? */
+    ctx->rabuf = (uint8 *)malloc (TAPE_RA_SIZE);
+    if (ctx->rabuf == NULL)
+        return NULL;
+    }
+ctx->ralen = 0;
+if (sim_fseek (uptr->fileref, pos, SEEK_SET) != 0)
+    return NULL;
+ctx->ralen = sim_fread (ctx->rabuf, sizeof (uint8), TAPE_RA_SIZE, uptr->fileref);
+ctx->rapos = pos;
+if (ferror (uptr->fileref))                             /* let the caller retry */
+    ctx->ralen = 0;                                     /*   unbuffered */
+clearerr (uptr->fileref);
+#if defined(POSIX_FADV_WILLNEED)
+if (ctx->ralen == TAPE_RA_SIZE)                         /* more to come? */
+    (void)posix_fadvise (fileno (uptr->fileref), (off_t)(pos + TAPE_RA_SIZE),
+                         TAPE_RA_SIZE, POSIX_FADV_WILLNEED);
+#endif /* if defined(POSIX_FADV_WILLNEED) */
+if (pos + len > ctx->rapos + ctx->ralen)                /* short image? */
+    return NULL;
+return ctx->rabuf;
+}
+
 /* Read record forward
 
    Inputs:
@@ -798,12 +852,33 @@ uint32 f = MT_GET_FMT (uptr);
 t_mtrlnt i, tbc, rbc;
 t_addr opos;
 t_stat st;
+const uint8 *rp;
 
 if (ctx == NULL)                                        /* if not properly attached? */
     return sim_messagef (SCPE_IERR, "Bad Attach\r\n");  /*   that's a problem */
 sim_debug (ctx->dbit, ctx->dptr, "sim_tape_rdrecf(unit=%d, buf=%p, max=%lld)\r\n",
            (int)(uptr-ctx->dptr->units), buf, (long long)max);
 
+if (((f == MTUF_F_STD) || (f == MTUF_F_E11))            /* SIMH or E11 data record */
+  && (uptr->flags & UNIT_ATT)                           /*   in the read-ahead window? */
+  && (rp = sim_tape_ra_get (uptr, uptr->pos, sizeof (t_mtrlnt))) != NULL) {
+    tbc = (t_mtrlnt)rp[0] | ((t_mtrlnt)rp[1] << 8)      /* little-endian marker */
+      | ((t_mtrlnt)rp[2] << 16) | ((t_mtrlnt)rp[3] << 24);
+    rbc = MTR_L (tbc);
+    if ((tbc != MTR_TMK) && (tbc != MTR_EOM)            /* anything but a plain */
+      && (tbc != MTR_GAP) && (tbc != MTR_FHGAP)         /*   record that fits is */
+      && (rbc <= max)                                   /*   left to the code below */
+      && (rp = sim_tape_ra_get (uptr, uptr->pos + sizeof (t_mtrlnt), rbc)) != NULL) {
+        MT_CLR_PNU (uptr);
+        memcpy (buf, rp, rbc);
+        *bc = rbc;
+        uptr->pos = uptr->pos + (2 * sizeof (t_mtrlnt)) /* space over the record */
+          + (f == MTUF_F_STD ? (rbc + 1) & ~1 : rbc);
+        sim_tape_data_trace(uptr, buf, rbc, "Record Read", ctx->dptr->dctrl & MTSE_DBG_DAT, MTSE_DBG_STR);
+        return (MTR_F (tbc)? MTSE_RECE: MTSE_OK);
+        }
+    }
+
 opos = uptr->pos;                                       /* old position */
 if (MTSE_OK != (st = sim_tape_rdlntf (uptr, &tbc)))     /* read rec lnt */
     return st;
@@ -928,6 +1003,7 @@ if (sim_tape_wrp (uptr))                                /* write prot? */
     return MTSE_WRP;
 if (sbc == 0)                                           /* nothing to do? */
     return MTSE_OK;
+ctx->ralen = 0;                                         /* discard read-ahead */
 (void)sim_fseek (uptr->fileref, uptr->pos, SEEK_SET);         /* set pos */
 switch (f) {                                            /* case on format */
 
@@ -980,6 +1056,7 @@ if (ctx == NULL)                                        /* if not properly attac
     return sim_messagef (SCPE_IERR, "Bad Attach\r\n");  /*   that's a problem */
 if (sim_tape_wrp (uptr))                                /* write prot? */
     return MTSE_WRP;
+ctx->ralen = 0;                                         /* discard read-ahead */
 (void)sim_fseek (uptr->fileref, uptr->pos, SEEK_SET);         /* set pos */
 (void)sim_fwrite (&dat, sizeof (uint32_t), 1, uptr->fileref);
 if (ferror (uptr->fileref)) {                           /* error? */
@@ -0,0 +1,982 @@
+/*
+ * vim: filetype=c:tabstop=4:ai:expandtab
+ * SPDX-License-Identifier: ICU
+ * scspell-id: 3f0c9d4e-8b1a-11f1-9c52-80ee73e9b8e7
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (c) 2026 The DPS8M Development Team
+ *
+ * This software is made available under the terms of the ICU License.
+ * See the LICENSE.md file at the top-level directory of this distribution.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+/*
+ * termload: synthetic terminal load for the FNP
+ *
+ * Opens N TELNET sessions to the simulator's FNP dialup listener, drives
+ * each through a small expect/send script (by default: take any line,
+ * log in, then loop over a command mix), and reports per-session echo
+ * latency and command response percentiles, output rates, and the CPU
+ * used by the simulator process.
+ *
+ * Script lines (one per line, '#' starts a comment):
+ *
+ *   expect TEXT   wait for TEXT in the session output
+ *   send TEXT     send TEXT as is
+ *   type TEXT     send TEXT one character at a time, timing each echo
+ *   cmd TEXT      'type' TEXT, send CR and time the wait for the prompt
+ *   prompt TEXT   set the text 'cmd' waits for (default: "\nr ")
+ *   think MS      pause for MS milliseconds
+ *   loop          repeat from here until the run ends
+ *
+ * In TEXT, \r \n \t \\ are escapes, %n is the session number, %u the
+ * user name and %w the password (-u and -w, which may themselves
+ * contain %n).
+ */
+
+#if !defined(_GNU_SOURCE)
+# define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <getopt.h>
+
+#if defined(_WIN32)
+int
+main (void)
+{
+    (void)fprintf (stderr, "termload: not supported on this platform\n");
+    return EXIT_FAILURE;
+}
+#else
+
+# include <fcntl.h>
+# include <poll.h>
+# include <signal.h>
+# include <netdb.h>
+# include <sys/socket.h>
+# include <sys/time.h>
+# include <sys/resource.h>
+# include <netinet/in.h>
+# include <netinet/tcp.h>
+# include <arpa/inet.h>
+
+# define MAX_SESSIONS 1024
+# define MAX_OPS      256
+# define MAX_TEXT     256
+# define WIN_SIZE     8192
+
+# define TN_IAC  255
+# define TN_DONT 254
+# define TN_DO   253
+# define TN_WONT 252
+# define TN_WILL 251
+# define TN_SB   250
+# define TN_SE   240
+
+enum op_code { OP_EXPECT, OP_SEND, OP_TYPE, OP_CMD, OP_PROMPT, OP_THINK, OP_LOOP };
+
+struct op
+{
+    enum op_code code;
+    char text[MAX_TEXT];
+    long ms;
+};
+
+enum wait_state
+{
+    W_NONE,      // runnable
+    W_CONNECT,   // non-blocking connect in progress
+    W_EXPECT,    // waiting for 'expect' text
+    W_ECHO,      // waiting for the echo of a typed character
+    W_ECHOED,    // echo seen; type the next character
+    W_PROMPT,    // waiting for the prompt after 'cmd'
+    W_THINK,     // sleeping
+    W_DONE       // closed
+};
+
+enum tn_state { TN_DATA, TN_CMD, TN_OPT, TN_SUB, TN_SUBIAC };
+
+struct samples
+{
+    double * v;
+    size_t n, cap;
+};
+
+struct session
+{
+    int num;
+    int fd;
+    enum wait_state wait;
+    int pc;
+    int loopPc;
+    char prompt[MAX_TEXT];
+    // Current 'type'/'cmd' text and position
+    char typing[MAX_TEXT];
+    size_t typePos;
+    bool isCmd;
+    char echoChar;
+    double sentAt;
+    double waitUntil;
+    double deadline;
+    // TELNET parser
+    enum tn_state tn;
+    unsigned char tnCmd;
+    bool optReplied[2][256];
+    // Output window for matching
+    char win[WIN_SIZE];
+    size_t winLen;
+    // Statistics
+    struct samples echo;
+    struct samples resp;
+    uint64_t bytesIn;
+    uint64_t bytesOut;
+    uint64_t echoMissed;
+    double start;
+    double end;
+    bool failed;
+    char why[128];
+};
+
+static struct op ops[MAX_OPS];
+static int nOps;
+
+static struct session * sessions;
+static int nSessions = 1;
+static const char * host = "127.0.0.1";
+static const char * port = "6180";
+static const char * userFmt = "Guest";
+static const char * passFmt = "";
+static double runSecs = 60.0;
+static double rampMs = 50.0;
+static double timeoutSecs = 60.0;
+static double echoTimeoutSecs = 2.0;
+static long simPid;
+static bool verbose;
+
+static volatile sig_atomic_t interrupted;
+
+static const char * defaultScript =
+    "expect HSLA Port\n"
+    "send \\r\n"
+    "expect Load =\n"
+    "send login %u\\r\n"
+    "expect Password:\n"
+    "send %w\\r\n"
+    "expect \\nr \n"
+    "loop\n"
+    "think 2000\n"
+    "cmd who\n"
+    "think 2000\n"
+    "cmd list\n"
+    "think 2000\n"
+    "cmd print_motd\n";
+
+static double
+now (void)
+{
+    struct timespec ts;
+    (void)clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void
+on_signal (int sig)
+{
+    (void)sig;
+    interrupted = 1;
+}
+
+static void
+add_sample (struct samples * s, double v)
+{
+    if (s->n == s->cap)
+    {
+        size_t cap = s->cap ? s->cap * 2 : 256;
+        double * nv = realloc (s->v, cap * sizeof (double));
+        if (!nv)
+        {
+            (void)fprintf (stderr, "termload: out of memory\n");
+            exit (EXIT_FAILURE);
+        }
+        s->v = nv;
+        s->cap = cap;
+    }
+    s->v[s->n++] = v;
+}
+
+static int
+cmp_double (const void * a, const void * b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// p-th percentile of a sorted sample set
+
+static double
+pctl (const struct samples * s, double p)
+{
+    if (!s->n)
+        return 0.0;
+    size_t i = (size_t)(p / 100.0 * (double)s->n + 0.999999);
+    if (i < 1)
+        i = 1;
+    if (i > s->n)
+        i = s->n;
+    return s->v[i - 1];
+}
+
+// Expand escapes and substitutions of a script argument
+
+static void
+expand (char * dst, size_t dstLen, const char * src, int num, int depth)
+{
+    size_t n = 0;
+    while (*src && n + 1 < dstLen)
+    {
+        char c = *src++;
+        if (c == '\\' && *src)
+        {
+            c = *src++;
+            switch (c)
+            {
+                case 'r': c = '\r'; break;
+                case 'n': c = '\n'; break;
+                case 't': c = '\t'; break;
+                default: break;
+            }
+            dst[n++] = c;
+        }
+        else if (c == '%' && *src)
+        {
+            char tmp[MAX_TEXT];
+            c = *src++;
+            tmp[0] = 0;
+            if (c == 'n')
+                (void)snprintf (tmp, sizeof (tmp), "%d", num);
+            else if (c == 'u' && depth == 0)
+                expand (tmp, sizeof (tmp), userFmt, num, 1);
+            else if (c == 'w' && depth == 0)
+                expand (tmp, sizeof (tmp), passFmt, num, 1);
+            else if (c == '%')
+                (void)snprintf (tmp, sizeof (tmp), "%%");
+            for (char * t = tmp; *t && n + 1 < dstLen; t++)
+                dst[n++] = *t;
+        }
+        else
+        {
+            dst[n++] = c;
+        }
+    }
+    dst[n] = 0;
+}
+
+static int
+parse_script (const char * text, const char * name)
+{
+    int lineNo = 0;
+    while (*text)
+    {
+        const char * eol = strchr (text, '\n');
+        size_t len = eol ? (size_t)(eol - text) : strlen (text);
+        char line[MAX_TEXT + 16];
+        if (len >= sizeof (line))
+            len = sizeof (line) - 1;
+        memcpy (line, text, len);
+        line[len] = 0;
+        text += eol ? len + 1 : len;
+        lineNo++;
+
+        // Trailing blanks are kept; they can be part of the text
+        while (len && line[len - 1] == '\r')
+            line[--len] = 0;
+        char * p = line;
+        while (isspace ((unsigned char)*p))
+            p++;
+        if (!*p || *p == '#')
+            continue;
+        char * arg = p;
+        while (*arg && !isspace ((unsigned char)*arg))
+            arg++;
+        if (*arg)
+            *arg++ = 0;
+
+        if (nOps >= MAX_OPS)
+        {
+            (void)fprintf (stderr, "%s:%d: too many script lines\n", name, lineNo);
+            return -1;
+        }
+        struct op * o = &ops[nOps];
+        if (!strcmp (p, "expect"))
+            o->code = OP_EXPECT;
+        else if (!strcmp (p, "send"))
+            o->code = OP_SEND;
+        else if (!strcmp (p, "type"))
+            o->code = OP_TYPE;
+        else if (!strcmp (p, "cmd"))
+            o->code = OP_CMD;
+        else if (!strcmp (p, "prompt"))
+            o->code = OP_PROMPT;
+        else if (!strcmp (p, "think"))
+            o->code = OP_THINK;
+        else if (!strcmp (p, "loop"))
+            o->code = OP_LOOP;
+        else
+        {
+            (void)fprintf (stderr, "%s:%d: unknown directive '%s'\n", name, lineNo, p);
+            return -1;
+        }
+        (void)snprintf (o->text, sizeof (o->text), "%s", arg);
+        o->ms = o->code == OP_THINK ? strtol (arg, NULL, 10) : 0;
+        nOps++;
+    }
+    return 0;
+}
+
+static int
+load_script (const char * path)
+{
+    FILE * f = fopen (path, "r");
+    if (!f)
+    {
+        (void)fprintf (stderr, "termload: %s: %s\n", path, strerror (errno));
+        return -1;
+    }
+    static char buf[MAX_OPS * (MAX_TEXT + 16)];
+    size_t n = fread (buf, 1, sizeof (buf) - 1, f);
+    (void)fclose (f);
+    buf[n] = 0;
+    return parse_script (buf, path);
+}
+
+static void
+fail (struct session * s, const char * why)
+{
+    if (s->wait == W_DONE)
+        return;
+    s->failed = true;
+    (void)snprintf (s->why, sizeof (s->why), "%s", why);
+    if (verbose)
+        (void)fprintf (stderr, "session %d: %s\n", s->num, why);
+    if (s->fd >= 0)
+        (void)close (s->fd);
+    s->fd = -1;
+    s->wait = W_DONE;
+    s->end = now ();
+}
+
+static void
+send_bytes (struct session * s, const void * data, size_t len)
+{
+    const char * p = data;
+    while (len && s->fd >= 0)
+    {
+        ssize_t n = send (s->fd, p, len, MSG_NOSIGNAL);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                struct pollfd pfd = { s->fd, POLLOUT, 0 };
+                (void)poll (&pfd, 1, 100);
+                continue;
+            }
+            fail (s, "send failed");
+            return;
+        }
+        s->bytesOut += (uint64_t)n;
+        p += n;
+        len -= (size_t)n;
+    }
+}
+
+static void
+tn_reply (struct session * s, unsigned char cmd, unsigned char opt)
+{
+    // Accept the server's ECHO, SGA and BINARY; refuse everything else
+    bool isWill = cmd == TN_WILL || cmd == TN_WONT;
+    if (s->optReplied[isWill][opt])
+        return;
+    s->optReplied[isWill][opt] = true;
+    unsigned char r[3] = { TN_IAC, 0, opt };
+    bool ok = opt == 0 || opt == 1 || opt == 3;
+    if (cmd == TN_WILL)
+        r[1] = ok ? TN_DO : TN_DONT;
+    else if (cmd == TN_DO)
+        r[1] = ok && opt != 1 ? TN_WILL : TN_WONT;
+    else
+        return;
+    send_bytes (s, r, sizeof (r));
+}
+
+static const char *
+find_text (const char * hay, size_t hayLen, const char * needle)
+{
+    size_t nl = strlen (needle);
+    if (!nl)
+        return hay;
+    for (size_t i = 0; i + nl <= hayLen; i++)
+        if (hay[i] == needle[0] && !memcmp (hay + i, needle, nl))
+            return hay + i;
+    return NULL;
+}
+
+// Consume the window through a match of 'text'; true if found
+
+static bool
+match (struct session * s, const char * text)
+{
+    const char * m = find_text (s->win, s->winLen, text);
+    if (!m)
+        return false;
+    size_t used = (size_t)(m - s->win) + strlen (text);
+    memmove (s->win, s->win + used, s->winLen - used);
+    s->winLen -= used;
+    return true;
+}
+
+static void
+add_output (struct session * s, const unsigned char * data, size_t len)
+{
+    double t = now ();
+    for (size_t i = 0; i < len; i++)
+    {
+        unsigned char c = data[i];
+        switch (s->tn)
+        {
+            case TN_DATA:
+                if (c == TN_IAC)
+                {
+                    s->tn = TN_CMD;
+                    continue;
+                }
+                break;
+            case TN_CMD:
+                if (c == TN_IAC)
+                {
+                    s->tn = TN_DATA;
+                    break;
+                }
+                s->tnCmd = c;
+                s->tn = (c >= TN_WILL && c <= TN_DONT) ? TN_OPT :
+                        c == TN_SB ? TN_SUB : TN_DATA;
+                continue;
+            case TN_OPT:
+                tn_reply (s, s->tnCmd, c);
+                s->tn = TN_DATA;
+                continue;
+            case TN_SUB:
+                if (c == TN_IAC)
+                    s->tn = TN_SUBIAC;
+                continue;
+            case TN_SUBIAC:
+                s->tn = c == TN_SE ? TN_DATA : TN_SUB;
+                continue;
+        }
+
+        // A data byte
+        if (s->wait == W_ECHO && (char)c == s->echoChar)
+        {
+            add_sample (&s->echo, t - s->sentAt);
+            s->wait = W_ECHOED;
+        }
+        if (s->winLen == WIN_SIZE)
+        {
+            memmove (s->win, s->win + WIN_SIZE / 2, WIN_SIZE / 2);
+            s->winLen = WIN_SIZE / 2;
+        }
+        s->win[s->winLen++] = (char)c;
+    }
+}
+
+// Type the next character of the current 'type'/'cmd' text
+
+static void
+type_next (struct session * s)
+{
+    char c = s->typing[s->typePos];
+    if (c)
+    {
+        s->typePos++;
+        s->echoChar = c;
+        s->sentAt = now ();
+        s->deadline = s->sentAt + echoTimeoutSecs;
+        s->wait = W_ECHO;
+        send_bytes (s, &c, 1);
+        return;
+    }
+    if (s->isCmd)
+    {
+        s->winLen = 0;
+        s->sentAt = now ();
+        s->deadline = s->sentAt + timeoutSecs;
+        s->wait = W_PROMPT;
+        send_bytes (s, "\r", 1);
+        return;
+    }
+    s->wait = W_NONE;
+}
+
+// Run script operations until the session has to wait
+
+static void
+step (struct session * s)
+{
+    while (s->wait == W_NONE)
+    {
+        if (s->pc >= nOps)
+        {
+            if (s->loopPc < 0)
+            {
+                s->wait = W_THINK;
+                s->waitUntil = 1e300;
+                return;
+            }
+            s->pc = s->loopPc;
+        }
+        struct op * o = &ops[s->pc++];
+        char text[MAX_TEXT];
+        expand (text, sizeof (text), o->text, s->num, 0);
+        switch (o->code)
+        {
+            case OP_EXPECT:
+                if (!match (s, text))
+                {
+                    s->pc--;
+                    s->wait = W_EXPECT;
+                    s->deadline = now () + timeoutSecs;
+                }
+                break;
+            case OP_SEND:
+                send_bytes (s, text, strlen (text));
+                break;
+            case OP_TYPE:
+            case OP_CMD:
+                (void)snprintf (s->typing, sizeof (s->typing), "%s", text);
+                s->typePos = 0;
+                s->isCmd = o->code == OP_CMD;
+                type_next (s);
+                break;
+            case OP_PROMPT:
+                (void)snprintf (s->prompt, sizeof (s->prompt), "%s", text);
+                break;
+            case OP_THINK:
+                s->wait = W_THINK;
+                s->waitUntil = now () + (double)o->ms / 1000.0;
+                break;
+            case OP_LOOP:
+                s->loopPc = s->pc;
+                break;
+        }
+    }
+}
+
+static void
+on_readable (struct session * s)
+{
+    unsigned char buf[4096];
+    for (;;)
+    {
+        ssize_t n = recv (s->fd, buf, sizeof (buf), 0);
+        if (n > 0)
+        {
+            s->bytesIn += (uint64_t)n;
+            add_output (s, buf, (size_t)n);
+            if (s->fd < 0)
+                return;
+            continue;
+        }
+        if (n == 0)
+        {
+            fail (s, "connection closed by simulator");
+            return;
+        }
+        if (errno == EINTR)
+            continue;
+        if (errno != EAGAIN && errno != EWOULDBLOCK)
+            fail (s, "recv failed");
+        return;
+    }
+}
+
+// Re-evaluate a waiting session after input or time passing
+
+static void
+poke (struct session * s, double t)
+{
+    switch (s->wait)
+    {
+        case W_EXPECT:
+            {
+                char text[MAX_TEXT];
+                expand (text, sizeof (text), ops[s->pc].text, s->num, 0);
+                if (match (s, text))
+                {
+                    s->pc++;
+                    s->wait = W_NONE;
+                }
+                else if (t > s->deadline)
+                {
+                    char why[MAX_TEXT + 32];
+                    (void)snprintf (why, sizeof (why), "timeout waiting for '%s'", ops[s->pc].text);
+                    fail (s, why);
+                }
+            }
+            break;
+        case W_ECHO:
+            if (t > s->deadline)
+            {
+                s->echoMissed++;
+                type_next (s);
+            }
+            break;
+        case W_ECHOED:
+            type_next (s);
+            break;
+        case W_PROMPT:
+            if (match (s, s->prompt))
+            {
+                add_sample (&s->resp, t - s->sentAt);
+                s->wait = W_NONE;
+            }
+            else if (t > s->deadline)
+            {
+                fail (s, "timeout waiting for the prompt");
+            }
+            break;
+        case W_THINK:
+            if (t >= s->waitUntil)
+                s->wait = W_NONE;
+            break;
+        default:
+            break;
+    }
+    if (s->wait == W_NONE)
+        step (s);
+}
+
+static void
+start_session (struct session * s, const struct addrinfo * ai)
+{
+    s->start = now ();
+    s->fd = socket (ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+    if (s->fd < 0)
+    {
+        fail (s, "socket failed");
+        return;
+    }
+    int one = 1;
+    (void)setsockopt (s->fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof (one));
+    (void)fcntl (s->fd, F_SETFL, fcntl (s->fd, F_GETFL) | O_NONBLOCK);
+    if (connect (s->fd, ai->ai_addr, ai->ai_addrlen) < 0 && errno != EINPROGRESS)
+    {
+        fail (s, "connect failed");
+        return;
+    }
+    s->wait = W_CONNECT;
+    s->deadline = s->start + timeoutSecs;
+}
+
+// CPU seconds (user + system) used by a process so far; < 0 if unknown
+
+static double
+proc_cpu (long pid)
+{
+# if defined(__linux__)
+    char path[64];
+    (void)snprintf (path, sizeof (path), "/proc/%ld/stat", pid);
+    FILE * f = fopen (path, "r");
+    if (!f)
+        return -1.0;
+    char buf[1024];
+    size_t n = fread (buf, 1, sizeof (buf) - 1, f);
+    (void)fclose (f);
+    buf[n] = 0;
+    // Fields after the parenthesized command name; utime and stime are
+    // the 12th and 13th of those.
+    char * p = strrchr (buf, ')');
+    unsigned long ut = 0, st = 0;
+    if (!p || sscanf (p + 2, "%*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %lu %lu",
+                      &ut, &st) != 2)
+        return -1.0;
+    return (double)(ut + st) / (double)sysconf (_SC_CLK_TCK);
+# else
+    (void)pid;
+    return -1.0;
+# endif /* if defined(__linux__) */
+}
+
+static double
+self_cpu (void)
+{
+    struct rusage ru;
+    if (getrusage (RUSAGE_SELF, &ru))
+        return 0.0;
+    return (double)ru.ru_utime.tv_sec + (double)ru.ru_utime.tv_usec / 1e6 +
+           (double)ru.ru_stime.tv_sec + (double)ru.ru_stime.tv_usec / 1e6;
+}
+
+static void
+merge (struct samples * dst, const struct samples * src)
+{
+    for (size_t i = 0; i < src->n; i++)
+        add_sample (dst, src->v[i]);
+}
+
+static void
+report (double elapsed, double simCpu, double toolCpu)
+{
+    struct samples allEcho = { NULL, 0, 0 }, allResp = { NULL, 0, 0 };
+    uint64_t inTotal = 0, outTotal = 0, missed = 0;
+    int ok = 0;
+
+    (void)printf ("\n%5s %7s %8s %8s %8s %8s %6s %8s %8s %10s  %s\n",
+                  "sess", "echoes", "p50 ms", "p90 ms", "p99 ms", "max ms",
+                  "cmds", "p50 ms", "p99 ms", "out B/s", "status");
+    for (int i = 0; i < nSessions; i++)
+    {
+        struct session * s = &sessions[i];
+        double end = s->end > 0.0 ? s->end : s->start + elapsed;
+        double life = end - s->start;
+        qsort (s->echo.v, s->echo.n, sizeof (double), cmp_double);
+        qsort (s->resp.v, s->resp.n, sizeof (double), cmp_double);
+        (void)printf ("%5d %7zu %8.2f %8.2f %8.2f %8.2f %6zu %8.1f %8.1f %10.0f  %s\n",
+                      s->num, s->echo.n, pctl (&s->echo, 50) * 1e3,
+                      pctl (&s->echo, 90) * 1e3, pctl (&s->echo, 99) * 1e3,
+                      pctl (&s->echo, 100) * 1e3, s->resp.n,
+                      pctl (&s->resp, 50) * 1e3, pctl (&s->resp, 99) * 1e3,
+                      life > 0.0 ? (double)s->bytesIn / life : 0.0,
+                      s->failed ? s->why : "ok");
+        merge (&allEcho, &s->echo);
+        merge (&allResp, &s->resp);
+        inTotal += s->bytesIn;
+        outTotal += s->bytesOut;
+        missed += s->echoMissed;
+        ok += !s->failed;
+    }
+    qsort (allEcho.v, allEcho.n, sizeof (double), cmp_double);
+    qsort (allResp.v, allResp.n, sizeof (double), cmp_double);
+
+    (void)printf ("\nSessions:        %d started, %d ok, %d failed\n",
+                  nSessions, ok, nSessions - ok);
+    (void)printf ("Elapsed:         %.1f s\n", elapsed);
+    (void)printf ("Echo latency:    %zu samples, p50 %.2f p90 %.2f p99 %.2f max %.2f ms,"
+                  " %llu missed\n", allEcho.n, pctl (&allEcho, 50) * 1e3,
+                  pctl (&allEcho, 90) * 1e3, pctl (&allEcho, 99) * 1e3,
+                  pctl (&allEcho, 100) * 1e3, (unsigned long long)missed);
+    (void)printf ("Command time:    %zu samples, p50 %.1f p90 %.1f p99 %.1f max %.1f ms\n",
+                  allResp.n, pctl (&allResp, 50) * 1e3, pctl (&allResp, 90) * 1e3,
+                  pctl (&allResp, 99) * 1e3, pctl (&allResp, 100) * 1e3);
+    (void)printf ("Output:          %llu bytes, %.0f bytes/s total\n",
+                  (unsigned long long)inTotal, elapsed > 0.0 ? (double)inTotal / elapsed : 0.0);
+    (void)printf ("Input:           %llu bytes\n", (unsigned long long)outTotal);
+    if (simCpu >= 0.0)
+        (void)printf ("Simulator CPU:   %.1f s (%.0f%% of one host CPU)\n",
+                      simCpu, elapsed > 0.0 ? simCpu / elapsed * 100.0 : 0.0);
+    else
+        (void)printf ("Simulator CPU:   n/a (use -P pid on Linux)\n");
+    (void)printf ("termload CPU:    %.1f s\n", toolCpu);
+    free (allEcho.v);
+    free (allResp.v);
+}
+
+static void
+usage (void)
+{
+    (void)fprintf (stderr,
+        "Usage: termload [options]\n"
+        "\n"
+        "  -n N      number of sessions (default 1, max %d)\n"
+        "  -H HOST   FNP listener address (default 127.0.0.1)\n"
+        "  -p PORT   FNP listener port (default 6180)\n"
+        "  -d SECS   run time (default 60)\n"
+        "  -r MS     delay between session starts (default 50)\n"
+        "  -f FILE   script file (default: built-in login and command mix)\n"
+        "  -u USER   user name for %%u; may contain %%n (default Guest)\n"
+        "  -w PASS   password for %%w; may contain %%n\n"
+        "  -t SECS   expect/prompt timeout (default 60)\n"
+        "  -e SECS   per-character echo timeout (default 2)\n"
+        "  -P PID    simulator process, for CPU usage (Linux)\n"
+        "  -s        print the built-in script and exit\n"
+        "  -v        report session failures as they occur\n"
+        "  -h        this help\n", MAX_SESSIONS);
+}
+
+int
+main (int argc, char * argv[])
+{
+    const char * scriptFile = NULL;
+    int c;
+    while ((c = getopt (argc, argv, "n:H:p:d:r:f:u:w:t:e:P:svh")) != -1)
+    {
+        switch (c)
+        {
+            case 'n': nSessions = atoi (optarg); break;
+            case 'H': host = optarg; break;
+            case 'p': port = optarg; break;
+            case 'd': runSecs = atof (optarg); break;
+            case 'r': rampMs = atof (optarg); break;
+            case 'f': scriptFile = optarg; break;
+            case 'u': userFmt = optarg; break;
+            case 'w': passFmt = optarg; break;
+            case 't': timeoutSecs = atof (optarg); break;
+            case 'e': echoTimeoutSecs = atof (optarg); break;
+            case 'P': simPid = atol (optarg); break;
+            case 's': (void)fputs (defaultScript, stdout); return EXIT_SUCCESS;
+            case 'v': verbose = true; break;
+            case 'h': usage (); return EXIT_SUCCESS;
+            default: usage (); return EXIT_FAILURE;
+        }
+    }
+    if (nSessions < 1 || nSessions > MAX_SESSIONS || runSecs <= 0.0)
+    {
+        usage ();
+        return EXIT_FAILURE;
+    }
+    if (scriptFile ? load_script (scriptFile) : parse_script (defaultScript, "built-in"))
+        return EXIT_FAILURE;
+
+    struct addrinfo hints, * ai;
+    (void)memset (&hints, 0, sizeof (hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    int rc = getaddrinfo (host, port, &hints, &ai);
+    if (rc)
+    {
+        (void)fprintf (stderr, "termload: %s:%s: %s\n", host, port, gai_strerror (rc));
+        return EXIT_FAILURE;
+    }
+
+    sessions = calloc ((size_t)nSessions, sizeof (struct session));
+    struct pollfd * pfds = calloc ((size_t)nSessions, sizeof (struct pollfd));
+    if (!sessions || !pfds)
+    {
+        (void)fprintf (stderr, "termload: out of memory\n");
+        return EXIT_FAILURE;
+    }
+    for (int i = 0; i < nSessions; i++)
+    {
+        sessions[i].num = i;
+        sessions[i].fd = -1;
+        sessions[i].loopPc = -1;
+        sessions[i].wait = W_THINK;
+        sessions[i].waitUntil = 0.0;
+        (void)snprintf (sessions[i].prompt, sizeof (sessions[i].prompt), "\nr ");
+    }
+
+    (void)signal (SIGINT, on_signal);
+    (void)signal (SIGTERM, on_signal);
+    (void)signal (SIGPIPE, SIG_IGN);
+
+    double simCpu0 = simPid ? proc_cpu (simPid) : -1.0;
+    double t0 = now ();
+    double tEnd = t0 + runSecs;
+    int started = 0;
+
+    (void)printf ("termload: %d session%s to %s:%s for %.0f s\n",
+                  nSessions, nSessions == 1 ? "" : "s", host, port, runSecs);
+    while (!interrupted)
+    {
+        double t = now ();
+        if (t >= tEnd)
+            break;
+
+        // Ramp up
+        while (started < nSessions && t >= t0 + (double)started * rampMs / 1000.0)
+            start_session (&sessions[started++], ai);
+
+        int nfds = 0;
+        double next = tEnd;
+        if (started < nSessions)
+        {
+            double s = t0 + (double)started * rampMs / 1000.0;
+            if (s < next)
+                next = s;
+        }
+        for (int i = 0; i < started; i++)
+        {
+            struct session * s = &sessions[i];
+            if (s->wait == W_DONE)
+                continue;
+            if (s->wait == W_THINK && s->waitUntil < next)
+                next = s->waitUntil;
+            if ((s->wait == W_EXPECT || s->wait == W_ECHO || s->wait == W_PROMPT ||
+                 s->wait == W_CONNECT) && s->deadline < next)
+                next = s->deadline;
+            pfds[nfds].fd = s->fd;
+            pfds[nfds].events = s->wait == W_CONNECT ? POLLOUT : POLLIN;
+            pfds[nfds].revents = 0;
+            nfds++;
+        }
+        int ms = (int)((next - t) * 1000.0) + 1;
+        if (ms < 0)
+            ms = 0;
+        if (poll (pfds, (nfds_t)nfds, ms) < 0 && errno != EINTR)
+        {
+            (void)fprintf (stderr, "termload: poll: %s\n", strerror (errno));
+            break;
+        }
+
+        t = now ();
+        int k = 0;
+        for (int i = 0; i < started; i++)
+        {
+            struct session * s = &sessions[i];
+            if (s->wait == W_DONE)
+                continue;
+            short rev = pfds[k++].revents;
+            if (s->wait == W_CONNECT)
+            {
+                if (rev)
+                {
+                    int err = 0;
+                    socklen_t len = sizeof (err);
+                    (void)getsockopt (s->fd, SOL_SOCKET, SO_ERROR, &err, &len);
+                    if (err)
+                        fail (s, "connect failed");
+                    else
+                        s->wait = W_NONE;
+                }
+                else if (t > s->deadline)
+                {
+                    fail (s, "connect timed out");
+                }
+            }
+            else if (rev & (POLLIN | POLLHUP | POLLERR))
+            {
+                on_readable (s);
+            }
+            if (s->wait != W_DONE && s->wait != W_CONNECT)
+                poke (s, t);
+        }
+    }
+    double elapsed = now () - t0;
+    double simCpu = simCpu0 >= 0.0 ? proc_cpu (simPid) - simCpu0 : -1.0;
+
+    for (int i = 0; i < nSessions; i++)
+        if (sessions[i].fd >= 0)
+        {
+            (void)close (sessions[i].fd);
+            sessions[i].end = now ();
+        }
+    freeaddrinfo (ai);
+    report (elapsed, simCpu, self_cpu ());
+    int failed = 0;
+    for (int i = 0; i < nSessions; i++)
+        failed += sessions[i].failed;
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+#endif /* if defined(_WIN32) */